@@ -0,0 +1,141 @@
+/*
+ * CacheWarming.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+
+// STD
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Background thread which fills the footprint caches in a corridor, e.g. around the planned path, such that
+ * the queries along it find their cells cached. The cells are warmed in small batches, closest first, and the
+ * thread yields to the queries and stops at a new corridor.
+ */
+class CacheWarming {
+ public:
+  /*!
+   * Gets the geometry of the map to warm.
+   * @param[out] geometry the geometry of the map, without layers.
+   * @param[out] generation the generation of the map.
+   * @return false if there is no map.
+   */
+  typedef std::function<bool(grid_map::GridMap& geometry, uint64_t& generation)> PrepareFunction;
+
+  /*!
+   * Fills the footprint caches of a batch of cells.
+   * @param cells the cells.
+   * @param generation the generation of the map the cells belong to.
+   * @return false if the map was replaced meanwhile, which ends the corridor.
+   */
+  typedef std::function<bool(const std::vector<grid_map::Index>& cells, uint64_t generation)> WarmFunction;
+
+  //! Counts a query for the duration of its check, such that the cache warming yields to it.
+  class ActiveQuery {
+   public:
+    explicit ActiveQuery(CacheWarming& cacheWarming) : nActiveQueries_(cacheWarming.nActiveQueries_) { ++nActiveQueries_; }
+    ~ActiveQuery() { --nActiveQueries_; }
+
+   private:
+    std::atomic<int>& nActiveQueries_;
+  };
+
+  CacheWarming();
+
+  /*!
+   * Stops the thread.
+   */
+  ~CacheWarming();
+
+  /*!
+   * Sets the parameters, before the thread is started.
+   * @param isEnabled if the thread is started.
+   * @param corridorRadius half width of the corridor [m].
+   * @param nice nice value of the thread.
+   */
+  void setParameters(bool isEnabled, double corridorRadius, int nice);
+
+  /*!
+   * Starts the thread if the cache warming is enabled.
+   * @param prepare function which gets the map to warm.
+   * @param warm function which warms a batch of cells.
+   */
+  void start(PrepareFunction prepare, WarmFunction warm);
+
+  /*!
+   * Stops the thread, the current batch is finished.
+   */
+  void stop();
+
+  /*!
+   * Requests the footprint caches to be filled in a corridor, which replaces the previous one. Does nothing if
+   * the cache warming is disabled.
+   * @param corridor positions along the corridor in the map frame, starting at the robot.
+   */
+  void request(const std::vector<grid_map::Position>& corridor);
+
+  /*!
+   * Gets the cells within a corridor, ordered along it.
+   * @param geometry the geometry of the map.
+   * @param corridor positions along the corridor in the map frame.
+   * @param radius half width of the corridor [m].
+   * @return the cells, each once.
+   */
+  static std::vector<grid_map::Index> getCorridorCells(const grid_map::GridMap& geometry, const std::vector<grid_map::Position>& corridor,
+                                                       double radius);
+
+ private:
+  /*!
+   * Loop of the thread, warms the requested corridors until stopped.
+   */
+  void run();
+
+  /*!
+   * Fills the footprint caches of the cells within the corridor, in batches.
+   * @param corridor positions along the corridor in the map frame.
+   */
+  void warmCorridor(const std::vector<grid_map::Position>& corridor);
+
+  /*!
+   * Checks if the cache warming has to stop, i.e. if it is stopped or a new corridor is requested.
+   * @return true if the cache warming has to stop.
+   */
+  bool isInterrupted();
+
+  //! If the thread is started, the half width of its corridor [m] and its nice value.
+  bool isEnabled_;
+  double corridorRadius_;
+  int nice_;
+
+  //! Callbacks to the map.
+  PrepareFunction prepare_;
+  WarmFunction warm_;
+
+  //! Number of queries being checked, the cache warming pauses while there are any.
+  std::atomic<int> nActiveQueries_;
+
+  //! Requested corridor, guarded by the mutex.
+  std::vector<grid_map::Position> corridor_;
+  bool hasRequest_;
+  bool isStopped_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::thread thread_;
+};
+
+}  // namespace traversability_estimation
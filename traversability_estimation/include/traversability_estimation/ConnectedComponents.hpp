@@ -0,0 +1,101 @@
+/*
+ * ConnectedComponents.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/DistanceTransform.hpp"
+
+// Eigen
+#include <Eigen/Core>
+
+// STD
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Labels the connected components of the free cells of a mask in 8-connectivity, such that two cells are
+ * connected if and only if they have the same label. The labels are computed with union-find on strips of
+ * columns in parallel, whose components are then merged across the strip borders. After changes within a
+ * region, only the components which touch the region are labeled again.
+ */
+class ConnectedComponents {
+ public:
+  //! Label of the cells which are not free.
+  static constexpr int noLabel = -1;
+
+  /*!
+   * Constructor.
+   */
+  ConnectedComponents();
+
+  /*!
+   * Labels all cells.
+   * @param[in] isFree mask of the free cells.
+   */
+  void compute(const BinaryMatrix& isFree);
+
+  /*!
+   * Labels the cells again after the mask changed within a region. Components which do not touch the
+   * region keep their labels, the others get new ones.
+   * @param[in] isFree mask of the free cells, of the same size as in the last computation.
+   * @param[in] start first cell of the changed region.
+   * @param[in] size size of the changed region in cells.
+   */
+  void update(const BinaryMatrix& isFree, const Eigen::Array2i& start, const Eigen::Array2i& size);
+
+  /*!
+   * Gets the label of a cell.
+   * @param[in] index index of the cell.
+   * @return the label, noLabel if the cell is not free or not inside the mask.
+   */
+  int getLabel(const Eigen::Array2i& index) const {
+    if ((index < 0).any() || index(0) >= labels_.rows() || index(1) >= labels_.cols()) return noLabel;
+    return labels_(index(0), index(1));
+  }
+
+  /*!
+   * Gets the labels of all cells.
+   * @return the labels, noLabel for the cells which are not free.
+   */
+  const Eigen::MatrixXi& getLabels() const { return labels_; }
+
+ private:
+  /*!
+   * Labels the cells of a mask, the other cells keep their labels.
+   * @param[in] mask mask of the labeled cells.
+   * @param[in] firstLabel label of the first new component.
+   * @return the number of new components.
+   */
+  int label(const BinaryMatrix& mask, int firstLabel);
+
+  /*!
+   * Finds the root of a cell in the union-find forest and compresses the path.
+   * @param[in] cell linear index of the cell.
+   * @return linear index of the root.
+   */
+  int find(int cell);
+
+  /*!
+   * Joins the trees of two cells, the smaller linear index becomes the root.
+   * @param[in] cellA linear index of the first cell.
+   * @param[in] cellB linear index of the second cell.
+   */
+  void unite(int cellA, int cellB);
+
+  //! Labels of the cells.
+  Eigen::MatrixXi labels_;
+
+  //! Label of the next new component.
+  int nextLabel_;
+
+  //! Union-find forest over the linear cell indices.
+  std::vector<int> parent_;
+};
+
+}  // namespace traversability_estimation
@@ -0,0 +1,42 @@
+/*
+ * ContourExtraction.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/DistanceTransform.hpp"
+
+// Eigen
+#include <Eigen/Core>
+
+// STD
+#include <vector>
+
+namespace traversability_estimation {
+
+//! Closed contour as a sequence of vertices, the last vertex connects to the first one.
+using Contour = std::vector<Eigen::Vector2d>;
+
+/*!
+ * Traces the boundaries of the set cells of a binary mask with marching squares. Cell centers are the
+ * samples, the contour vertices lie halfway between set and unset neighbor cells. Set cells touching at
+ * a corner belong to the same region. The set cells are on the right of the contours, i.e. in a
+ * right-handed frame outer boundaries are clockwise and boundaries of holes are counter-clockwise.
+ * @param[in] mask the binary mask.
+ * @param[out] contours the closed contours in (row, column) index coordinates.
+ */
+void extractContours(const BinaryMatrix& mask, std::vector<Contour>& contours);
+
+/*!
+ * Simplifies a closed contour with the Douglas-Peucker algorithm.
+ * @param[in] contour the closed contour.
+ * @param[in] tolerance maximum distance of the removed vertices to the simplified contour.
+ * @return the simplified contour.
+ */
+Contour simplifyContour(const Contour& contour, const double tolerance);
+
+}  // namespace traversability_estimation
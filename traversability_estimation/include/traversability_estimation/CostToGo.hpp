@@ -0,0 +1,35 @@
+/*
+ * CostToGo.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/DistanceTransform.hpp"
+
+// Eigen
+#include <Eigen/Core>
+
+namespace traversability_estimation {
+
+/*!
+ * Computes the cost-to-go of every cell from a start cell with a bucketed Dijkstra (Dial's algorithm)
+ * over the 8-connected free cells. Moving between two cells costs their distance, scaled up by
+ * (1 + traversabilityWeight * (1 - traversability)) with the mean traversability of the two cells. The
+ * bucket width is the smallest possible edge cost, such that all cells of a bucket are final when it is
+ * processed and the result is exact.
+ * @param[in] isFree mask of the cells that can be entered.
+ * @param[in] traversability traversability of each cell, between 0.0 and 1.0 (must be finite).
+ * @param[in] start index of the start cell.
+ * @param[in] resolution cell size in [m].
+ * @param[in] traversabilityWeight cost increase of a fully untraversable cell with respect to a fully traversable one,
+ *            non-negative. The number of buckets grows linearly with it.
+ * @param[out] cost cost-to-go of each cell, NAN if the cell is not reachable.
+ */
+void computeCostToGo(const BinaryMatrix& isFree, const Eigen::MatrixXf& traversability, const Eigen::Array2i& start,
+                     const double resolution, const double traversabilityWeight, Eigen::MatrixXf& cost);
+
+}  // namespace traversability_estimation
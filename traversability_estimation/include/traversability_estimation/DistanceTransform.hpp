@@ -0,0 +1,30 @@
+/*
+ * DistanceTransform.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Eigen
+#include <Eigen/Core>
+
+namespace traversability_estimation {
+
+//! Binary mask over the cells of a grid map layer.
+using BinaryMatrix = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>;
+
+/*!
+ * Computes the exact Euclidean distance transform of a binary mask, i.e. the distance of every cell to
+ * the closest seed cell. Runs in linear time with two separable passes of the lower envelope of parabolas
+ * (Felzenszwalb and Huttenlocher, 2012).
+ * @param[in] isSeed mask of the cells to which the distance is computed.
+ * @param[in] maxDistance distance assigned to all cells if there is no seed cell, and upper bound of the
+ *            distances in general.
+ * @param[out] distance distance of each cell to the closest seed cell in number of cells.
+ */
+void computeDistanceTransform(const BinaryMatrix& isSeed, const float maxDistance, Eigen::MatrixXf& distance);
+
+}  // namespace traversability_estimation
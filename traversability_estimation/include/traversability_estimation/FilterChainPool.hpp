@@ -0,0 +1,98 @@
+/*
+ * FilterChainPool.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// ROS
+#include <filters/filter_chain.h>
+
+// STD
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Pool of traversability filter chains to compute the traversability of arbitrary elevation maps
+ * independently of the live traversability map. At most a fixed number of maps is computed at the same
+ * time, further requests block until a worker is free. Chains are configured on first use and reused, except
+ * for requests that override filter parameters, which configure a chain of their own. Thread safe.
+ */
+class FilterChainPool {
+ public:
+  //! Filter parameter overrides as pairs of 'filter_name/parameter' and value.
+  using Overrides = std::vector<std::pair<std::string, double>>;
+
+  /*!
+   * Constructor.
+   */
+  FilterChainPool();
+
+  /*!
+   * Sets the filter chain configuration, idle chains of a previous configuration are dropped.
+   * @param config the filter chain configuration, a list of filters with name, type and params.
+   * @param nWorkers the maximal number of maps computed at the same time.
+   */
+  void configure(const XmlRpc::XmlRpcValue& config, size_t nWorkers);
+
+  /*!
+   * Computes the traversability of an elevation map on a free worker.
+   * @param[in] elevationMap the elevation map.
+   * @param[out] traversabilityMap the filtered map.
+   * @param[in] overrides filter parameters which differ from the configuration.
+   * @param[out] error the reason if the computation failed.
+   * @return true if successful.
+   */
+  bool update(const grid_map::GridMap& elevationMap, grid_map::GridMap& traversabilityMap, const Overrides& overrides,
+              std::string& error);
+
+  /*!
+   * Sets the parameter overrides in a filter chain configuration. Integer and boolean parameters keep their type.
+   * @param[in/out] config the filter chain configuration.
+   * @param[in] overrides filter parameters to set.
+   * @param[out] error the reason if an override could not be applied.
+   * @return true if successful, false if a filter does not exist.
+   */
+  static bool applyOverrides(XmlRpc::XmlRpcValue& config, const Overrides& overrides, std::string& error);
+
+ private:
+  using Chain = filters::FilterChain<grid_map::GridMap>;
+
+  /*!
+   * Configures a new filter chain.
+   * @param config the filter chain configuration.
+   * @return the chain, null if it could not be configured.
+   */
+  static std::unique_ptr<Chain> createChain(XmlRpc::XmlRpcValue& config);
+
+  //! Filter chain configuration.
+  XmlRpc::XmlRpcValue config_;
+
+  //! Number of configurations set, chains of previous configurations are not reused.
+  uint64_t generation_;
+
+  //! Configured chains which are not in use.
+  std::vector<std::unique_ptr<Chain>> idleChains_;
+
+  //! Maximal and current number of maps computed at the same time.
+  size_t nWorkers_;
+  size_t nBusyWorkers_;
+
+  //! Mutex of the members and condition signaled when a worker is released.
+  std::mutex mutex_;
+  std::condition_variable workerReleased_;
+};
+
+}  // namespace traversability_estimation
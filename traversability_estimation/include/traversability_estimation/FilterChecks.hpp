@@ -0,0 +1,151 @@
+/*
+ * FilterChecks.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/MapOverlay.hpp"
+#include "traversability_estimation/SparseCellCache.hpp"
+#include "traversability_estimation/TiledLayer.hpp"
+
+// Traversability estimation filters
+#include <filters/CircleKernel.hpp>
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+
+// STD
+#include <map>
+#include <string>
+
+namespace traversability_estimation {
+
+/*!
+ * Checks of single cells against the step, slope and roughness filters. Cells marked by a filter are checked
+ * again in their neighborhood, such that small ditches, slopes and rough patches are still traversable. The
+ * results are cached in the footprint caches, which are either layers of the map or sparse caches.
+ *
+ * The checks only write the cached results of the checked cell, such that different cells may be checked
+ * concurrently as long as the sparse caches are read only.
+ */
+class FilterChecks {
+ public:
+  //! Parameters of the checks.
+  struct Parameters {
+    //! Filter layers.
+    std::string stepType;
+    std::string slopeType;
+    std::string roughnessType;
+    //! Height [m] of a step and width [m] of a gap which the robot can not traverse.
+    double criticalStepHeight = 0.0;
+    double maxGapWidth = 0.0;
+    //! Check the roughness as well.
+    bool checkForRoughness = false;
+    //! Window of the slope and roughness checks, with a radius of three cells.
+    filters::CircleKernel<3> windowKernel{3.0};
+  };
+
+  /*!
+   * Constructor.
+   * @param parameters the parameters, must outlive the checks.
+   * @param map the map with the filter layers, the elevation and the dense footprint caches, must outlive the checks.
+   * @param overlay the overlay, cells of overrides and obstacles are not checked. Must outlive the checks.
+   */
+  FilterChecks(const Parameters& parameters, grid_map::GridMap& map, const MapOverlay& overlay);
+
+  /*!
+   * Reads the step and elevation layers from tiled copies, which must outlive the checks.
+   * @param step the tiled step layer.
+   * @param elevation the tiled elevation layer.
+   */
+  void setTiledLayers(const TiledLayer& step, const TiledLayer& elevation);
+
+  /*!
+   * Caches the results in sparse caches instead of the map layers.
+   * @param sparseFootprintCaches the caches by name of the footprint layer, must outlive the checks.
+   * @param isReadOnly if set, results are not cached, such that concurrent checks do not modify the hash tables.
+   */
+  void setSparseFootprintCaches(std::map<std::string, SparseCellCache>& sparseFootprintCaches, const bool isReadOnly);
+
+  /*!
+   * Checks if a cell is traversable according to the filters and the overlay.
+   * @param index index of the cell.
+   * @return true if traversable.
+   */
+  bool check(const grid_map::Index& index);
+
+  /*!
+   * Gets the cached value of a cell from a footprint cache.
+   * @param layer the name of the footprint layer.
+   * @param index index of the cell.
+   * @return the cached value, NAN if the cell is not cached.
+   */
+  float getFootprintCache(const std::string& layer, const grid_map::Index& index) const;
+
+  /*!
+   * Caches the value of a cell in a footprint cache, unless the sparse caches are read only.
+   * @param layer the name of the footprint layer.
+   * @param index index of the cell.
+   * @param value the value to cache.
+   */
+  void setFootprintCache(const std::string& layer, const grid_map::Index& index, const float value);
+
+ private:
+  /*!
+   * Checks a cell regarding steps. Small ditches and holes are not detected as steps.
+   * @param index index of the cell.
+   * @return true if no step is detected.
+   */
+  bool checkForStep(const grid_map::Index& index);
+
+  /*!
+   * Checks a cell regarding the slope. Small local slopes are not detected as slopes.
+   * @param index index of the cell.
+   * @return true if traversable regarding the slope.
+   */
+  bool checkForSlope(const grid_map::Index& index);
+
+  /*!
+   * Checks a cell regarding the roughness. Small local roughness is still detected as traversable terrain.
+   * @param index index of the cell.
+   * @return true if traversable regarding the roughness.
+   */
+  bool checkForRoughness(const grid_map::Index& index);
+
+  /*!
+   * Counts the untraversable cells of a filter layer in the window of the slope and roughness checks.
+   * @param layer the name of the layer.
+   * @param index index of the center cell.
+   * @return the number of cells with zero traversability.
+   */
+  int countUntraversableCells(const std::string& layer, const grid_map::Index& index);
+
+  /*!
+   * Gets the value of the step or elevation layer, from the tiled copy if set.
+   * @param tiledLayer the tiled copy of the layer, nullptr if not set.
+   * @param layer the name of the layer.
+   * @param index index of the cell.
+   * @return the value of the cell.
+   */
+  float getLayerValue(const TiledLayer* tiledLayer, const std::string& layer, const grid_map::Index& index) const {
+    return tiledLayer != nullptr ? tiledLayer->at(index) : map_.at(layer, index);
+  }
+
+  const Parameters& parameters_;
+  grid_map::GridMap& map_;
+  const MapOverlay& overlay_;
+
+  //! Tiled copies of the step and elevation layers, nullptr if not used.
+  const TiledLayer* tiledStep_;
+  const TiledLayer* tiledElevation_;
+
+  //! Sparse footprint caches, nullptr if the caches are layers of the map.
+  std::map<std::string, SparseCellCache>* sparseFootprintCaches_;
+  bool areFootprintCachesReadOnly_;
+};
+
+}  // namespace traversability_estimation
@@ -0,0 +1,156 @@
+/*
+ * FootprintCaches.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/SparseCellCache.hpp"
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+
+// STD
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Storage of the footprint caches, which hold the results of the footprint checks per cell. The caches are
+ * either dense map layers or sparse hash tables, whose memory scales with the number of queried cells.
+ */
+class FootprintCaches {
+ public:
+  //! Selection of the storage.
+  enum class Backend { Auto, Dense, Sparse };
+
+  //! Footprint layers of the filter layers without risk variant.
+  static const std::array<std::string, 4> layers;
+
+  FootprintCaches();
+
+  /*!
+   * Sets the selection of the storage.
+   * @param backend the backend, auto selects the storage of each new map from the queries of the previous one.
+   * @param sparseDensity fraction of the queried cells below which the auto backend stores the caches sparsely.
+   */
+  void setBackend(Backend backend, double sparseDensity);
+
+  /*!
+   * Checks if the caches are stored sparsely.
+   * @return true if the caches are sparse, false if they are map layers.
+   */
+  bool isSparse() const { return isSparse_; }
+
+  /*!
+   * Gets the sparse caches.
+   * @return the caches by name of the footprint layer they replace.
+   */
+  std::map<std::string, SparseCellCache>& getSparseCaches() { return sparseCaches_; }
+
+  /*!
+   * Selects the storage of the caches of the map which replaces the given one.
+   * @param map the replaced map.
+   * @return true if the caches of the new map are to be stored sparsely.
+   */
+  bool shouldUseSparse(const grid_map::GridMap& map) const;
+
+  /*!
+   * Checks if the auto backend should move the sparse caches into map layers, as most cells are queried.
+   * @param map the map.
+   * @return true if the caches should be dense.
+   */
+  bool shouldUseDense(const grid_map::GridMap& map) const;
+
+  /*!
+   * Drops the caches for a new map.
+   * @param map the new map.
+   * @param isSparse if the caches are stored sparsely.
+   * @param denseLayers the footprint layers to add if the caches are dense.
+   */
+  void reset(grid_map::GridMap& map, bool isSparse, const std::vector<std::string>& denseLayers);
+
+  /*!
+   * Adds a footprint layer (filled with NAN) if the caches are dense and it is missing. Sparse caches are created
+   * on the first write.
+   * @param map the map.
+   * @param layer the name of the footprint layer.
+   */
+  void ensure(grid_map::GridMap& map, const std::string& layer) const;
+
+  /*!
+   * Gets the fraction of the map cells with a cached footprint, i.e. the density of the queries.
+   * @param map the map.
+   * @return the fraction of the cells cached in the fullest footprint cache.
+   */
+  double getDensity(const grid_map::GridMap& map) const;
+
+  /*!
+   * Moves the sparse caches into map layers.
+   * @param map the map.
+   */
+  void useDense(grid_map::GridMap& map);
+
+  /*!
+   * Swaps the sparse caches, e.g. with the ones of a snapshot.
+   * @param[in/out] sparseCaches the sparse caches to swap in.
+   * @param[in] isSparse if the caches are stored sparsely after the swap.
+   */
+  void swapSparseCaches(std::map<std::string, SparseCellCache>& sparseCaches, bool isSparse);
+
+  /*!
+   * Swaps two sparse caches, e.g. with the ones of a risk variant.
+   * @param layer the name of the first footprint layer.
+   * @param otherLayer the name of the second footprint layer.
+   */
+  void swapSparseCaches(const std::string& layer, const std::string& otherLayer);
+
+  /*!
+   * Drops the cached cells of a footprint layer.
+   * @param map the map.
+   * @param layer the name of the footprint layer.
+   */
+  void clear(grid_map::GridMap& map, const std::string& layer);
+
+  /*!
+   * Drops the cached cells of a block of a footprint layer.
+   * @param map the map.
+   * @param layer the name of the footprint layer.
+   * @param startIndex the first cell of the block.
+   * @param size the size of the block.
+   */
+  void clearBlock(grid_map::GridMap& map, const std::string& layer, const grid_map::Index& startIndex, const grid_map::Size& size);
+
+  /*!
+   * Drops the sparse cache of a layer, if any, e.g. when it is evicted.
+   * @param layer the name of the footprint layer.
+   */
+  void eraseSparseCache(const std::string& layer);
+
+  /*!
+   * Adds the memory of the sparse caches to the usage of the layers they replace.
+   * @param[in/out] usage the memory of each layer [bytes].
+   */
+  void addMemoryUsage(std::map<std::string, size_t>& usage) const;
+
+ private:
+  //! Selection of the storage.
+  Backend backend_;
+
+  //! Fraction of the queried cells below which the auto backend stores the caches of a new map sparsely.
+  double sparseDensity_;
+
+  //! If the caches are stored in hash tables instead of map layers.
+  bool isSparse_;
+
+  //! Sparse caches, by name of the footprint layer they replace.
+  std::map<std::string, SparseCellCache> sparseCaches_;
+};
+
+}  // namespace traversability_estimation
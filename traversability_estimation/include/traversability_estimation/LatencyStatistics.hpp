@@ -0,0 +1,66 @@
+/*
+ * LatencyStatistics.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// STD
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Collects the latencies of a request type over a window of samples and reports their percentiles
+ * when the window is full, e.g. to compare the tail latency of path checks with and without real-time
+ * scheduling. Thread safe.
+ */
+class LatencyStatistics {
+ public:
+  /*!
+   * Constructor.
+   * @param name the name of the request type in the reports.
+   * @param windowSize the number of samples of a report, no reports if 0.
+   */
+  LatencyStatistics(const std::string& name, size_t windowSize);
+
+  /*!
+   * Sets the number of samples of a report and drops the collected samples.
+   * @param windowSize the number of samples of a report, no reports if 0.
+   */
+  void setWindowSize(size_t windowSize);
+
+  /*!
+   * Adds a sample and reports the percentiles of the window when it is full.
+   * @param latency the latency [s].
+   */
+  void add(double latency);
+
+  /*!
+   * Computes a percentile of the samples by the nearest-rank method.
+   * @param samples the samples, reordered by the call.
+   * @param percentile the percentile in [0, 100].
+   * @return the percentile, 0 if there are no samples.
+   */
+  static double computePercentile(std::vector<double>& samples, double percentile);
+
+ private:
+  //! Name of the request type.
+  const std::string name_;
+
+  //! Number of samples of a report.
+  size_t windowSize_;
+
+  //! Samples of the current window [s].
+  std::vector<double> samples_;
+
+  //! Mutex of the samples.
+  std::mutex mutex_;
+};
+
+}  // namespace traversability_estimation
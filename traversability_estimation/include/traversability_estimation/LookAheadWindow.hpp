@@ -0,0 +1,98 @@
+/*
+ * LookAheadWindow.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// STD
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Places the window of the requested elevation submap from the motion of the robot, such that it covers
+ * the area the robot drives through next instead of being centered on the robot. The window covers the
+ * robot, the position predicted from its velocity over a time horizon and the upcoming part of the
+ * planned path, and is grown or cut to a fixed area, i.e. a fixed number of cells. The previous window is
+ * kept as long as it still covers the robot and the look-ahead the new window would cover, such that
+ * consecutive maps overlap and share their cells.
+ */
+class LookAheadWindow {
+ public:
+  /*!
+   * Constructor.
+   */
+  LookAheadWindow();
+
+  /*!
+   * Sets the parameters of the placement and forgets the previous window.
+   * @param area the area of the window [m^2].
+   * @param timeHorizon the time over which the position of the robot is predicted [s].
+   * @param margin the distance kept around the robot and the look-ahead points [m].
+   * @param minLength the minimal side length of the window [m].
+   */
+  void setParameters(double area, double timeHorizon, double margin, double minLength);
+
+  /*!
+   * Forgets the previous window.
+   */
+  void reset();
+
+  /*!
+   * Computes the window for the current motion of the robot.
+   * @param[in] robotPosition the position of the robot.
+   * @param[in] velocity the planar velocity of the robot [m/s].
+   * @param[in] path the positions of the planned path, may be empty.
+   * @param[in] resolution the resolution the window is aligned to, not aligned if not positive.
+   * @param[out] center the center of the window.
+   * @param[out] length the side lengths of the window.
+   */
+  void update(const grid_map::Position& robotPosition, const Eigen::Vector2d& velocity, const std::vector<grid_map::Position>& path,
+              double resolution, grid_map::Position& center, grid_map::Length& length);
+
+ private:
+  /*!
+   * Collects the points the window has to cover besides the robot.
+   * @param robotPosition the position of the robot.
+   * @param velocity the planar velocity of the robot [m/s].
+   * @param path the positions of the planned path.
+   * @return the look-ahead points.
+   */
+  std::vector<grid_map::Position> getLookAheadPoints(const grid_map::Position& robotPosition, const Eigen::Vector2d& velocity,
+                                                     const std::vector<grid_map::Position>& path) const;
+
+  /*!
+   * Checks if a window covers a point with the margin.
+   * @param center the center of the window.
+   * @param length the side lengths of the window.
+   * @param point the point.
+   * @return true if the point and its margin are inside the window.
+   */
+  bool covers(const grid_map::Position& center, const grid_map::Length& length, const grid_map::Position& point) const;
+
+  //! Area of the window [m^2].
+  double area_;
+
+  //! Time over which the position of the robot is predicted [s].
+  double timeHorizon_;
+
+  //! Distance kept around the robot and the look-ahead points [m].
+  double margin_;
+
+  //! Minimal side length of the window [m].
+  double minLength_;
+
+  //! Previous window.
+  grid_map::Position previousCenter_;
+  grid_map::Length previousLength_;
+  bool hasPreviousWindow_;
+};
+
+}  // namespace traversability_estimation
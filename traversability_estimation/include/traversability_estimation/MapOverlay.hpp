@@ -0,0 +1,189 @@
+/*
+ * MapOverlay.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// ROS
+#include <geometry_msgs/Point32.h>
+#include <ros/time.h>
+
+// Eigen
+#include <Eigen/Geometry>
+
+// STD
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Regions applied on top of the computed traversability, i.e. dynamic obstacles and overrides. The regions are kept as
+ * polygons in the map frame and rasterized into a state per map cell, such that they survive map updates
+ * and a change only touches the cells of the changed regions.
+ */
+class MapOverlay {
+ public:
+  //! State of a cell, regions with a higher state take precedence.
+  enum class State : uint8_t { None = 0, Traversable = 1, Untraversable = 2 };
+
+  //! Region of the overlay.
+  struct Region {
+    //! Polygon of the region in the map frame.
+    grid_map::Polygon polygon;
+    //! State of the cells within the region.
+    State state;
+    //! Time at which the region is removed, never if zero.
+    ros::Time expiry;
+  };
+
+  //! Bounds of the changed regions, one box per region or group of overlapping regions.
+  typedef std::vector<Eigen::AlignedBox2d, Eigen::aligned_allocator<Eigen::AlignedBox2d>> ChangedBounds;
+
+  /*!
+   * Constructor.
+   */
+  MapOverlay();
+
+  /*!
+   * Creates a region from the vertices of a polygon message.
+   * @param[in] points the vertices of the polygon in the map frame.
+   * @param[in] state the state of the cells within the region.
+   * @param[in] expiry time at which the region is removed, never if zero.
+   * @return the region.
+   */
+  static Region createRegion(const std::vector<geometry_msgs::Point32>& points, const State state, const ros::Time& expiry);
+
+  /*!
+   * Sets the geometry of the map the cells belong to, and rasterizes all regions.
+   * @param[in] map the map (must have a default start index).
+   */
+  void setGeometry(const grid_map::GridMap& map);
+
+  /*!
+   * Replaces the dynamic obstacles. Obstacles which did not move are not changed.
+   * @param[in] obstacles the dynamic obstacles.
+   * @param[in] map the map the cells belong to.
+   * @return the bounds of the cells that changed.
+   */
+  ChangedBounds setDynamicObstacles(const std::vector<Region>& obstacles, const grid_map::GridMap& map);
+
+  /*!
+   * Adds an override, or replaces the override with the same identifier.
+   * @param[in] id the identifier of the override.
+   * @param[in] region the region of the override.
+   * @param[in] map the map the cells belong to.
+   * @return the bounds of the cells that changed, empty if the region of the override did not change.
+   */
+  ChangedBounds setOverride(const std::string& id, const Region& region, const grid_map::GridMap& map);
+
+  /*!
+   * Removes an override.
+   * @param[in] id the identifier of the override.
+   * @param[in] map the map the cells belong to.
+   * @return the bounds of the cells that changed, empty if there is no override with the identifier.
+   */
+  ChangedBounds removeOverride(const std::string& id, const grid_map::GridMap& map);
+
+  /*!
+   * Removes all overrides.
+   * @param[in] map the map the cells belong to.
+   * @return the bounds of the cells that changed, empty if there were no overrides.
+   */
+  ChangedBounds clearOverrides(const grid_map::GridMap& map);
+
+  /*!
+   * Removes the regions which are expired.
+   * @param[in] time the current time.
+   * @param[in] map the map the cells belong to.
+   * @return the bounds of the cells that changed, empty if no region expired.
+   */
+  ChangedBounds removeExpired(const ros::Time& time, const grid_map::GridMap& map);
+
+  /*!
+   * Gets the state of a cell.
+   * @param[in] index the index of the cell.
+   * @return the state of the cell.
+   */
+  State getState(const grid_map::Index& index) const {
+    if (states_.size() == 0) return State::None;
+    return static_cast<State>(states_(index(0), index(1)));
+  }
+
+  /*!
+   * Gets the version of the overlay, which is incremented by every change of the cell states.
+   * @return the version.
+   */
+  uint64_t getVersion() const { return version_; }
+
+ private:
+  /*!
+   * Rasterizes the regions within bounds, resetting the other cells within the bounds.
+   * @param[in] map the map the cells belong to.
+   * @param[in] bounds the bounds to update.
+   */
+  void rasterize(const grid_map::GridMap& map, const Eigen::AlignedBox2d& bounds);
+
+  /*!
+   * Rasterizes the regions within the bounds of a change and starts a new version if there are any.
+   * @param[in] map the map the cells belong to.
+   * @param[in] changedBounds the bounds of the change.
+   * @return the bounds of the change.
+   */
+  const ChangedBounds& applyChange(const grid_map::GridMap& map, const ChangedBounds& changedBounds);
+
+  /*!
+   * Adds the bounds of a changed region, merged with the bounds it overlaps.
+   * @param[in/out] changedBounds the bounds of the change.
+   * @param[in] bounds the bounds of the changed region.
+   */
+  static void addBounds(ChangedBounds& changedBounds, Eigen::AlignedBox2d bounds);
+
+  /*!
+   * Checks if two regions cover the same cells with the same state.
+   * @param[in] regionA the first region.
+   * @param[in] regionB the second region.
+   * @return true if the regions are equal, independent of their expiry.
+   */
+  static bool isSameRegion(const Region& regionA, const Region& regionB);
+
+  //! Dynamic obstacles.
+  std::vector<Region> dynamicObstacles_;
+
+  //! Overrides by identifier.
+  std::map<std::string, Region> overrides_;
+
+  //! State of each map cell.
+  Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic> states_;
+
+  //! Version of the cell states.
+  uint64_t version_;
+};
+
+/*!
+ * Computes the bounds of a polygon.
+ * @param[in] polygon the polygon.
+ * @return the axis aligned bounding box of the polygon.
+ */
+Eigen::AlignedBox2d getBounds(const grid_map::Polygon& polygon);
+
+/*!
+ * Gets the range of cells whose centers are within bounds.
+ * @param[in] map the map (must have a default start index).
+ * @param[in] bounds the bounds in the map frame.
+ * @param[out] startIndex the first index of the range.
+ * @param[out] size the size of the range.
+ * @return true if the range is not empty.
+ */
+bool getIndexRange(const grid_map::GridMap& map, const Eigen::AlignedBox2d& bounds, grid_map::Index& startIndex, grid_map::Size& size);
+
+}  // namespace traversability_estimation
@@ -0,0 +1,147 @@
+/*
+ * MapSessions.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/MapOverlay.hpp"
+#include "traversability_estimation/SparseCellCache.hpp"
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+
+// ROS
+#include <ros/time.h>
+
+// STD
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Sessions which read a fixed snapshot of the traversability map, i.e. a map generation together with the
+ * overlay as it was when the session was opened. Sessions opened on the same state share a snapshot. Replaced
+ * maps are retained while a snapshot reads them. Since the footprint caches and the clearance depend on the
+ * overlay, every snapshot keeps its own, which persist between the requests of its sessions.
+ */
+class MapSessions {
+ public:
+  //! State read by sessions.
+  struct Snapshot {
+    //! Identifier, unique among all snapshots and never 0.
+    uint64_t id;
+    //! Generation of the map.
+    uint64_t generation;
+    //! Version of the overlay within the map generation.
+    uint64_t overlayVersion;
+    //! Copy of the overlay.
+    MapOverlay overlay;
+    //! Sparse footprint caches, by name of the footprint layer they replace.
+    std::map<std::string, SparseCellCache> sparseFootprintCaches;
+    //! Clearance layer, empty if not computed yet, and the distance up to which it is exact.
+    grid_map::Matrix clearance;
+    double clearanceExactDistance;
+  };
+
+  /*!
+   * Constructor.
+   */
+  MapSessions();
+
+  /*!
+   * Sets the lease timeouts.
+   * @param defaultTimeout the timeout [s] of sessions opened without timeout.
+   * @param maxTimeout the maximal timeout [s].
+   */
+  void setTimeouts(const double defaultTimeout, const double maxTimeout);
+
+  /*!
+   * Opens a session on the current state of the map.
+   * @param timeout the lease timeout [s], the default if not positive.
+   * @param generation the current map generation.
+   * @param overlayVersion the current version of the overlay.
+   * @param overlay the current overlay, copied unless a session already reads this state.
+   * @return the identifier of the session.
+   */
+  unsigned int open(const double timeout, const uint64_t generation, const uint64_t overlayVersion, const MapOverlay& overlay);
+
+  /*!
+   * Closes a session. Its snapshot is removed by the next expire() if no other session reads it.
+   * @param session identifier of the session.
+   * @return true if the session was open.
+   */
+  bool close(const unsigned int session);
+
+  /*!
+   * Renews the lease of a session and gets its snapshot.
+   * @param session identifier of the session.
+   * @return the snapshot, nullptr if the session is not open.
+   */
+  Snapshot* use(const unsigned int session);
+
+  /*!
+   * Removes the expired sessions, the snapshots no session reads and the retained maps no snapshot reads.
+   * @param[out] removedSnapshots generation and identifier of the removed snapshots.
+   */
+  void expire(std::vector<std::pair<uint64_t, uint64_t>>& removedSnapshots);
+
+  /*!
+   * Checks if a snapshot reads a map generation.
+   * @param generation the map generation.
+   * @return true if the generation is read.
+   */
+  bool isPinned(const uint64_t generation) const;
+
+  /*!
+   * Retains a replaced map for the snapshots which read it.
+   * @param generation the generation of the map.
+   * @param map the map, moved from.
+   */
+  void retain(const uint64_t generation, grid_map::GridMap& map);
+
+  /*!
+   * Gets a retained map.
+   * @param generation the generation of the map, must be retained.
+   * @return the map.
+   */
+  grid_map::GridMap& getRetainedMap(const uint64_t generation) { return retainedMaps_.at(generation); }
+
+  /*!
+   * Gets the memory of the retained maps and of the caches of the snapshots.
+   * @return the memory [bytes].
+   */
+  size_t getMemorySize() const;
+
+ private:
+  //! Session reading a snapshot with a lease.
+  struct Session {
+    uint64_t snapshot;
+    double timeout;
+    ros::WallTime expiry;
+  };
+
+  //! Open sessions by identifier.
+  std::map<unsigned int, Session> sessions_;
+  unsigned int lastSession_;
+
+  //! Snapshots by identifier.
+  std::map<uint64_t, Snapshot> snapshots_;
+  uint64_t lastSnapshot_;
+
+  //! Replaced maps that are still read by snapshots, by generation.
+  std::map<uint64_t, grid_map::GridMap> retainedMaps_;
+
+  //! Lease timeouts of sessions [s].
+  double defaultTimeout_;
+  double maxTimeout_;
+};
+
+}  // namespace traversability_estimation
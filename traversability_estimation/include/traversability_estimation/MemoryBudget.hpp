@@ -0,0 +1,106 @@
+/*
+ * MemoryBudget.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// ROS
+#include <diagnostic_updater/diagnostic_updater.h>
+
+// STD
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Accounts the memory of the map layers against a budget. Layers are either required (e.g. the filter
+ * outputs) or evictable, i.e. derived layers such as caches which are rebuilt on demand. When the budget
+ * is exceeded, the evictable layers are selected for eviction in least recently used order.
+ */
+class MemoryBudget {
+ public:
+  MemoryBudget();
+
+  /*!
+   * Sets the budget.
+   * @param budget the budget [bytes], no limit if 0.
+   */
+  void setBudget(size_t budget);
+
+  /*!
+   * Gets the budget.
+   * @return the budget [bytes], no limit if 0.
+   */
+  size_t getBudget() const { return budget_; }
+
+  /*!
+   * Classifies a layer as evictable.
+   * @param layer the name of the layer.
+   */
+  void setEvictable(const std::string& layer);
+
+  /*!
+   * Checks if a layer is evictable.
+   * @param layer the name of the layer.
+   * @return true if the layer is evictable.
+   */
+  bool isEvictable(const std::string& layer) const;
+
+  /*!
+   * Marks a layer as used.
+   * @param layer the name of the layer.
+   */
+  void touch(const std::string& layer);
+
+  /*!
+   * Selects the evictable layers to drop such that the usage gets within the budget, least recently used first.
+   * @param usage the memory of each layer [bytes].
+   * @return the layers to evict, in eviction order. The usage may still exceed the budget if too few layers are evictable.
+   */
+  std::vector<std::string> getLayersToEvict(const std::map<std::string, size_t>& usage) const;
+
+  /*!
+   * Evicts layers while the usage exceeds the budget, least recently used first, and warns if it still does.
+   * @param[in/out] usage the memory of each layer [bytes], the evicted layers are removed.
+   * @param[in] evict function which drops a layer.
+   * @return true if the usage is within the budget.
+   */
+  bool enforce(std::map<std::string, size_t>& usage, const std::function<void(const std::string&)>& evict) const;
+
+  /*!
+   * Reports the budget and the memory usage per layer in the diagnostics.
+   * @param[in] usage the memory of each layer [bytes].
+   * @param[out] status the diagnostic status.
+   */
+  void produceDiagnostics(const std::map<std::string, size_t>& usage, diagnostic_updater::DiagnosticStatusWrapper& status) const;
+
+  /*!
+   * Sums the memory of all layers.
+   * @param usage the memory of each layer [bytes].
+   * @return the total memory [bytes].
+   */
+  static size_t getTotal(const std::map<std::string, size_t>& usage);
+
+ private:
+  //! Budget [bytes], no limit if 0.
+  size_t budget_;
+
+  //! Evictable layers.
+  std::unordered_set<std::string> evictableLayers_;
+
+  //! Logical time of the last use of each layer.
+  std::unordered_map<std::string, uint64_t> lastUse_;
+  uint64_t clock_;
+};
+
+}  // namespace traversability_estimation
@@ -0,0 +1,107 @@
+/*
+ * MotionPrimitiveSet.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// ROS
+#include <geometry_msgs/Pose2D.h>
+
+// STD
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Set of motion primitives of a lattice planner with the cells swept by a footprint along each primitive.
+ * The swept cells are stored as index offsets from the start cell for a number of start heading bins,
+ * such that checking a primitive from any cell is a reduction over a fixed list of cells.
+ */
+class MotionPrimitiveSet {
+ public:
+  /*!
+   * Constructor.
+   * @param primitives poses of each primitive relative to its start pose.
+   * @param footprint vertices of the footprint polygon in the robot base frame, empty for a circular footprint.
+   * @param radius radius of the circular footprint, used if no footprint polygon is given.
+   * @param nHeadingBins number of start heading bins.
+   */
+  MotionPrimitiveSet(const std::vector<std::vector<geometry_msgs::Pose2D>>& primitives, const std::vector<grid_map::Position>& footprint,
+                     const double radius, const unsigned int nHeadingBins);
+
+  /*!
+   * Computes the swept cells of all primitives and heading bins for a map resolution.
+   * @param resolution the resolution of the map [m/cell].
+   */
+  void computeSweptCells(const double resolution);
+
+  /*!
+   * Gets the resolution for which the swept cells were computed.
+   * @return the resolution [m/cell], zero if not computed yet.
+   */
+  double getResolution() const;
+
+  /*!
+   * Gets the number of primitives.
+   * @return the number of primitives.
+   */
+  size_t getNumberOfPrimitives() const;
+
+  /*!
+   * Gets the heading bin of a start yaw.
+   * @param yaw the start yaw [rad].
+   * @return the closest heading bin.
+   */
+  unsigned int getHeadingBin(const double yaw) const;
+
+  /*!
+   * Gets the cells swept by a primitive.
+   * @param primitive index of the primitive.
+   * @param headingBin start heading bin.
+   * @return index offsets of the swept cells from the start cell.
+   */
+  const std::vector<grid_map::Index>& getSweptCells(const size_t primitive, const unsigned int headingBin) const;
+
+  /*!
+   * Gets the length of a primitive.
+   * @param primitive index of the primitive.
+   * @return the length of the path through the poses of the primitive [m].
+   */
+  double getLength(const size_t primitive) const;
+
+ private:
+  /*!
+   * Computes the footprint polygon at a pose.
+   * @param pose the pose of the robot base.
+   * @return the footprint polygon.
+   */
+  grid_map::Polygon getFootprintPolygon(const geometry_msgs::Pose2D& pose) const;
+
+  //! Poses of each primitive relative to its start pose.
+  std::vector<std::vector<geometry_msgs::Pose2D>> primitives_;
+
+  //! Footprint polygon in the robot base frame and radius for circular footprints.
+  std::vector<grid_map::Position> footprint_;
+  double radius_;
+
+  //! Number of start heading bins.
+  unsigned int nHeadingBins_;
+
+  //! Resolution for which the swept cells were computed.
+  double resolution_;
+
+  //! Swept cells by primitive and heading bin.
+  std::vector<std::vector<std::vector<grid_map::Index>>> sweptCells_;
+
+  //! Length of each primitive.
+  std::vector<double> lengths_;
+};
+
+}  // namespace traversability_estimation
@@ -0,0 +1,98 @@
+/*
+ * PointCloudRasterizer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// ROS
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+
+// Eigen
+#include <Eigen/Geometry>
+
+// STD
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Rasterizes point clouds into a rolling elevation map, as a lightweight replacement of an elevation
+ * mapping node. The points of a cloud are binned into the cells in parallel and reduced to their maximum
+ * or mean height, which is merged with the previous height of the cell by an exponential moving average.
+ * The map follows the robot, cells leaving the map are dropped.
+ */
+class PointCloudRasterizer {
+ public:
+  //! Reduction of the heights of the points within a cell.
+  enum class Reduction { Max, Mean };
+
+  PointCloudRasterizer();
+
+  /*!
+   * Sets the geometry of the map and clears it.
+   * @param length the side lengths of the map [m].
+   * @param resolution the cell size [m].
+   * @param frameId the frame of the map.
+   */
+  void setGeometry(const grid_map::Length& length, double resolution, const std::string& frameId);
+
+  /*!
+   * Sets the reduction of the heights within a cell.
+   * @param reduction the reduction.
+   */
+  void setReduction(Reduction reduction);
+
+  /*!
+   * Sets the weight of a new cloud in the temporal merge.
+   * @param weight the weight in (0, 1], 1 keeps only the latest cloud of each cell.
+   */
+  void setTemporalWeight(double weight);
+
+  /*!
+   * Moves the map, e.g. to the robot.
+   * @param center the new center of the map, its height is the height of the map.
+   */
+  void move(const grid_map::Position3& center);
+
+  /*!
+   * Adds a point cloud to the map.
+   * @param cloud the point cloud, with 32 bit float fields x, y and z.
+   * @param transform the transform from the frame of the cloud to the frame of the map.
+   * @return true if successful, false if the cloud has no x, y and z fields.
+   */
+  bool addPointCloud(const sensor_msgs::PointCloud2& cloud, const Eigen::Affine3f& transform);
+
+  /*!
+   * Gets a copy of the elevation map.
+   * @param[in] layers the layers the map must have, missing layers (e.g. horizontal variances) are 0.
+   * @param[out] map the elevation map.
+   * @param[out] zPosition the height of the map.
+   * @return true if successful, false if no cloud was added yet.
+   */
+  bool getMap(const std::vector<std::string>& layers, grid_map::GridMap& map, double& zPosition) const;
+
+ private:
+  //! Rolling elevation map, with the layers elevation, upper_bound, lower_bound, variance and time (since the first cloud [s]).
+  grid_map::GridMap map_;
+  double zPosition_;
+  bool isInitialized_;
+  ros::Time initialStamp_;
+
+  Reduction reduction_;
+  double temporalWeight_;
+
+  //! Protects the map, clouds may be added while the map is read.
+  mutable std::mutex mutex_;
+};
+
+}  // namespace traversability_estimation
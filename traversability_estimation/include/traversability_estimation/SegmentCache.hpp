@@ -0,0 +1,157 @@
+/*
+ * SegmentCache.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// ROS
+#include <geometry_msgs/Pose.h>
+
+// Eigen
+#include <Eigen/Geometry>
+
+// STD
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace traversability_estimation {
+
+/*!
+ * Memoizes the results of footprint path segments, such that paths sharing segments (e.g. candidate
+ * paths of a tree planner with a common prefix) only evaluate the new segments. Segments are identified
+ * by their quantized start and end pose, a key of the footprint and check options, and the state of the map
+ * they were checked on, i.e. the map generation and the session snapshot (0 for the latest map). Lookups
+ * and insertions use the current state, such that alternating requests on several states share the cache.
+ */
+class SegmentCache {
+ public:
+  //! Result of a checked segment.
+  struct Segment {
+    //! If the segment is safe to traverse.
+    bool isSafe;
+    //! Traversability of the segment.
+    double traversability;
+    //! Area of the polygon swept by the footprint along the segment (zero for circular footprints).
+    double area;
+    //! Bounds of the cells covered by the footprint along the segment.
+    Eigen::AlignedBox2d bounds;
+  };
+
+  //! Quantized identification of a segment.
+  struct Key {
+    uint64_t generation;
+    uint64_t snapshot;
+    uint64_t footprint;
+    std::array<int64_t, 12> poses;
+    bool operator==(const Key& other) const {
+      return generation == other.generation && snapshot == other.snapshot && footprint == other.footprint && poses == other.poses;
+    }
+  };
+
+  SegmentCache();
+
+  /*!
+   * Sets the quantization of the segment poses. Segments with the same quantized poses share one entry.
+   * @param positionResolution quantization of the positions [m].
+   * @param orientationResolution quantization of the orientation quaternion components.
+   */
+  void setResolution(const double positionResolution, const double orientationResolution);
+
+  /*!
+   * Sets the maximal number of entries. The cache is cleared when it is full.
+   * @param maxSize the maximal number of entries, 0 disables the cache.
+   */
+  void setMaxSize(const size_t maxSize);
+
+  /*!
+   * Sets the state of the map which the next keys and invalidations refer to.
+   * @param generation the map generation.
+   * @param snapshot the session snapshot, 0 for the latest map.
+   */
+  void setGeneration(const uint64_t generation, const uint64_t snapshot = 0);
+
+  /*!
+   * Removes the entries of a state of the map.
+   * @param generation the map generation.
+   * @param snapshot the session snapshot, 0 for the latest map.
+   */
+  void remove(const uint64_t generation, const uint64_t snapshot);
+
+  /*!
+   * Removes all entries.
+   */
+  void clear();
+
+  /*!
+   * Removes the entries of the current state whose footprint covers cells within bounds.
+   * @param bounds the bounds of the changed cells.
+   */
+  void invalidate(const Eigen::AlignedBox2d& bounds);
+
+  /*!
+   * Computes the key of a segment.
+   * @param footprint key of the footprint and the check options.
+   * @param start start pose of the segment.
+   * @param end end pose of the segment.
+   * @param useOrientation if false, the orientation of the poses is ignored (e.g. for circular footprints).
+   * @return the key of the segment.
+   */
+  Key getKey(const uint64_t footprint, const geometry_msgs::Pose& start, const geometry_msgs::Pose& end,
+             const bool useOrientation) const;
+
+  /*!
+   * Looks up a segment.
+   * @param[in] key key of the segment.
+   * @param[out] segment the cached result.
+   * @return true if the segment was found.
+   */
+  bool get(const Key& key, Segment& segment);
+
+  /*!
+   * Stores the result of a segment.
+   * @param key key of the segment.
+   * @param segment the result of the segment.
+   */
+  void insert(const Key& key, const Segment& segment);
+
+  /*!
+   * Combines a value into a hash.
+   * @param[in/out] hash the hash to update.
+   * @param value the value to combine.
+   */
+  static void combineHash(uint64_t& hash, const uint64_t value);
+
+ private:
+  //! Hash of the segment key.
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  //! Quantizes a value.
+  static int64_t quantize(const double value, const double resolution);
+
+  //! Cached segments.
+  std::unordered_map<Key, Segment, KeyHash> segments_;
+
+  //! State of the map of the next keys.
+  uint64_t generation_;
+  uint64_t snapshot_;
+
+  //! Quantization of positions and orientations.
+  double positionResolution_;
+  double orientationResolution_;
+
+  //! Maximal number of entries.
+  size_t maxSize_;
+
+  //! Statistics of the lookups since the last clear.
+  size_t nHits_;
+  size_t nMisses_;
+};
+
+}  // namespace traversability_estimation
@@ -0,0 +1,110 @@
+/*
+ * SparseCellCache.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// STD
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Cache of cell values keyed by the linear cell index, stored in an open-addressing hash table with linear
+ * probing. Its memory scales with the number of cached cells instead of the map size, which pays off if
+ * only a small fraction of the cells is queried.
+ */
+class SparseCellCache {
+ public:
+  SparseCellCache();
+
+  /*!
+   * Gets the value of a cell.
+   * @param key the linear index of the cell.
+   * @return the cached value, NAN if the cell is not cached.
+   */
+  float get(uint32_t key) const {
+    if (nEntries_ == 0) return NAN;
+    for (size_t slot = getSlot(key);; slot = (slot + 1) & mask_) {
+      if (keys_[slot] == key + 1) return values_[slot];
+      if (keys_[slot] == emptyKey) return NAN;
+    }
+  }
+
+  /*!
+   * Sets the value of a cell.
+   * @param key the linear index of the cell.
+   * @param value the value to cache.
+   */
+  void set(uint32_t key, float value);
+
+  /*!
+   * Removes the cells of a block of the map.
+   * @param startRow the first row of the block.
+   * @param startCol the first column of the block.
+   * @param nRows the number of rows of the block.
+   * @param nCols the number of columns of the block.
+   * @param rows the number of rows of the map.
+   */
+  void eraseBlock(int startRow, int startCol, int nRows, int nCols, int rows);
+
+  /*!
+   * Removes all cells and releases the memory.
+   */
+  void clear();
+
+  /*!
+   * Gets the number of cached cells.
+   * @return the number of cached cells.
+   */
+  size_t size() const { return nEntries_; }
+
+  /*!
+   * Gets the memory of the table.
+   * @return the memory [bytes].
+   */
+  size_t getMemorySize() const { return keys_.size() * (sizeof(uint32_t) + sizeof(float)); }
+
+  /*!
+   * Calls a function for each cached cell.
+   * @param function the function, called with the linear index and the value of the cell.
+   */
+  template <typename Function>
+  void forEach(Function function) const {
+    for (size_t slot = 0; slot < keys_.size(); ++slot) {
+      if (keys_[slot] != emptyKey) function(keys_[slot] - 1, values_[slot]);
+    }
+  }
+
+ private:
+  //! Keys are stored offset by one, such that zero marks an empty slot.
+  static constexpr uint32_t emptyKey = 0;
+
+  /*!
+   * Gets the first slot to probe for a key (Fibonacci hashing).
+   * @param key the linear index of the cell.
+   * @return the slot.
+   */
+  size_t getSlot(uint32_t key) const { return static_cast<size_t>((static_cast<uint64_t>(key) * 11400714819323198485ull) >> shift_); }
+
+  /*!
+   * Reallocates the table and reinserts the cached cells.
+   * @param capacity the new number of slots, a power of two.
+   */
+  void rehash(size_t capacity);
+
+  //! Slots of the table, the capacity is a power of two and at most half of the slots are used.
+  std::vector<uint32_t> keys_;
+  std::vector<float> values_;
+  size_t mask_;
+  unsigned int shift_;
+  size_t nEntries_;
+};
+
+}  // namespace traversability_estimation
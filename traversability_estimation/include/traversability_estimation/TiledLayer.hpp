@@ -0,0 +1,111 @@
+/*
+ * TiledLayer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/TypeDefs.hpp>
+
+// STD
+#include <cstdint>
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Read-only copy of a map layer stored in 8x8 tiles, grouped into blocks of 4x4 tiles which are stored row by
+ * row, with the tiles of a block in Z-order (Morton order). A tile covers four cache lines and a block one
+ * page, and tiles which are close in the map are mostly close in memory, such that the circle, line and
+ * polygon walks of the footprint checks touch fewer cache lines and pages than in the column-major layer.
+ * Only the blocks covering the layer are allocated. Requires a map with a default start index.
+ */
+class TiledLayer {
+ public:
+  /*!
+   * Copies a layer into the tiled layout.
+   * @param[in] matrix the data of the layer.
+   */
+  void fromMatrix(const grid_map::Matrix& matrix);
+
+  /*!
+   * Releases the data.
+   */
+  void clear();
+
+  /*!
+   * Checks if the layer holds data.
+   * @return true if empty.
+   */
+  bool empty() const { return data_.empty(); }
+
+  /*!
+   * Gets the memory held by the layer.
+   * @return the memory [bytes].
+   */
+  size_t getMemorySize() const { return data_.capacity() * sizeof(float); }
+
+  /*!
+   * Gets the value of a cell.
+   * @param[in] index the index of the cell (must be within the layer).
+   * @return the value of the cell.
+   */
+  float at(const grid_map::Index& index) const {
+    const uint32_t row = static_cast<uint32_t>(index(0));
+    const uint32_t column = static_cast<uint32_t>(index(1));
+    return data_[getTileOffset(row >> tileBits, column >> tileBits) | ((column & tileMask) << tileBits) | (row & tileMask)];
+  }
+
+ private:
+  //! Tiles have 2^tileBits cells per side, blocks have 2^blockBits tiles per side.
+  static constexpr uint32_t tileBits = 3;
+  static constexpr uint32_t tileMask = (1u << tileBits) - 1u;
+  static constexpr uint32_t blockBits = 2;
+  static constexpr uint32_t blockMask = (1u << blockBits) - 1u;
+
+  /*!
+   * Gets the offset of the first cell of a tile in the data.
+   * @param[in] tileRow the tile row.
+   * @param[in] tileColumn the tile column.
+   * @return the offset.
+   */
+  size_t getTileOffset(const uint32_t tileRow, const uint32_t tileColumn) const {
+    const size_t block = static_cast<size_t>(tileRow >> blockBits) * blockColumns_ + (tileColumn >> blockBits);
+    const size_t tile = (block << (2 * blockBits)) | interleaveBits(tileRow & blockMask, tileColumn & blockMask);
+    return tile << (2 * tileBits);
+  }
+
+  /*!
+   * Computes the Z-order code of a tile, interleaving the bits of the tile row and column.
+   * @param[in] row the tile row (below 2^16).
+   * @param[in] column the tile column (below 2^16).
+   * @return the Z-order code.
+   */
+  static uint32_t interleaveBits(const uint32_t row, const uint32_t column) { return spreadBits(row) | (spreadBits(column) << 1); }
+
+  /*!
+   * Spreads the lower 16 bits of a value to the even bits.
+   * @param[in] value the value.
+   * @return the spread bits.
+   */
+  static uint32_t spreadBits(uint32_t value) {
+    value &= 0x0000ffffu;
+    value = (value | (value << 8)) & 0x00ff00ffu;
+    value = (value | (value << 4)) & 0x0f0f0f0fu;
+    value = (value | (value << 2)) & 0x33333333u;
+    value = (value | (value << 1)) & 0x55555555u;
+    return value;
+  }
+
+  //! Cells of all blocks, block by block, tile by tile in Z-order within a block, column-major within a tile.
+  std::vector<float> data_;
+
+  //! Number of blocks per block row.
+  size_t blockColumns_ = 0;
+};
+
+}  // namespace traversability_estimation
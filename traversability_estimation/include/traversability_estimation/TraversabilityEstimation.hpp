@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include "traversability_estimation/FilterChainPool.hpp"
+#include "traversability_estimation/LatencyStatistics.hpp"
+#include "traversability_estimation/LookAheadWindow.hpp"
+#include "traversability_estimation/PointCloudRasterizer.hpp"
 #include "traversability_estimation/TraversabilityMap.hpp"
 
 // Grid Map
@@ -17,16 +21,32 @@
 #include <grid_map_ros/grid_map_ros.hpp>
 
 // Traversability estimation
+#include <traversability_msgs/CheckConnectivity.h>
 #include <traversability_msgs/CheckFootprintPath.h>
+#include <traversability_msgs/CheckMotionPrimitives.h>
+#include <traversability_msgs/CloseSession.h>
+#include <traversability_msgs/ComputeTraversability.h>
+#include <traversability_msgs/GetNearestTraversablePose.h>
+#include <traversability_msgs/GetSessionTraversability.h>
+#include <traversability_msgs/OpenSession.h>
+#include <traversability_msgs/Overwrite.h>
+#include <traversability_msgs/RegisterMotionPrimitives.h>
 
 // ROS
 #include <filters/filter_chain.h>
+#include <message_filters/subscriber.h>
+#include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <sensor_msgs/Image.h>
+#include <sensor_msgs/PointCloud2.h>
 #include <std_srvs/Empty.h>
+#include <tf/message_filter.h>
 #include <tf/transform_listener.h>
 
 // STD
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -86,6 +106,85 @@ class TraversabilityEstimation {
   bool checkFootprintPath(traversability_msgs::CheckFootprintPath::Request& request,
                           traversability_msgs::CheckFootprintPath::Response& response);
 
+  /*!
+   * ROS service callback function to return the closest traversable pose to a goal.
+   * @param request the ROS service request defining the goal and the footprint.
+   * @param response the ROS service response containing the closest traversable pose.
+   * @return true if successful.
+   */
+  bool getNearestTraversablePose(traversability_msgs::GetNearestTraversablePose::Request& request,
+                                 traversability_msgs::GetNearestTraversablePose::Response& response);
+
+  /*!
+   * ROS service callback function to register a set of motion primitives.
+   * @param request the ROS service request defining the motion primitives and the footprint.
+   * @param response the ROS service response containing the identifier of the primitive set.
+   * @return true if successful.
+   */
+  bool registerMotionPrimitives(traversability_msgs::RegisterMotionPrimitives::Request& request,
+                                traversability_msgs::RegisterMotionPrimitives::Response& response);
+
+  /*!
+   * ROS service callback function to check motion primitives of a registered set.
+   * @param request the ROS service request defining the primitives and their start poses.
+   * @param response the ROS service response containing the safety and cost of each primitive.
+   * @return true if successful.
+   */
+  bool checkMotionPrimitives(traversability_msgs::CheckMotionPrimitives::Request& request,
+                             traversability_msgs::CheckMotionPrimitives::Response& response);
+
+  /*!
+   * ROS service callback function to open a session pinned to the current traversability map.
+   * @param request the ROS service request defining the lease timeout.
+   * @param response the ROS service response containing the session identifier.
+   * @return true if successful.
+   */
+  bool openSession(traversability_msgs::OpenSession::Request& request, traversability_msgs::OpenSession::Response& response);
+
+  /*!
+   * ROS service callback function to close a session.
+   * @param request the ROS service request defining the session.
+   * @param response the ROS service response.
+   * @return true if successful.
+   */
+  bool closeSession(traversability_msgs::CloseSession::Request& request, traversability_msgs::CloseSession::Response& response);
+
+  /*!
+   * ROS service callback function to check if pairs of positions are in the same traversable component.
+   * @param request the ROS service request containing the pairs of positions.
+   * @param response the ROS service response containing if each pair is connected.
+   * @return true if successful.
+   */
+  bool checkConnectivity(traversability_msgs::CheckConnectivity::Request& request,
+                         traversability_msgs::CheckConnectivity::Response& response);
+
+  /*!
+   * ROS service callback function to compute the traversability of an arbitrary elevation map on a pooled
+   * filter chain, without changing the traversability map of the node.
+   * @param request the ROS service request containing the elevation map and filter parameter overrides.
+   * @param response the ROS service response containing the computed layers.
+   * @return true if successful.
+   */
+  bool computeTraversability(traversability_msgs::ComputeTraversability::Request& request,
+                             traversability_msgs::ComputeTraversability::Response& response);
+
+  /*!
+   * ROS service callback function to return a submap of the traversability map of a session.
+   * @param request the ROS service request defining the session and the submap.
+   * @param response the ROS service response containing the submap.
+   * @return true if successful.
+   */
+  bool getSessionTraversabilityMap(traversability_msgs::GetSessionTraversability::Request& request,
+                                   traversability_msgs::GetSessionTraversability::Response& response);
+
+  /*!
+   * ROS service callback function to add, replace or remove a region override.
+   * @param request the ROS service request defining the override.
+   * @param response the ROS service response.
+   * @return true if successful.
+   */
+  bool overwrite(traversability_msgs::Overwrite::Request& request, traversability_msgs::Overwrite::Response& response);
+
   /*!
    * Callback function that receives an image and converts into
    * an elevation layer of a grid map.
@@ -93,6 +192,27 @@ class TraversabilityEstimation {
    */
   void imageCallback(const sensor_msgs::Image& image);
 
+  /*!
+   * Callback function that rasterizes a point cloud into the built-in elevation map,
+   * which is then used instead of requesting a submap from the elevation mapping.
+   * @param cloud the received point cloud.
+   */
+  void pointCloudCallback(const sensor_msgs::PointCloud2ConstPtr& cloud);
+
+  /*!
+   * Callback function that receives the current dynamic obstacles and applies them on top of the
+   * traversability map without recomputing it.
+   * @param dynamicObstacles the received dynamic obstacles.
+   */
+  void dynamicObstaclesCallback(const traversability_msgs::DynamicObstacles& dynamicObstacles);
+
+  /*!
+   * Callback function that receives the path the robot is planned to drive, along which the submap is placed
+   * and the footprint caches are warmed.
+   * @param path the received path.
+   */
+  void plannedPathCallback(const geometry_msgs::PoseArray& path);
+
   /*!
    * ROS service callback function that computes the traversability of a footprint
    * at each map cell position twice: first oriented in x-direction, and second
@@ -132,6 +252,11 @@ class TraversabilityEstimation {
    */
   bool readParameters();
 
+  /*!
+   * Configures the filter chains of the compute_traversability service from the filter chain parameters.
+   */
+  void configureFilterChainPool();
+
   /*!
    * Computes the traversability and publishes it as grid map.
    * Traversability is set between 0.0 and 1.0, where a value of 0.0 means not
@@ -154,6 +279,47 @@ class TraversabilityEstimation {
    */
   bool requestElevationMap(grid_map_msgs::GridMap& map);
 
+  /*!
+   * Gets the current position of the robot in the map frame.
+   * @param[out] position the position of the robot.
+   * @return true if successful, false if the transform is not available.
+   */
+  bool getRobotPosition(grid_map::Position& position);
+
+  /*!
+   * Sets the current position of the robot for the next traversability map if the cost-to-go needs it.
+   */
+  void updateRobotPosition();
+
+  /*!
+   * Gets the current position and planar velocity of the robot in the map frame, the velocity is
+   * estimated from the position look_ahead/velocity_interval before.
+   * @param[out] position the position of the robot.
+   * @param[out] velocity the velocity of the robot, zero if the earlier position is not available.
+   * @return true if successful, false if the transform is not available.
+   */
+  bool getRobotMotion(grid_map::Position& position, Eigen::Vector2d& velocity);
+
+  /*!
+   * Places the requested submap ahead of the robot from its velocity and the last checked path.
+   * @param[out] center the center of the submap.
+   * @param[out] length the size of the submap.
+   * @return true if successful, false if the robot position is not available.
+   */
+  bool computeLookAheadWindow(grid_map::Position& center, grid_map::Length& length);
+
+  /*!
+   * Sets the path the robot is planned to drive, if it is in the map frame.
+   * @param path the poses of the path.
+   */
+  void setPlannedPath(const geometry_msgs::PoseArray& path);
+
+  /*!
+   * Requests the footprint caches to be warmed along the last checked path or, if there is none, along the
+   * motion of the robot predicted from its velocity.
+   */
+  void warmFootprintCaches();
+
   /*!
    * Initializes a new traversability map based on the given grid map. Previous traversability map is overwritten.
    * @param gridMap grid map object to be used to compute new traversability map.
@@ -161,11 +327,42 @@ class TraversabilityEstimation {
    */
   bool initializeTraversabilityMapFromGridMap(const grid_map::GridMap& gridMap);
 
+  /*!
+   * Applies the real-time scheduling of the query threads to the calling thread, once per thread.
+   */
+  void configureQueryThread() const;
+
+  /*!
+   * Applies the real-time scheduling of the compute thread to the calling thread, once per thread.
+   */
+  void configureComputeThread() const;
+
+  /*!
+   * Locks the current and future memory of the process in RAM, which faults in the map buffers and the
+   * thread stacks allocated by the first update, and keeps freed heap memory for reuse. With a finite memlock
+   * limit and without CAP_IPC_LOCK, only the current memory and a prefaulted heap reserve of the map size are locked.
+   * @return true if successful.
+   */
+  bool lockMemory();
+
   //! ROS node handle.
   ros::NodeHandle& nodeHandle_;
 
+  //! Node handles of the query services and the map update, on the dedicated queues if real-time threads are used.
+  ros::NodeHandle queryNodeHandle_;
+  ros::NodeHandle computeNodeHandle_;
+
   //! ROS service server.
   ros::ServiceServer footprintPathService_;
+  ros::ServiceServer nearestTraversablePoseService_;
+  ros::ServiceServer registerMotionPrimitivesService_;
+  ros::ServiceServer checkMotionPrimitivesService_;
+  ros::ServiceServer openSessionService_;
+  ros::ServiceServer closeSessionService_;
+  ros::ServiceServer getSessionTraversabilityService_;
+  ros::ServiceServer computeTraversabilityService_;
+  ros::ServiceServer checkConnectivityService_;
+  ros::ServiceServer overwriteService_;
   ros::ServiceServer updateTraversabilityService_;
   ros::ServiceServer getTraversabilityService_;
   ros::ServiceServer updateParameters_;
@@ -175,6 +372,7 @@ class TraversabilityEstimation {
 
   //! Image subscriber.
   ros::Subscriber imageSubscriber_;
+  ros::Subscriber dynamicObstaclesSubscriber_;
   std::string imageTopic_;
   grid_map::GridMap imageGridMap_;
   grid_map::Position imagePosition_;
@@ -183,6 +381,13 @@ class TraversabilityEstimation {
   double imageMinHeight_;
   double imageMaxHeight_;
 
+  //! Point cloud input, rasterized directly into an elevation map.
+  message_filters::Subscriber<sensor_msgs::PointCloud2> pointCloudSubscriber_;
+  std::string pointCloudTopic_;
+  bool usePointCloud_;
+  double pointCloudResolution_;
+  PointCloudRasterizer pointCloudRasterizer_;
+
   //! Grid Map topic to initialize traversability map.
   ros::Subscriber gridMapToInitTraversabilityMapSubscriber_;
   std::string gridMapToInitTraversabilityMapTopic_;
@@ -197,6 +402,9 @@ class TraversabilityEstimation {
   //! TF listener.
   tf::TransformListener transformListener_;
 
+  //! Passes point clouds on once their transform to the map frame is available.
+  std::unique_ptr<tf::MessageFilter<sensor_msgs::PointCloud2>> pointCloudFilter_;
+
   //! Center point of the requested map.
   geometry_msgs::PointStamped submapPoint_;
 
@@ -221,6 +429,27 @@ class TraversabilityEstimation {
   //! Requested map length in [m].
   grid_map::Length mapLength_;
 
+  //! Place the requested map from the motion of the robot, with the area of the map length.
+  bool useLookAhead_;
+  LookAheadWindow lookAheadWindow_;
+  double velocityInterval_;
+
+  //! Warm the footprint caches after each update, along the motion predicted over the time horizon [s].
+  bool useCacheWarming_;
+  double cacheWarmingTimeHorizon_;
+
+  //! Positions of the planned path, its time and how long it is used to place the map and warm the caches [s].
+  //! The path is received on its topic or, if there is none, taken from the last checked path outside of sessions.
+  ros::Subscriber plannedPathSubscriber_;
+  std::string plannedPathTopic_;
+  std::vector<grid_map::Position> plannedPath_;
+  ros::Time plannedPathStamp_;
+  double plannedPathTimeout_;
+  std::mutex plannedPathMutex_;
+
+  //! Resolution of the last received elevation map, the look-ahead window is aligned to its cells.
+  double elevationMapResolution_;
+
   //! Traversability map types.
   const std::string traversabilityType_;
   const std::string slopeType_;
@@ -236,6 +465,35 @@ class TraversabilityEstimation {
 
   //! Use raw or fused map.
   bool useRawMap_;
+
+  //! Serve the queries and the map update from dedicated threads.
+  bool useRealtimeThreads_;
+  int nQueryThreads_;
+
+  //! CPUs and SCHED_FIFO priorities (0 for default scheduling) of the query and compute threads.
+  std::vector<int> queryCpus_;
+  int queryPriority_;
+  std::vector<int> computeCpus_;
+  int computePriority_;
+
+  //! Lock the memory after the first update.
+  bool isMemoryLockEnabled_;
+  std::atomic<bool> isMemoryLockRequested_;
+
+  //! Latencies of the footprint path checks.
+  LatencyStatistics pathCheckLatency_;
+
+  //! Filter chains of the compute_traversability service and the number of requests served at the same time.
+  FilterChainPool filterChainPool_;
+  int nComputeServiceWorkers_;
+
+  //! Dedicated callback queues and their threads, the spinners are declared last to stop first.
+  ros::CallbackQueue queryQueue_;
+  ros::CallbackQueue computeQueue_;
+  ros::CallbackQueue computeServiceQueue_;
+  std::unique_ptr<ros::AsyncSpinner> querySpinner_;
+  std::unique_ptr<ros::AsyncSpinner> computeSpinner_;
+  std::unique_ptr<ros::AsyncSpinner> computeServiceSpinner_;
 };
 
 }  // namespace traversability_estimation
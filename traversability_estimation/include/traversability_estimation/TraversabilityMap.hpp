@@ -8,7 +8,22 @@
 
 #pragma once
 
+#include "traversability_estimation/CacheWarming.hpp"
+#include "traversability_estimation/FilterChecks.hpp"
+#include "traversability_estimation/FootprintCaches.hpp"
+#include "traversability_estimation/MapOverlay.hpp"
+#include "traversability_estimation/MapSessions.hpp"
+#include "traversability_estimation/MemoryBudget.hpp"
+#include "traversability_estimation/MotionPrimitiveSet.hpp"
+#include "traversability_estimation/SegmentCache.hpp"
+#include "traversability_estimation/TiledLayer.hpp"
+#include "traversability_estimation/TraversableComponents.hpp"
+#include "traversability_estimation/UntraversableCells.hpp"
+
 // Traversability
+#include <filters/SimdKernels.hpp>
+#include <filters/ThreadPool.hpp>
+#include <traversability_msgs/DynamicObstacles.h>
 #include <traversability_msgs/FootprintPath.h>
 #include <traversability_msgs/TraversabilityResult.h>
 
@@ -16,13 +31,17 @@
 #include <grid_map_ros/grid_map_ros.hpp>
 
 // ROS
+#include <diagnostic_updater/diagnostic_updater.h>
 #include <filters/filter_chain.h>
+#include <geometry_msgs/PolygonStamped.h>
 #include <ros/ros.h>
 #include <sensor_msgs/Image.h>
 #include <std_srvs/Empty.h>
 #include <tf/transform_listener.h>
 
 // STD
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +57,10 @@ constexpr double traversabilityMaxValue = 1.0;
 /*!
  * The terrain traversability estimation core. Updates the traversbility map and
  * evaluates the traversability of single footprints on this map.
+ *
+ * Every new traversability map is converted to the default start index before it replaces the current one,
+ * such that the storage indices grow with decreasing position. The index ranges of regions (getIndexRange,
+ * used by the overlay, the clearance and the components updates) are contiguous blocks only under this invariant.
  */
 class TraversabilityMap {
  public:
@@ -64,10 +87,11 @@ class TraversabilityMap {
    * @param[in] path the footprint path that has to be checked.
    * @param[in] publishPolygons says if checked polygon and untraversable polygon should be computed and published.
    * @param[out] result the traversability result.
+   * @param[in] session session whose map is used, 0 for the latest map.
    * @return true if successful.
    */
   bool checkFootprintPath(const traversability_msgs::FootprintPath& path, traversability_msgs::TraversabilityResult& result,
-                          const bool publishPolygons = false);
+                          const bool publishPolygons = false, const unsigned int session = 0);
 
   /*!
    * Computes the traversability of a footprint at each map cell position twice:
@@ -105,19 +129,82 @@ class TraversabilityMap {
    */
   bool setElevationMap(const grid_map_msgs::GridMap& msg);
 
+  /*!
+   * Set the elevation map, e.g. from the point cloud rasterizer without a message.
+   * @param[in] elevationMap grid map with a layer 'elevation'.
+   * @param[in] zPosition height of the map.
+   * @return true if successful.
+   */
+  bool setElevationMap(const grid_map::GridMap& elevationMap, double zPosition);
+
   /*!
    * Get the traversability map.
    * @return the requested traversability map.
    */
   grid_map::GridMap getTraversabilityMap();
 
+  /*!
+   * Replaces the dynamic obstacles, which are applied as untraversable cells on top of the traversability
+   * map until they expire. Only cached results near the changed cells are invalidated.
+   * @param[in] msg the dynamic obstacles.
+   * @return true if successful.
+   */
+  bool setDynamicObstacles(const traversability_msgs::DynamicObstacles& msg);
+
+  /*!
+   * Adds a region override, or replaces the override with the same identifier. Overrides are applied on top
+   * of the traversability map of every map generation until they expire. Keep-out regions take precedence
+   * over traversable regions and dynamic obstacles over traversable regions. Only cached results near the
+   * changed cells are invalidated.
+   * @param[in] id identifier of the override.
+   * @param[in] polygon region of the override.
+   * @param[in] isKeepOut true if the region is untraversable, false if it is traversable.
+   * @param[in] lifetime lifetime [s] of the override, it never expires if not positive.
+   * @return true if successful.
+   */
+  bool setOverride(const std::string& id, const geometry_msgs::PolygonStamped& polygon, const bool isKeepOut, const double lifetime);
+
+  /*!
+   * Removes a region override.
+   * @param[in] id identifier of the override, all overrides are removed if empty.
+   * @return true if successful, false if there is no override with the identifier.
+   */
+  bool removeOverride(const std::string& id);
+
+  /*!
+   * Opens a session pinned to the current traversability map and overlay. Requests in the session read this
+   * state, i.e. later overlay changes and maps are not seen, until the session is closed or its lease expires.
+   * The lease is renewed by every request in the session.
+   * @param[in] timeout lease timeout [s], the default timeout is used if not positive.
+   * @param[out] session identifier of the session.
+   * @param[out] generation generation of the map the session is pinned to.
+   * @return true if successful.
+   */
+  bool openSession(const double timeout, unsigned int& session, uint64_t& generation);
+
+  /*!
+   * Closes a session, releasing its map if no other session reads it.
+   * @param[in] session identifier of the session.
+   * @return true if the session was open.
+   */
+  bool closeSession(const unsigned int session);
+
+  /*!
+   * Get the traversability map of a session.
+   * @param[in] session identifier of the session, 0 for the latest map.
+   * @param[out] map the traversability map.
+   * @return true if the session is open.
+   */
+  bool getTraversabilityMap(const unsigned int session, grid_map::GridMap& map);
+
   /*!
    * Resets the cached traversability values.
    */
   void resetTraversabilityFootprintLayers();
 
   /*!
-   * Publishes the latest traversability map.
+   * Publishes the latest traversability map. The maps are serialized and published asynchronously in the order
+   * of the calls, maps which are superseded before their serialization starts are dropped.
    */
   void publishTraversabilityMap();
 
@@ -165,6 +252,115 @@ class TraversabilityMap {
    */
   bool createLayers(bool useRawMap);
 
+  /*!
+   * Computes the clearance layer, i.e. the distance of each cell to the closest cell which is not
+   * traversable according to the filters (see isTraversableForFilters).
+   * @return true if successful.
+   */
+  bool computeClearance();
+
+  /*!
+   * Requests the footprint caches to be filled in a corridor around the given positions, e.g. the planned
+   * path or the predicted motion of the robot, such that the first path checks along it find warm caches.
+   * The caches are filled by a low priority thread, which pauses while queries are checked and stops when
+   * the map is replaced or a new corridor is requested. Does nothing if cache warming is disabled.
+   * @param[in] corridor positions along the corridor in the map frame, starting at the robot.
+   */
+  void warmFootprintCaches(const std::vector<grid_map::Position>& corridor);
+
+  /*!
+   * Searches the closest pose to a goal at which the footprint is traversable. The search visits rings of
+   * cells with increasing distance to the goal and tests them on the clearance layer, such that its cost
+   * grows with the distance to the closest traversable pose and not with the size of the map.
+   * @param[in] goal the desired pose.
+   * @param[in] radius the radius of a circular footprint, used if footprint is empty.
+   * @param[in] footprint vertices of the footprint polygon in the robot base frame.
+   * @param[in] headings yaw angles tried for a polygonal footprint. The yaw of the goal is used if empty.
+   * @param[in] maxDistance maximum distance between the goal and the returned pose.
+   * @param[out] pose the closest traversable pose.
+   * @return true if a traversable pose was found within maxDistance, false otherwise.
+   */
+  bool getNearestTraversablePose(const geometry_msgs::Pose& goal, const double& radius,
+                                 const std::vector<geometry_msgs::Point32>& footprint, const std::vector<double>& headings,
+                                 const double& maxDistance, geometry_msgs::Pose& pose);
+
+  /*!
+   * Registers a set of motion primitives, whose swept cells are precomputed for the map resolution.
+   * @param[in] motionPrimitiveSet the motion primitive set.
+   * @return the identifier of the registered set.
+   */
+  unsigned int registerMotionPrimitiveSet(const MotionPrimitiveSet& motionPrimitiveSet);
+
+  /*!
+   * Checks motion primitives of a registered set, each from a start pose. The start pose is snapped to its
+   * cell and heading bin, and the primitive is checked on the precomputed swept cells with the clearance layer.
+   * @param[in] motionPrimitiveSet identifier of the registered set.
+   * @param[in] primitives indices of the checked primitives in the set.
+   * @param[in] starts start pose of each checked primitive in the map frame.
+   * @param[out] isSafe if each primitive is safe to execute.
+   * @param[out] traversability mean traversability of the cells swept by each primitive.
+   * @param[out] cost length of each primitive weighted by its traversability, infinite if unsafe.
+   * @return true if all primitives could be checked.
+   */
+  bool checkMotionPrimitives(const unsigned int motionPrimitiveSet, const std::vector<unsigned int>& primitives,
+                             const std::vector<geometry_msgs::Pose2D>& starts, std::vector<bool>& isSafe,
+                             std::vector<double>& traversability, std::vector<double>& cost);
+
+  /*!
+   * Sets the position of the robot that belongs to the next elevation map.
+   * @param[in] position position of the robot in the map frame.
+   */
+  void setRobotPosition(const grid_map::Position& position);
+
+  /*!
+   * Checks if the cost-to-go layer is computed, i.e. if the robot position is needed.
+   * @return true if the cost-to-go is enabled.
+   */
+  bool isCostToGoEnabled() const { return computeCostToGo_; }
+
+  /*!
+   * Computes the cost-to-go layer, i.e. the traversability-weighted cost to reach each cell from the
+   * robot position through cells at which the configured circular footprint is traversable.
+   * Cells which are not reachable are set to NAN.
+   * @return true if successful.
+   */
+  bool computeCostToGoFromRobot();
+
+  /*!
+   * Computes the traversable component layer, which labels the connected regions of the cells at which the
+   * configured circular footprint is traversable. Cells at which it is not traversable are set to NAN.
+   * @return true if successful.
+   */
+  bool computeTraversableComponents();
+
+  /*!
+   * Checks if two positions are in the same traversable component, i.e. if the configured circular footprint
+   * can move between them. Takes constant time.
+   * @param[in] positionA the first position.
+   * @param[in] positionB the second position.
+   * @param[out] isConnected true if both positions are in the same traversable component.
+   * @return true if the check could be done, false if the components are not computed.
+   */
+  bool areInSameTraversableComponent(const grid_map::Position& positionA, const grid_map::Position& positionB, bool& isConnected);
+
+  /*!
+   * Gets the generation of the traversability map, which is incremented with every new map.
+   * @return the generation of the traversability map.
+   */
+  uint64_t getMapGeneration() const;
+
+  /*!
+   * Gets the memory held by each layer of the traversability map, by the tiled copies ("tiled_layers") and
+   * by the maps retained for sessions ("retained_maps").
+   * @param[out] usage the memory of each layer [bytes].
+   */
+  void getMemoryUsage(std::map<std::string, size_t>& usage) const;
+
+  /*!
+   * Publishes the untraversable regions of the latest traversability map as simplified contour polygons.
+   */
+  void publishUntraversablePolygons();
+
  private:
   /*!
    * Reads and verifies the ROS parameters.
@@ -172,17 +368,61 @@ class TraversabilityMap {
    */
   bool readParameters();
 
+  /*!
+   * Configures the traversability filters, either the statically composed pipeline (if selected by
+   * filter_pipeline and compiled in) or the filter chain loaded with pluginlib.
+   * @return true if successful.
+   */
+  bool configureFilters();
+
+  /*!
+   * Gets the map to warm the footprint caches of, after computing the clearance the first check would compute.
+   * @param[out] geometry the geometry of the map, without layers.
+   * @param[out] generation the generation of the map.
+   * @return false if there is no map yet.
+   */
+  bool prepareCacheWarming(grid_map::GridMap& geometry, uint64_t& generation);
+
+  /*!
+   * Fills the footprint caches of a batch of cells under the map lock.
+   * @param[in] cells the cells.
+   * @param[in] generation the generation of the map the cells belong to.
+   * @return false if the map was replaced meanwhile.
+   */
+  bool warmCells(const std::vector<grid_map::Index>& cells, uint64_t generation);
+
+  /*!
+   * Updates the traversable components after the cells within a region changed.
+   * @param[in] bounds the changed region, including the reach of the footprint.
+   */
+  void updateTraversableComponents(const Eigen::AlignedBox2d& bounds);
+
+  /*!
+   * Configures the statically composed filter pipeline from the filter chain configuration, which must
+   * list the filters of the pipeline in order, optionally followed by deletion filters.
+   * @param config the filter chain configuration.
+   * @return true if successful, false if the configuration does not match the pipeline or it is not compiled in.
+   */
+  bool configureStaticFilterPipeline(XmlRpc::XmlRpcValue& config);
+
+  /*!
+   * Runs the traversability filters.
+   * @param elevationMap the elevation map, may be modified.
+   * @param traversabilityMap the filtered map.
+   * @return true if successful.
+   */
+  bool updateFilters(grid_map::GridMap& elevationMap, grid_map::GridMap& traversabilityMap);
+
   /*!
    * Gets the traversability value of the submap defined by the polygon. Is true if the whole polygon is traversable.
    * @param[in] polygon polygon that defines submap of the traversability map.
-   * @param[in] computeUntraversablePolygon true if untraversable polygon within submap checked for traversability should be computed.
    * @param[out] traversability traversability value of submap defined by the polygon, the traversability is the mean of each cell within
    *             the polygon.
-   * @param[out] untraversablePolygon untraversable polygon within area checked for traversability.
+   * @param[out] untraversableCells if not null, all untraversable cells within the polygon are added, otherwise the check stops at
+   *             the first untraversable cell.
    * @return true if the whole polygon is traversable, false otherwise.
    */
-  bool isTraversable(const grid_map::Polygon& polygon, const bool& computeUntraversablePolygon, double& traversability,
-                     grid_map::Polygon& untraversablePolygon);
+  bool isTraversable(const grid_map::Polygon& polygon, double& traversability, UntraversableCells* untraversableCells);
 
   /*!
    * Gets the traversability value of the submap defined by the polygon. Is true if the whole polygon is traversable.
@@ -197,15 +437,15 @@ class TraversabilityMap {
    * Gets the traversability value of a circular footprint.
    * @param[in] center the center position of the footprint.
    * @param[in] radiusMax the maximum radius of the footprint.
-   * @param[in] computeUntraversablePolygon true if untraversable polygon within submap checked for traversability should be computed.
    * @param[out] traversability traversability value of the footprint.
-   * @param[out] untraversablePolygon untraversable polygon within area checked for traversability.
+   * @param[out] untraversableCells if not null, all untraversable cells within the footprint are added, otherwise the check stops at
+   *             the first untraversable cell.
    * @param[in] radiusMin if set (not zero), footprint inflation is applied and radiusMin is the minimum
    * valid radius of the footprint.
    * @return true if the circular footprint is traversable, false otherwise.
    */
-  bool isTraversable(const grid_map::Position& center, const double& radiusMax, const bool& computeUntraversablePolygon,
-                     double& traversability, grid_map::Polygon& untraversablePolygon, const double& radiusMin = 0);
+  bool isTraversable(const grid_map::Position& center, const double& radiusMax, double& traversability,
+                     UntraversableCells* untraversableCells, const double& radiusMin = 0);
 
   /*!
    * Gets the traversability value of a circular footprint.
@@ -227,33 +467,6 @@ class TraversabilityMap {
    */
   bool checkInclination(const grid_map::Position& start, const grid_map::Position& end);
 
-  /*!
-   * Checks if the map is traversable, only regarding steps, at the position defined
-   * by the map index.
-   * Small ditches and holes are not detected as steps.
-   * @param[in] index index of the map to check.
-   * @return true if no step is detected, false otherwise.
-   */
-  bool checkForStep(const grid_map::Index& indexStep);
-
-  /*!
-   * Checks if the map is traversable, only regarding slope, at the position defined
-   * by the map index.
-   * Small local slopes are not detected as slopes.
-   * @param[in] index index of the map to check.
-   * @return true if traversable regarding slope, false otherwise.
-   */
-  bool checkForSlope(const grid_map::Index& index);
-
-  /*!
-   * Checks if the map is traversable, only regarding roughness, at the position defined
-   * by the map index.
-   * Small local roughness is still detected as traversable terrain.
-   * @param[in] index index of the map to check.
-   * @return true if traversable regarding roughness, false otherwise.
-   */
-  bool checkForRoughness(const grid_map::Index& index);
-
   /*!
    * Publishes the footprint polygon.
    * @param[in] polygon footprint polygon checked for traversability.
@@ -261,6 +474,12 @@ class TraversabilityMap {
    */
   void publishFootprintPolygon(const grid_map::Polygon& polygon, double zPosition = 0.0);
 
+  /*!
+   * Publishes the convex hull of the untraversable cells collected for the current path.
+   * @param[in] zPosition height of the polygon.
+   */
+  void publishUntraversablePolygon(double zPosition = 0.0);
+
   /*!
    * Publishes the untraversable polygon.
    * @param[in] untraversablePolygon polygon indicating untraversable parts..
@@ -282,6 +501,133 @@ class TraversabilityMap {
    */
   bool isTraversableForFilters(const grid_map::Index& index);
 
+  /*!
+   * Same as isTraversableForFilters, without locking. Requires the map lock.
+   * @param[in] index index of the map to check.
+   * @return true if traversable for defined filters.
+   */
+  bool checkFilters(const grid_map::Index& index);
+
+  /*!
+   * Gets the filter checks of the current map, overlay and footprint caches. Requires the map lock while used.
+   * @return the filter checks.
+   */
+  FilterChecks getFilterChecks();
+
+  /*!
+   * Checks the filters and gets the traversability of all cells in the thread pool, which fills the dense footprint
+   * caches. Requires the map lock and the dense footprint caches.
+   * @param[out] isUntraversable if the cells are untraversable for the filters.
+   * @param[out] cellTraversability the traversability of the cells, see getCellTraversability.
+   */
+  void checkAllCells(BinaryMatrix& isUntraversable, grid_map::Matrix& cellTraversability);
+
+  /*!
+   * Same as isTraversable for a polygon, from the results of checkAllCells. Does not lock, such that it can run in
+   * the thread pool while the map lock is held.
+   * @param[in] polygon the footprint polygon.
+   * @param[in] isUntraversable if the cells are untraversable for the filters.
+   * @param[in] cellTraversability the traversability of the cells.
+   * @return the traversability of the footprint, 0 if it is not traversable.
+   */
+  double getPolygonTraversability(const grid_map::Polygon& polygon, const BinaryMatrix& isUntraversable,
+                                  const grid_map::Matrix& cellTraversability) const;
+
+  /*!
+   * Same as isTraversable for a circle, from the results of checkAllCells. Does not lock, such that it can run in
+   * the thread pool while the map lock is held.
+   * @param[in] center the center of the footprint, inside the map.
+   * @param[in] radiusMax the radius of the footprint.
+   * @param[in] radiusMin the radius within which the footprint has to be traversable.
+   * @param[in] isUntraversable if the cells are untraversable for the filters.
+   * @param[in] cellTraversability the traversability of the cells.
+   * @return the traversability of the footprint, 0 if it is not traversable.
+   */
+  double getCircleTraversability(const grid_map::Position& center, double radiusMax, double radiusMin, const BinaryMatrix& isUntraversable,
+                                 const grid_map::Matrix& cellTraversability) const;
+
+  /*!
+   * Gets the traversability of a cell, or the default traversability if it is not valid. Cells of traversable
+   * overrides are fully traversable. Requires the map lock.
+   * @param[in] index index of the cell.
+   * @return the traversability of the cell.
+   */
+  double getCellTraversability(const grid_map::Index& index) const;
+
+  /*!
+   * Copies the layers read by the filter checks into the tiled layout, or releases the copies if the tiled
+   * layout is not used. Requires the map lock.
+   */
+  void updateTiledLayers();
+
+  /*!
+   * Evicts the least recently used derived layers while the memory budget is exceeded, and updates the
+   * diagnostics. Evicted layers are rebuilt on demand. Must not be called while layer references are held.
+   */
+  void enforceMemoryBudget();
+
+  /*!
+   * Adds an evictable cache layer (filled with NAN) if it was evicted, and marks it as used. Requires the map lock.
+   * @param layer the name of the layer.
+   */
+  void ensureLayer(const std::string& layer);
+
+  /*!
+   * Ensures the footprint caches of the filter checks, call before checking cells. Requires the map lock.
+   */
+  void ensureFootprintLayers();
+
+  /*!
+   * Adds a footprint cache layer (filled with NAN) if the caches are dense and it was evicted, and marks it as
+   * used. Sparse caches are created on the first write. Requires the map lock.
+   * @param layer the name of the footprint layer.
+   */
+  void ensureFootprintCache(const std::string& layer);
+
+  /*!
+   * Gets the cached value of a cell from a footprint cache. Requires the map lock.
+   * @param layer the name of the footprint layer.
+   * @param index index of the cell.
+   * @return the cached value, NAN if the cell is not cached.
+   */
+  float getFootprintCache(const std::string& layer, const grid_map::Index& index);
+
+  /*!
+   * Caches the value of a cell in a footprint cache. Requires the map lock.
+   * @param layer the name of the footprint layer.
+   * @param index index of the cell.
+   * @param value the value to cache.
+   */
+  void setFootprintCache(const std::string& layer, const grid_map::Index& index, float value);
+
+  /*!
+   * Moves the sparse footprint caches into dense map layers, e.g. when most cells are queried. Requires the map lock.
+   */
+  void useDenseFootprintCaches();
+
+  /*!
+   * Reports the memory usage per layer in the diagnostics.
+   * @param[out] status the diagnostic status.
+   */
+  void produceMemoryDiagnostics(diagnostic_updater::DiagnosticStatusWrapper& status);
+
+  /*!
+   * Reports the load of the thread pool in the diagnostics.
+   * @param[out] status the diagnostic status.
+   */
+  void produceThreadPoolDiagnostics(diagnostic_updater::DiagnosticStatusWrapper& status);
+
+  /*!
+   * Gets the value of a layer read by the filter checks, from the tiled copy if it is valid. Requires the map lock.
+   * @param[in] tiledLayer the tiled copy of the layer.
+   * @param[in] layer the name of the layer.
+   * @param[in] index index of the cell.
+   * @return the value of the cell.
+   */
+  float getLayerValue(const TiledLayer& tiledLayer, const std::string& layer, const grid_map::Index& index) const {
+    return tiledLayersValid_ ? tiledLayer.at(index) : traversabilityMap_.at(layer, index);
+  }
+
   /*!
    * Checks the traversability of a circular footprint path and returns the traversability.
    * @param[in] path the footprint path that has to be checked.
@@ -302,6 +648,130 @@ class TraversabilityMap {
   bool checkPolygonalFootprintPath(const traversability_msgs::FootprintPath& path, const bool publishPolygons,
                                    traversability_msgs::TraversabilityResult& result);
 
+  /*!
+   * Computes the key of the footprint and check options of a path for the segment cache.
+   * @param path the footprint path.
+   * @return the footprint key.
+   */
+  uint64_t getFootprintKey(const traversability_msgs::FootprintPath& path) const;
+
+  /*!
+   * Swaps the filter layers and their footprint caches with the layers of a risk variant, calling it
+   * again restores the nominal layers. Layers without variant are shared. Requires the map lock.
+   * @param suffix the suffix of the layers of the risk variant.
+   * @return true if successful, false if the map has no traversability layer of the risk variant.
+   */
+  bool swapRiskVariantLayers(const std::string& suffix);
+
+  /*!
+   * Marks a segment of a footprint path as unsafe in the result and keeps track of the first unsafe segment.
+   * @param path the checked footprint path.
+   * @param segment index of the unsafe segment, i.e. of its start pose.
+   * @param result the result to update.
+   */
+  void setUnsafeSegment(const traversability_msgs::FootprintPath& path, const int segment,
+                        traversability_msgs::TraversabilityResult& result) const;
+
+  /*!
+   * Computes the radii of the largest circle inscribed in and the smallest circle circumscribing a
+   * footprint, both centered at the origin of the footprint frame.
+   * @param[in] footprint vertices of the footprint polygon in the robot base frame.
+   * @param[out] inscribedRadius radius of the inscribed circle, zero if the origin is outside of the footprint.
+   * @param[out] circumscribedRadius radius of the circumscribed circle.
+   */
+  void computeFootprintRadii(const std::vector<geometry_msgs::Point32>& footprint, double& inscribedRadius,
+                             double& circumscribedRadius) const;
+
+  /*!
+   * Renews the lease of a session and gets its snapshot. Requires the map lock.
+   * @param[in] session identifier of the session.
+   * @return the snapshot of the session, nullptr if the session is not open.
+   */
+  MapSessions::Snapshot* useSession(const unsigned int session);
+
+  /*!
+   * Removes expired sessions and the snapshots and retained maps no session reads anymore, together with
+   * their cached segments. Requires the map lock.
+   */
+  void expireSessions();
+
+  /*!
+   * Replaces the traversability map by a new generation, and retains the replaced map if a session reads it.
+   * Requires the map lock.
+   * @param[in] traversabilityMap the new traversability map, moved from. Must have the default start index.
+   */
+  void replaceTraversabilityMap(grid_map::GridMap& traversabilityMap);
+
+  /*!
+   * Makes sure that the clearance layer exists and is exact up to a distance. Requires the map lock.
+   * @param[in] distance the distance [m] up to which clearances are compared.
+   * @return true if successful.
+   */
+  bool ensureClearance(const double distance);
+
+  /*!
+   * Updates the clearance layer around changed cells, such that it is exact up to a distance there.
+   * Requires the map lock.
+   * @param[in] bounds the bounds of the changed cells.
+   * @param[in] distance the distance [m] up to which the updated clearances are exact.
+   */
+  void updateClearance(const Eigen::AlignedBox2d& bounds, const double distance);
+
+  /*!
+   * Invalidates the cached results and derived layers that depend on cells within bounds, i.e. cached
+   * segments and footprints reaching into the bounds, and updates the clearance around them. The cost-to-go
+   * layer is removed until the next map update.
+   * Requires the map lock.
+   * @param[in] bounds the bounds of the changed cells.
+   */
+  void invalidateRegion(const Eigen::AlignedBox2d& bounds);
+
+  /*!
+   * Invalidates the cached results and derived layers of each changed region of the overlay separately, such
+   * that distant regions do not invalidate the cells between them. Requires the map lock.
+   * @param[in] changedBounds the bounds of the changed regions.
+   */
+  void invalidateRegions(const MapOverlay::ChangedBounds& changedBounds);
+
+  /*!
+   * Removes expired overlay regions. Requires the map lock.
+   */
+  void updateOverlay();
+
+  //! Result of the check of a footprint with its inscribed and circumscribed circle.
+  enum class FootprintClearance { Free, Occupied, Undecided };
+
+  /*!
+   * Checks a footprint swept from a start to an end position with its inscribed and circumscribed circle on
+   * the clearance layer. The footprint is free if the circumscribed circle is clear along the whole segment,
+   * and occupied if the inscribed circle at the start or end position contains an untraversable cell.
+   * @param[in] start start position of the footprint origin.
+   * @param[in] end end position of the footprint origin.
+   * @param[in] inscribedRadius radius of the circle inscribed in the footprint.
+   * @param[in] circumscribedRadius radius of the circle circumscribing the footprint.
+   * @return free or occupied if decided by the circles, undecided if the footprint polygon needs to be checked.
+   */
+  FootprintClearance checkFootprintClearance(const grid_map::Position& start, const grid_map::Position& end, const double inscribedRadius,
+                                             const double circumscribedRadius);
+
+  /*!
+   * Computes the mean traversability within a polygon which is known to contain no untraversable cell.
+   * @param[in] polygon the polygon.
+   * @param[out] traversability the mean traversability.
+   * @return true if traversable, false only if the polygon is outside of the map and unknown regions are not traversable.
+   */
+  bool getMeanTraversability(const grid_map::Polygon& polygon, double& traversability);
+
+  /*!
+   * Transforms a footprint polygon from the robot base frame to the map frame.
+   * @param[in] footprint vertices of the footprint polygon in the robot base frame.
+   * @param[in] position position of the robot base in the map frame.
+   * @param[in] yaw yaw angle of the robot base in the map frame.
+   * @return the footprint polygon in the map frame.
+   */
+  grid_map::Polygon getFootprintPolygon(const std::vector<geometry_msgs::Point32>& footprint, const grid_map::Position& position,
+                                        const double& yaw) const;
+
   /*!
    * Computes mean height from poses.
    * @param[in] poses vector of poses to compute mean height.
@@ -338,21 +808,28 @@ class TraversabilityMap {
   //! Untraversable polygon publisher
   ros::Publisher untraversablePolygonPublisher_;
 
+  //! Publisher of the contour polygons of all untraversable regions.
+  ros::Publisher untraversablePolygonsPublisher_;
+
+  //! Publish the contour polygons of all untraversable regions after each update.
+  bool publishUntraversablePolygons_;
+
+  //! Maximum deviation [m] of the simplified contour polygons from the traced contours.
+  double untraversablePolygonsTolerance_;
+
   //! Vertices of the footprint polygon in base frame.
   std::vector<geometry_msgs::Point32> footprintPoints_;
 
   //! Robot parameter
-  double maxGapWidth_;
   double circularFootprintOffset_;  // TODO: get this with FootprintPath msg.
-  double criticalStepHeight_;
+
+  //! Parameters of the step, slope and roughness checks.
+  FilterChecks::Parameters filterCheckParameters_;
 
   //! Default value for traversability of unknown regions.
   double traversabilityDefault_;
   double traversabilityDefaultReadAtInit_;
 
-  //! Verify footprint for roughness.
-  bool checkForRoughness_;
-
   //! Verify overall robot inclination.
   bool checkRobotInclination_;
 
@@ -362,14 +839,69 @@ class TraversabilityMap {
   const std::string stepType_;
   const std::string roughnessType_;
   const std::string robotSlopeType_;
+  const std::string clearanceType_;
+  const std::string costToGoType_;
+  const std::string traversableComponentType_;
+
+  //! Compute the clearance layer after each update, otherwise it is computed on demand.
+  bool precomputeClearance_;
+
+  //! Read the layers of the filter checks from tiled copies.
+  bool useTiledLayers_;
+
+  //! Tiled copies of the layers read cell by cell by the filter checks, valid for the live map only. The slope and
+  //! roughness windows are read from the layers, whose columns the window kernel reads contiguously.
+  TiledLayer tiledTraversability_;
+  TiledLayer tiledStep_;
+  TiledLayer tiledElevation_;
+  bool tiledLayersValid_;
+
+  //! Radius of the circular footprint enclosing the robot.
+  double circularFootprintRadius_;
+
+  //! Check footprint polygons first with their inscribed and circumscribed circle on the clearance layer.
+  bool clearancePreCheck_;
+
+  //! If the layers of a risk variant are swapped in for the check of a path.
+  bool isRiskVariantActive_;
+
+  //! Radii of the circles inscribed in and circumscribing the footprint polygon.
+  double footprintInscribedRadius_;
+  double footprintCircumscribedRadius_;
+
+  //! Compute the cost-to-go layer from the robot position after each update.
+  bool computeCostToGo_;
+
+  //! Cost increase of untraversable cells with respect to fully traversable cells for the cost-to-go.
+  double costToGoTraversabilityWeight_;
+
+  //! Cost increase of untraversable cells with respect to fully traversable cells for the motion primitives.
+  double motionPrimitiveTraversabilityWeight_;
+
+  //! Label the traversable components after each update, and their labels.
+  bool computeTraversableComponents_;
+  TraversableComponents traversableComponents_;
+
+  //! Position of the robot belonging to this map.
+  grid_map::Position robotPosition_;
+  bool robotPositionInitialized_;
 
   //! Filter Chain
   filters::FilterChain<grid_map::GridMap> filter_chain_;
 
+  //! Statically composed filter pipeline, used instead of the filter chain if set.
+  struct StaticFilterPipeline;
+  std::unique_ptr<StaticFilterPipeline> staticFilterPipeline_;
+
+  //! Maps waiting to be published, shared with the publishing task.
+  struct PublishingQueue;
+  std::shared_ptr<PublishingQueue> publishingQueue_;
+
   //! Traversability map.
   grid_map::GridMap traversabilityMap_;
   std::vector<std::string> traversabilityMapLayers_;
   bool traversabilityMapInitialized_;
+  uint64_t mapGeneration_;
 
   //! Elevation map.
   grid_map::GridMap elevationMap_;
@@ -380,6 +912,51 @@ class TraversabilityMap {
   mutable boost::recursive_mutex traversabilityMapMutex_;
   mutable boost::recursive_mutex elevationMapMutex_;
 
+  //! Untraversable cells of the footprint path that is checked.
+  UntraversableCells untraversableCells_;
+
+  //! Registered motion primitive sets.
+  std::vector<MotionPrimitiveSet> motionPrimitiveSets_;
+
+  //! Sessions with their snapshots and the replaced maps they read.
+  MapSessions sessions_;
+
+  //! Swaps the state of a session snapshot in while a path of the session is checked.
+  class SnapshotScope;
+
+  //! Swaps the layers of a risk variant in while a path is checked.
+  class RiskVariantScope;
+
+  //! Regions applied on top of the traversability map.
+  MapOverlay overlay_;
+
+  //! Largest footprint radius checked so far, i.e. reach of cached footprints.
+  double maxFootprintRadius_;
+
+  //! Distance up to which the clearance layer is exact, larger values only mean larger than this distance.
+  double clearanceExactDistance_;
+
+  //! Results of checked path segments on the current map.
+  SegmentCache segmentCache_;
+
+  //! Memory accounting of the layers, with eviction of derived layers over budget.
+  MemoryBudget memoryBudget_;
+
+  //! If the tiled copies were evicted, they are rebuilt at the next footprint path check.
+  bool tiledLayersEvicted_;
+
+  //! Footprint caches, stored in map layers or sparsely.
+  FootprintCaches footprintCaches_;
+
+  //! Radius of the last checked circular footprint path, whose footprint cache is warmed, 0 if none.
+  double warmedFootprintRadius_;
+
+  //! Low priority thread which warms the footprint caches along the planned path.
+  CacheWarming cacheWarming_;
+
+  //! Diagnostics of the memory usage.
+  diagnostic_updater::Updater diagnosticUpdater_;
+
   //! Z-position of the robot pose belonging to this map.
   double zPosition_;
 };
@@ -0,0 +1,91 @@
+/*
+ * TraversableComponents.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+#include "traversability_estimation/ConnectedComponents.hpp"
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+
+// STD
+#include <string>
+
+namespace traversability_estimation {
+
+/*!
+ * Connected regions of the cells at which a circular footprint is traversable, i.e. whose clearance exceeds its
+ * radius. The labels are kept in a layer of the map and updated incrementally when cells change.
+ */
+class TraversableComponents {
+ public:
+  /*!
+   * Constructor.
+   * @param layer the name of the layer with the labels, NAN at the cells which are not traversable.
+   */
+  explicit TraversableComponents(const std::string& layer);
+
+  /*!
+   * Checks if the labels belong to the current map.
+   * @return true if the labels are valid.
+   */
+  bool isValid() const { return isValid_; }
+
+  /*!
+   * Marks the labels as outdated, e.g. when the map is replaced.
+   */
+  void invalidate() { isValid_ = false; }
+
+  /*!
+   * Labels the components of the whole map.
+   * @param map the map, whose label layer is written.
+   * @param clearanceLayer the name of the clearance layer.
+   * @param radius the radius of the footprint [m].
+   */
+  void compute(grid_map::GridMap& map, const std::string& clearanceLayer, double radius);
+
+  /*!
+   * Updates the labels after the cells within a block changed.
+   * @param map the map, whose label layer is written.
+   * @param clearanceLayer the name of the clearance layer.
+   * @param radius the radius of the footprint [m].
+   * @param startIndex the first cell of the changed block.
+   * @param size the size of the changed block.
+   */
+  void update(grid_map::GridMap& map, const std::string& clearanceLayer, double radius, const grid_map::Index& startIndex,
+              const grid_map::Size& size);
+
+  /*!
+   * Checks if two positions are in the same component. Takes constant time.
+   * @param[in] map the map.
+   * @param[in] positionA the first position.
+   * @param[in] positionB the second position.
+   * @param[out] isConnected true if both positions are in the same component.
+   * @return true if the check could be done, false if the labels are not valid.
+   */
+  bool areConnected(const grid_map::GridMap& map, const grid_map::Position& positionA, const grid_map::Position& positionB,
+                    bool& isConnected) const;
+
+ private:
+  /*!
+   * Writes the labels into their layer.
+   * @param map the map.
+   */
+  void setLayer(grid_map::GridMap& map) const;
+
+  //! Name of the layer with the labels.
+  const std::string layer_;
+
+  //! Labels of the cells.
+  ConnectedComponents components_;
+
+  //! If the labels belong to the current map.
+  bool isValid_;
+};
+
+}  // namespace traversability_estimation
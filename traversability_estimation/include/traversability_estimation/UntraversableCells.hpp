@@ -0,0 +1,85 @@
+/*
+ * UntraversableCells.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#pragma once
+
+// Grid Map
+#include <grid_map_core/GridMap.hpp>
+#include <grid_map_core/Polygon.hpp>
+
+// STD
+#include <vector>
+
+namespace traversability_estimation {
+
+/*!
+ * Accumulates the untraversable cells found while checking a footprint path. Every cell is stored once,
+ * and the storage is kept between paths, such that collecting the cells costs about as much as checking
+ * them. Polygons are only built on request, either as one convex hull or as one polygon per connected
+ * untraversable region.
+ */
+class UntraversableCells {
+ public:
+  /*!
+   * Removes all cells and prepares the storage for a map of the given size.
+   * @param[in] size size of the map the cells belong to.
+   */
+  void reset(const grid_map::Size& size);
+
+  /*!
+   * Adds an untraversable cell.
+   * @param[in] index index of the cell (the map must have a default start index).
+   */
+  void add(const grid_map::Index& index);
+
+  /*!
+   * Adds an untraversable region which is not covered by cells, e.g. outside of the map.
+   * @param[in] polygon the untraversable region.
+   */
+  void add(const grid_map::Polygon& polygon);
+
+  /*!
+   * Checks if no untraversable cell or region has been added.
+   * @return true if empty.
+   */
+  bool empty() const;
+
+  /*!
+   * Computes the convex hull of all untraversable cells and regions.
+   * @param[in] map the map the cells belong to.
+   * @return the convex hull, empty if no cells were added.
+   */
+  grid_map::Polygon getConvexHull(const grid_map::GridMap& map) const;
+
+  /*!
+   * Computes the outer boundary of each connected untraversable region, connecting cells that touch at
+   * a corner. Traversable holes within a region are not excluded.
+   * @param[in] map the map the cells belong to.
+   * @return one polygon per connected region.
+   */
+  std::vector<grid_map::Polygon> getComponents(const grid_map::GridMap& map) const;
+
+ private:
+  //! Size of the map the cells belong to.
+  grid_map::Size size_ = grid_map::Size::Zero();
+
+  //! Flags of the added cells, by linear index.
+  std::vector<bool> isAdded_;
+
+  //! Linear indices of the added cells.
+  std::vector<size_t> linearIndices_;
+
+  //! Bounding box of the added cells.
+  grid_map::Index minIndex_;
+  grid_map::Index maxIndex_;
+
+  //! Untraversable regions which are not covered by cells.
+  std::vector<grid_map::Polygon> polygons_;
+};
+
+}  // namespace traversability_estimation
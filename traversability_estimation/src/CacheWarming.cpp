@@ -0,0 +1,136 @@
+/*
+ * CacheWarming.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/CacheWarming.hpp"
+
+// Traversability estimation filters
+#include <filters/ThreadPool.hpp>
+
+// Grid Map
+#include <grid_map_core/iterators/CircleIterator.hpp>
+
+// ROS
+#include <ros/ros.h>
+
+// STD
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace traversability_estimation {
+
+namespace {
+
+//! Number of cells checked per lock of the map.
+constexpr size_t batchSize = 64;
+
+}  // namespace
+
+CacheWarming::CacheWarming()
+    : isEnabled_(false), corridorRadius_(0.5), nice_(19), nActiveQueries_(0), hasRequest_(false), isStopped_(false) {}
+
+CacheWarming::~CacheWarming() { stop(); }
+
+void CacheWarming::setParameters(const bool isEnabled, const double corridorRadius, const int nice) {
+  isEnabled_ = isEnabled;
+  corridorRadius_ = corridorRadius;
+  nice_ = nice;
+}
+
+void CacheWarming::start(PrepareFunction prepare, WarmFunction warm) {
+  if (!isEnabled_ || thread_.joinable()) return;
+  prepare_ = std::move(prepare);
+  warm_ = std::move(warm);
+  isStopped_ = false;
+  thread_ = std::thread(&CacheWarming::run, this);
+}
+
+void CacheWarming::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStopped_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+void CacheWarming::request(const std::vector<grid_map::Position>& corridor) {
+  if (!isEnabled_ || corridor.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    corridor_ = corridor;
+    hasRequest_ = true;
+  }
+  condition_.notify_one();
+}
+
+std::vector<grid_map::Index> CacheWarming::getCorridorCells(const grid_map::GridMap& geometry,
+                                                            const std::vector<grid_map::Position>& corridor, const double radius) {
+  std::vector<grid_map::Index> cells;
+  if (corridor.empty()) return cells;
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> isVisited =
+      Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>::Constant(geometry.getSize()(0), geometry.getSize()(1), false);
+  auto addCells = [&](const grid_map::Position& position) {
+    for (grid_map::CircleIterator iterator(geometry, position, radius); !iterator.isPastEnd(); ++iterator) {
+      const grid_map::Index& index = *iterator;
+      if (isVisited(index(0), index(1))) continue;
+      isVisited(index(0), index(1)) = true;
+      cells.push_back(index);
+    }
+  };
+  addCells(corridor.front());
+  for (size_t i = 1; i < corridor.size(); ++i) {
+    const grid_map::Position step = corridor[i] - corridor[i - 1];
+    const int nSteps = std::max(1, static_cast<int>(std::ceil(step.norm() / geometry.getResolution())));
+    for (int j = 1; j <= nSteps; ++j) addCells(corridor[i - 1] + step * (static_cast<double>(j) / nSteps));
+  }
+  return cells;
+}
+
+void CacheWarming::run() {
+  filters::configureCurrentThread(std::vector<int>(), 0, nice_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return hasRequest_ || isStopped_; });
+    if (isStopped_) return;
+    const std::vector<grid_map::Position> corridor = std::move(corridor_);
+    hasRequest_ = false;
+    lock.unlock();
+    warmCorridor(corridor);
+    lock.lock();
+  }
+}
+
+bool CacheWarming::isInterrupted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hasRequest_ || isStopped_;
+}
+
+void CacheWarming::warmCorridor(const std::vector<grid_map::Position>& corridor) {
+  const ros::WallTime start = ros::WallTime::now();
+  grid_map::GridMap geometry;
+  uint64_t generation;
+  if (!prepare_(geometry, generation)) return;
+  const std::vector<grid_map::Index> cells = getCorridorCells(geometry, corridor, corridorRadius_);
+
+  size_t nWarmedCells = 0;
+  std::vector<grid_map::Index> batch;
+  for (size_t begin = 0; begin < cells.size(); begin += batchSize) {
+    // Queries go first, they would otherwise wait for the lock.
+    while (nActiveQueries_ > 0 && !isInterrupted()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (isInterrupted()) break;
+    const size_t end = std::min(begin + batchSize, cells.size());
+    batch.assign(cells.begin() + begin, cells.begin() + end);
+    if (!warm_(batch, generation)) break;
+    nWarmedCells = end;
+  }
+  ROS_DEBUG("Traversability Map: Warmed the footprint caches of %zu of %zu corridor cells in %f s.", nWarmedCells, cells.size(),
+            (ros::WallTime::now() - start).toSec());
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,133 @@
+/*
+ * ConnectedComponents.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/ConnectedComponents.hpp"
+
+// Traversability estimation filters
+#include <filters/ThreadPool.hpp>
+
+// System
+#include <algorithm>
+
+namespace traversability_estimation {
+
+namespace {
+
+//! Number of columns labeled by one task, the components are merged across the borders of the strips.
+constexpr int columnsPerStrip = 16;
+
+//! Labels up to which the labels are exact as float layer values, the labels are compacted beyond.
+constexpr int maxLabel = 1 << 24;
+
+}  // namespace
+
+constexpr int ConnectedComponents::noLabel;
+
+ConnectedComponents::ConnectedComponents() : nextLabel_(0) {}
+
+void ConnectedComponents::compute(const BinaryMatrix& isFree) {
+  labels_.setConstant(isFree.rows(), isFree.cols(), noLabel);
+  nextLabel_ = label(isFree, 0);
+}
+
+void ConnectedComponents::update(const BinaryMatrix& isFree, const Eigen::Array2i& start, const Eigen::Array2i& size) {
+  if (isFree.rows() != labels_.rows() || isFree.cols() != labels_.cols() || nextLabel_ >= maxLabel) {
+    compute(isFree);
+    return;
+  }
+  // The components which touch the region or its border can merge or split.
+  const Eigen::Array2i mapSize(static_cast<int>(labels_.rows()), static_cast<int>(labels_.cols()));
+  const Eigen::Array2i borderStart = (start - 1).max(0);
+  const Eigen::Array2i borderEnd = (start + size + 1).min(mapSize);
+  if ((borderEnd <= borderStart).any()) return;
+  std::vector<bool> isAffected(nextLabel_, false);
+  for (int j = borderStart(1); j < borderEnd(1); ++j) {
+    for (int i = borderStart(0); i < borderEnd(0); ++i) {
+      if (labels_(i, j) != noLabel) isAffected[labels_(i, j)] = true;
+    }
+  }
+
+  // Cells of the affected components and the changed cells are labeled again.
+  BinaryMatrix mask(labels_.rows(), labels_.cols());
+  filters::ThreadPool::getInstance().parallelFor(0, mapSize(1), columnsPerStrip, [&](const int columnBegin, const int columnEnd) {
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < mapSize(0); ++i) {
+        const bool isChanged = i >= start(0) && i < start(0) + size(0) && j >= start(1) && j < start(1) + size(1);
+        const bool isInAffectedComponent = labels_(i, j) != noLabel && isAffected[labels_(i, j)];
+        if (isChanged || isInAffectedComponent) labels_(i, j) = noLabel;
+        mask(i, j) = (isChanged || isInAffectedComponent) && isFree(i, j);
+      }
+    }
+  });
+  nextLabel_ += label(mask, nextLabel_);
+}
+
+int ConnectedComponents::label(const BinaryMatrix& mask, const int firstLabel) {
+  const int rows = static_cast<int>(mask.rows());
+  const int cols = static_cast<int>(mask.cols());
+  parent_.resize(static_cast<size_t>(rows) * cols);
+
+  // Within a strip, the trees only contain cells of the strip, such that the strips are independent.
+  filters::ThreadPool::getInstance().parallelFor(0, cols, columnsPerStrip, [&](const int columnBegin, const int columnEnd) {
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < rows; ++i) {
+        const int cell = i + j * rows;
+        parent_[cell] = cell;
+        if (!mask(i, j)) continue;
+        if (i > 0 && mask(i - 1, j)) unite(cell, cell - 1);
+        if (j > columnBegin) {
+          for (int k = std::max(i - 1, 0); k <= std::min(i + 1, rows - 1); ++k) {
+            if (mask(k, j - 1)) unite(cell, k + (j - 1) * rows);
+          }
+        }
+      }
+    }
+  });
+
+  // Merge the components across the borders of the strips.
+  for (int j = columnsPerStrip; j < cols; j += columnsPerStrip) {
+    for (int i = 0; i < rows; ++i) {
+      if (!mask(i, j)) continue;
+      for (int k = std::max(i - 1, 0); k <= std::min(i + 1, rows - 1); ++k) {
+        if (mask(k, j - 1)) unite(i + j * rows, k + (j - 1) * rows);
+      }
+    }
+  }
+
+  // The roots are the first cells of their components, such that they are labeled before their other cells.
+  int nLabels = 0;
+  for (int j = 0; j < cols; ++j) {
+    for (int i = 0; i < rows; ++i) {
+      if (!mask(i, j)) continue;
+      const int cell = i + j * rows;
+      const int root = find(cell);
+      labels_(i, j) = root == cell ? firstLabel + nLabels++ : labels_(root % rows, root / rows);
+    }
+  }
+  return nLabels;
+}
+
+int ConnectedComponents::find(int cell) {
+  while (parent_[cell] != cell) {
+    parent_[cell] = parent_[parent_[cell]];
+    cell = parent_[cell];
+  }
+  return cell;
+}
+
+void ConnectedComponents::unite(const int cellA, const int cellB) {
+  const int rootA = find(cellA);
+  const int rootB = find(cellB);
+  if (rootA < rootB) {
+    parent_[rootB] = rootA;
+  } else if (rootB < rootA) {
+    parent_[rootA] = rootB;
+  }
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,120 @@
+/*
+ * ContourExtraction.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/ContourExtraction.hpp"
+
+// System
+#include <cmath>
+
+namespace traversability_estimation {
+
+namespace {
+
+/*!
+ * Recursively marks the vertices between first and last that are kept by the Douglas-Peucker algorithm.
+ */
+void simplifyPolyline(const Contour& contour, const size_t first, const size_t last, const double tolerance, std::vector<bool>& keep) {
+  if (last <= first + 1) return;
+  const Eigen::Vector2d& start = contour[first];
+  const Eigen::Vector2d segment = contour[last % contour.size()] - start;
+  const double segmentLength = segment.norm();
+  double maxDistance = -1.0;
+  size_t farthest = first;
+  for (size_t i = first + 1; i < last; ++i) {
+    const Eigen::Vector2d toVertex = contour[i] - start;
+    const double distance = segmentLength > 0.0 ? std::abs(segment.x() * toVertex.y() - segment.y() * toVertex.x()) / segmentLength
+                                                : toVertex.norm();
+    if (distance > maxDistance) {
+      maxDistance = distance;
+      farthest = i;
+    }
+  }
+  if (maxDistance <= tolerance) return;
+  keep[farthest] = true;
+  simplifyPolyline(contour, first, farthest, tolerance, keep);
+  simplifyPolyline(contour, farthest, last, tolerance, keep);
+}
+
+}  // namespace
+
+void extractContours(const BinaryMatrix& mask, std::vector<Contour>& contours) {
+  contours.clear();
+  // Pad the mask with unset cells, such that all contours are closed.
+  const int rows = static_cast<int>(mask.rows()) + 2;
+  const int cols = static_cast<int>(mask.cols()) + 2;
+  BinaryMatrix padded = BinaryMatrix::Constant(rows, cols, false);
+  padded.block(1, 1, mask.rows(), mask.cols()) = mask;
+
+  // Every edge between two samples gets an id. Horizontal edges connect (row, col) and (row, col + 1),
+  // vertical edges connect (row, col) and (row + 1, col).
+  const int nHorizontalEdges = rows * cols;
+  const auto horizontalEdge = [cols](const int row, const int col) { return row * cols + col; };
+  const auto verticalEdge = [cols, nHorizontalEdges](const int row, const int col) { return nHorizontalEdges + row * cols + col; };
+  const auto edgeVertex = [cols, nHorizontalEdges](const int edge) {
+    if (edge < nHorizontalEdges) return Eigen::Vector2d(edge / cols - 1.0, edge % cols - 0.5);
+    const int verticalEdge = edge - nHorizontalEdges;
+    return Eigen::Vector2d(verticalEdge / cols - 0.5, verticalEdge % cols - 1.0);
+  };
+
+  // Link the crossed edges of each square in clockwise order of its corners (top left, top right, bottom right,
+  // bottom left). A contour segment starts at each edge going from a set to an unset corner and ends at the next
+  // crossed edge, which resolves saddles such that diagonal set cells are connected.
+  std::vector<int> next(2 * rows * cols, -1);
+  for (int row = 0; row + 1 < rows; ++row) {
+    for (int col = 0; col + 1 < cols; ++col) {
+      const bool corners[4] = {padded(row, col), padded(row, col + 1), padded(row + 1, col + 1), padded(row + 1, col)};
+      const int edges[4] = {horizontalEdge(row, col), verticalEdge(row, col + 1), horizontalEdge(row + 1, col), verticalEdge(row, col)};
+      for (int k = 0; k < 4; ++k) {
+        if (!corners[k] || corners[(k + 1) % 4]) continue;
+        for (int l = 1; l < 4; ++l) {
+          const int nextEdge = (k + l) % 4;
+          if (corners[nextEdge] != corners[(nextEdge + 1) % 4]) {
+            next[edges[k]] = edges[nextEdge];
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // Follow the links to closed contours.
+  for (size_t edge = 0; edge < next.size(); ++edge) {
+    if (next[edge] < 0) continue;
+    Contour contour;
+    int current = static_cast<int>(edge);
+    while (next[current] >= 0) {
+      contour.push_back(edgeVertex(current));
+      const int following = next[current];
+      next[current] = -1;
+      current = following;
+    }
+    contours.push_back(contour);
+  }
+}
+
+Contour simplifyContour(const Contour& contour, const double tolerance) {
+  if (contour.size() <= 3) return contour;
+  // Split the closed contour at the vertex farthest from the first one.
+  size_t farthest = 0;
+  for (size_t i = 1; i < contour.size(); ++i) {
+    if ((contour[i] - contour[0]).squaredNorm() > (contour[farthest] - contour[0]).squaredNorm()) farthest = i;
+  }
+  std::vector<bool> keep(contour.size(), false);
+  keep[0] = true;
+  keep[farthest] = true;
+  simplifyPolyline(contour, 0, farthest, tolerance, keep);
+  simplifyPolyline(contour, farthest, contour.size(), tolerance, keep);
+
+  Contour simplified;
+  for (size_t i = 0; i < contour.size(); ++i) {
+    if (keep[i]) simplified.push_back(contour[i]);
+  }
+  return simplified;
+}
+
+}  // namespace traversability_estimation
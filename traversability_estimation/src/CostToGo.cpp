@@ -0,0 +1,75 @@
+/*
+ * CostToGo.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/CostToGo.hpp"
+
+// System
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace traversability_estimation {
+
+void computeCostToGo(const BinaryMatrix& isFree, const Eigen::MatrixXf& traversability, const Eigen::Array2i& start,
+                     const double resolution, const double traversabilityWeight, Eigen::MatrixXf& cost) {
+  const int rows = static_cast<int>(isFree.rows());
+  const int cols = static_cast<int>(isFree.cols());
+  cost.setConstant(rows, cols, std::numeric_limits<float>::infinity());
+  if (start(0) < 0 || start(0) >= rows || start(1) < 0 || start(1) >= cols) {
+    cost.setConstant(NAN);
+    return;
+  }
+
+  // Neighbors in 8-connectivity with their distance in cells.
+  const int neighborRows[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+  const int neighborCols[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+  const double neighborDistance[8] = {1.0, 1.0, 1.0, 1.0, M_SQRT2, M_SQRT2, M_SQRT2, M_SQRT2};
+
+  // Circular bucket queue of (cost, linear index), the bucket width is the cost of the cheapest edge.
+  const double bucketWidth = resolution;
+  const double maxEdgeCost = M_SQRT2 * resolution * (1.0 + traversabilityWeight);
+  const size_t nBuckets = static_cast<size_t>(std::ceil(maxEdgeCost / bucketWidth)) + 1;
+  std::vector<std::vector<std::pair<float, int>>> buckets(nBuckets);
+  size_t nQueued = 0;
+
+  const auto push = [&](const int row, const int col, const double value) {
+    cost(row, col) = static_cast<float>(value);
+    buckets[static_cast<size_t>(value / bucketWidth) % nBuckets].emplace_back(static_cast<float>(value), row + col * rows);
+    nQueued++;
+  };
+
+  push(start(0), start(1), 0.0);
+  std::vector<std::pair<float, int>> current;
+  for (size_t bucket = 0; nQueued > 0; bucket = (bucket + 1) % nBuckets) {
+    current.swap(buckets[bucket]);
+    nQueued -= current.size();
+    for (const auto& entry : current) {
+      const int row = entry.second % rows;
+      const int col = entry.second / rows;
+      if (entry.first > cost(row, col)) continue;  // Outdated entry.
+      for (int i = 0; i < 8; ++i) {
+        const int neighborRow = row + neighborRows[i];
+        const int neighborCol = col + neighborCols[i];
+        if (neighborRow < 0 || neighborRow >= rows || neighborCol < 0 || neighborCol >= cols) continue;
+        if (!isFree(neighborRow, neighborCol)) continue;
+        // Do not cut corners of untraversable cells.
+        if (i >= 4 && (!isFree(neighborRow, col) || !isFree(row, neighborCol))) continue;
+        const double meanTraversability = 0.5 * (traversability(row, col) + traversability(neighborRow, neighborCol));
+        const double edgeCost = neighborDistance[i] * resolution * (1.0 + traversabilityWeight * (1.0 - meanTraversability));
+        const double neighborCost = entry.first + edgeCost;
+        if (neighborCost < cost(neighborRow, neighborCol)) push(neighborRow, neighborCol, neighborCost);
+      }
+    }
+    current.clear();
+  }
+
+  cost = cost.unaryExpr([](float value) { return std::isinf(value) ? NAN : value; });
+}
+
+}  // namespace traversability_estimation
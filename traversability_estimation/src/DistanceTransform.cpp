@@ -0,0 +1,93 @@
+/*
+ * DistanceTransform.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/DistanceTransform.hpp"
+
+// System
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace traversability_estimation {
+
+namespace {
+
+// Value of the squared distance of non-seed cells, large enough to never be the minimum, small enough to avoid overflows.
+constexpr double unreachedSquaredDistance = 1e20;
+
+/*!
+ * One-dimensional squared distance transform of a sampled function.
+ * @param[in] f sampled function values.
+ * @param[out] d squared distance transform of f.
+ * @param[in] n number of samples.
+ * @param v buffer for the locations of the parabolas in the lower envelope (size n).
+ * @param z buffer for the boundaries between the parabolas (size n + 1).
+ */
+void distanceTransform1d(const double* f, double* d, const int n, int* v, double* z) {
+  int k = 0;
+  v[0] = 0;
+  z[0] = -std::numeric_limits<double>::infinity();
+  z[1] = std::numeric_limits<double>::infinity();
+  for (int q = 1; q < n; ++q) {
+    double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+    while (s <= z[k]) {
+      --k;
+      s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < q) ++k;
+    d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+  }
+}
+
+}  // namespace
+
+void computeDistanceTransform(const BinaryMatrix& isSeed, const float maxDistance, Eigen::MatrixXf& distance) {
+  const int rows = static_cast<int>(isSeed.rows());
+  const int cols = static_cast<int>(isSeed.cols());
+  distance.resize(rows, cols);
+  if (rows == 0 || cols == 0) return;
+  if (!isSeed.any()) {
+    distance.setConstant(maxDistance);
+    return;
+  }
+
+  Eigen::MatrixXd squaredDistance(rows, cols);
+  const int n = std::max(rows, cols);
+  std::vector<double> f(n), d(n), z(n + 1);
+  std::vector<int> v(n);
+
+  // First pass along the columns (contiguous in memory).
+  for (int col = 0; col < cols; ++col) {
+    for (int row = 0; row < rows; ++row) {
+      f[row] = isSeed(row, col) ? 0.0 : unreachedSquaredDistance;
+    }
+    distanceTransform1d(f.data(), squaredDistance.col(col).data(), rows, v.data(), z.data());
+  }
+
+  // Second pass along the rows.
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      f[col] = squaredDistance(row, col);
+    }
+    distanceTransform1d(f.data(), d.data(), cols, v.data(), z.data());
+    for (int col = 0; col < cols; ++col) {
+      distance(row, col) = std::min(static_cast<float>(std::sqrt(d[col])), maxDistance);
+    }
+  }
+}
+
+}  // namespace traversability_estimation
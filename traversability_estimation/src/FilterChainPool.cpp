@@ -0,0 +1,104 @@
+/*
+ * FilterChainPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/FilterChainPool.hpp"
+
+// STD
+#include <algorithm>
+
+namespace traversability_estimation {
+
+FilterChainPool::FilterChainPool() : generation_(0), nWorkers_(1), nBusyWorkers_(0) {}
+
+void FilterChainPool::configure(const XmlRpc::XmlRpcValue& config, const size_t nWorkers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  generation_++;
+  idleChains_.clear();
+  nWorkers_ = std::max<size_t>(nWorkers, 1);
+  workerReleased_.notify_all();
+}
+
+bool FilterChainPool::update(const grid_map::GridMap& elevationMap, grid_map::GridMap& traversabilityMap, const Overrides& overrides,
+                             std::string& error) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  workerReleased_.wait(lock, [this]() { return nBusyWorkers_ < nWorkers_; });
+  nBusyWorkers_++;
+  const uint64_t generation = generation_;
+  XmlRpc::XmlRpcValue config = config_;
+  std::unique_ptr<Chain> chain;
+  if (overrides.empty() && !idleChains_.empty()) {
+    chain = std::move(idleChains_.back());
+    idleChains_.pop_back();
+  }
+  lock.unlock();
+
+  bool isSuccess = true;
+  if (!chain) {
+    isSuccess = applyOverrides(config, overrides, error);
+    if (isSuccess) {
+      chain = createChain(config);
+      isSuccess = static_cast<bool>(chain);
+      if (!isSuccess) error = "Could not configure the filter chain.";
+    }
+  }
+  if (isSuccess) {
+    // The filters may modify their input.
+    grid_map::GridMap elevationMapCopy = elevationMap;
+    isSuccess = chain->update(elevationMapCopy, traversabilityMap);
+    if (!isSuccess) error = "Could not update the filter chain.";
+  }
+
+  lock.lock();
+  nBusyWorkers_--;
+  if (chain && overrides.empty() && generation == generation_) idleChains_.push_back(std::move(chain));
+  lock.unlock();
+  workerReleased_.notify_one();
+  return isSuccess;
+}
+
+bool FilterChainPool::applyOverrides(XmlRpc::XmlRpcValue& config, const Overrides& overrides, std::string& error) {
+  if (overrides.empty()) return true;
+  if (config.getType() != XmlRpc::XmlRpcValue::TypeArray) {
+    error = "The filter chain configuration is not a list of filters.";
+    return false;
+  }
+  for (const auto& parameterOverride : overrides) {
+    const size_t separator = parameterOverride.first.find('/');
+    if (separator == std::string::npos) {
+      error = "Parameter override '" + parameterOverride.first + "' is not of the form 'filter_name/parameter'.";
+      return false;
+    }
+    const std::string filterName = parameterOverride.first.substr(0, separator);
+    const std::string parameter = parameterOverride.first.substr(separator + 1);
+    int index = 0;
+    while (index < config.size() && static_cast<std::string>(config[index]["name"]) != filterName) index++;
+    if (index == config.size()) {
+      error = "There is no filter '" + filterName + "'.";
+      return false;
+    }
+    XmlRpc::XmlRpcValue& params = config[index]["params"];
+    const auto type = params.hasMember(parameter) ? params[parameter].getType() : XmlRpc::XmlRpcValue::TypeDouble;
+    if (type == XmlRpc::XmlRpcValue::TypeInt) {
+      params[parameter] = static_cast<int>(parameterOverride.second);
+    } else if (type == XmlRpc::XmlRpcValue::TypeBoolean) {
+      params[parameter] = parameterOverride.second != 0.0;
+    } else {
+      params[parameter] = parameterOverride.second;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<FilterChainPool::Chain> FilterChainPool::createChain(XmlRpc::XmlRpcValue& config) {
+  std::unique_ptr<Chain> chain(new Chain("grid_map::GridMap"));
+  if (!chain->configure(config, "traversability_map_filters")) return nullptr;
+  return chain;
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,212 @@
+/*
+ * FilterChecks.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/FilterChecks.hpp"
+
+// Grid Map
+#include <grid_map_core/grid_map_core.hpp>
+
+// ROS
+#include <ros/ros.h>
+
+// STD
+#include <cmath>
+#include <vector>
+
+namespace traversability_estimation {
+
+FilterChecks::FilterChecks(const Parameters& parameters, grid_map::GridMap& map, const MapOverlay& overlay)
+    : parameters_(parameters),
+      map_(map),
+      overlay_(overlay),
+      tiledStep_(nullptr),
+      tiledElevation_(nullptr),
+      sparseFootprintCaches_(nullptr),
+      areFootprintCachesReadOnly_(false) {}
+
+void FilterChecks::setTiledLayers(const TiledLayer& step, const TiledLayer& elevation) {
+  tiledStep_ = &step;
+  tiledElevation_ = &elevation;
+}
+
+void FilterChecks::setSparseFootprintCaches(std::map<std::string, SparseCellCache>& sparseFootprintCaches, const bool isReadOnly) {
+  sparseFootprintCaches_ = &sparseFootprintCaches;
+  areFootprintCachesReadOnly_ = isReadOnly;
+}
+
+float FilterChecks::getFootprintCache(const std::string& layer, const grid_map::Index& index) const {
+  if (sparseFootprintCaches_ == nullptr) return map_.at(layer, index);
+  const auto sparseFootprintCache = sparseFootprintCaches_->find(layer);
+  if (sparseFootprintCache == sparseFootprintCaches_->end()) return NAN;
+  return sparseFootprintCache->second.get(static_cast<uint32_t>(index(0) + index(1) * map_.getSize()(0)));
+}
+
+void FilterChecks::setFootprintCache(const std::string& layer, const grid_map::Index& index, const float value) {
+  if (sparseFootprintCaches_ == nullptr) {
+    map_.at(layer, index) = value;
+  } else if (!areFootprintCachesReadOnly_) {
+    (*sparseFootprintCaches_)[layer].set(static_cast<uint32_t>(index(0) + index(1) * map_.getSize()(0)), value);
+  }
+}
+
+bool FilterChecks::check(const grid_map::Index& indexStep) {
+  const MapOverlay::State state = overlay_.getState(indexStep);
+  if (state == MapOverlay::State::Untraversable) return false;
+  if (state == MapOverlay::State::Traversable) return true;
+  bool currentPositionIsTraversale = true;
+  if (checkForSlope(indexStep)) {
+    if (checkForStep(indexStep)) {
+      if (parameters_.checkForRoughness) {
+        if (!checkForRoughness(indexStep)) {
+          currentPositionIsTraversale = false;
+        }
+      }
+    } else {
+      currentPositionIsTraversale = false;
+    }
+  } else {
+    currentPositionIsTraversale = false;
+  }
+
+  return currentPositionIsTraversale;
+}
+
+bool FilterChecks::checkForStep(const grid_map::Index& indexStep) {
+  if (getLayerValue(tiledStep_, parameters_.stepType, indexStep) == 0.0) {
+    const float cachedStep = getFootprintCache("step_footprint", indexStep);
+    if (!std::isfinite(cachedStep)) {
+      double windowRadiusStep = 2.5 * map_.getResolution();  // 0.075;
+
+      std::vector<grid_map::Index> indices;
+      grid_map::Position center;
+      map_.getPosition(indexStep, center);
+      double height = getLayerValue(tiledElevation_, "elevation", indexStep);
+      for (grid_map::CircleIterator circleIterator(map_, center, windowRadiusStep); !circleIterator.isPastEnd();
+           ++circleIterator) {
+        if (getLayerValue(tiledElevation_, "elevation", *circleIterator) > parameters_.criticalStepHeight + height &&
+            getLayerValue(tiledStep_, parameters_.stepType, *circleIterator) == 0.0)
+          indices.push_back(*circleIterator);
+      }
+      if (indices.empty()) indices.push_back(indexStep);
+      for (auto& index : indices) {
+        grid_map::Length subMapLength(2.5 * map_.getResolution(), 2.5 * map_.getResolution());
+        grid_map::Position subMapPos;
+        bool isSuccess;
+        map_.getPosition(index, subMapPos);
+        grid_map::Vector toCenter = center - subMapPos;
+        grid_map::GridMap subMap = map_.getSubmap(subMapPos, subMapLength, isSuccess);
+        if (!isSuccess) {
+          ROS_WARN("Traversability map: Check for step window could not retrieve submap.");
+          setFootprintCache("step_footprint", indexStep, 0.0);
+          return false;
+        }
+        height = getLayerValue(tiledElevation_, "elevation", index);
+        for (grid_map::GridMapIterator subMapIterator(subMap); !subMapIterator.isPastEnd(); ++subMapIterator) {
+          if (subMap.at(parameters_.stepType, *subMapIterator) == 0.0 && subMap.at("elevation", *subMapIterator) < height - parameters_.criticalStepHeight) {
+            grid_map::Position pos;
+            subMap.getPosition(*subMapIterator, pos);
+            grid_map::Vector vec = pos - subMapPos;
+            if (vec.norm() < 0.025) continue;
+            if (toCenter.norm() > 0.025) {
+              if (toCenter.dot(vec) < 0.0) continue;
+            }
+            pos = subMapPos + vec;
+            while ((pos - subMapPos + vec).norm() < parameters_.maxGapWidth && map_.isInside(pos + vec)) pos += vec;
+            grid_map::Index endIndex;
+            map_.getIndex(pos, endIndex);
+            bool gapStart = false;
+            bool gapEnd = false;
+            for (grid_map::LineIterator lineIterator(map_, index, endIndex); !lineIterator.isPastEnd(); ++lineIterator) {
+              const float lineHeight = getLayerValue(tiledElevation_, "elevation", *lineIterator);
+              if (lineHeight > height + parameters_.criticalStepHeight) {
+                setFootprintCache("step_footprint", indexStep, 0.0);
+                return false;
+              }
+              if (lineHeight < height - parameters_.criticalStepHeight || !std::isfinite(lineHeight)) {
+                gapStart = true;
+              } else if (gapStart) {
+                gapEnd = true;
+                break;
+              }
+            }
+            if (gapStart && !gapEnd) {
+              setFootprintCache("step_footprint", indexStep, 0.0);
+              return false;
+            }
+          }
+        }
+      }
+      setFootprintCache("step_footprint", indexStep, 1.0);
+    } else if (cachedStep == 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FilterChecks::checkForSlope(const grid_map::Index& index) {
+  if (map_.at(parameters_.slopeType, index) == 0.0) {
+    const float cachedSlope = getFootprintCache("slope_footprint", index);
+    if (!std::isfinite(cachedSlope)) {
+      double windowRadius = parameters_.windowKernel.radius * map_.getResolution();  // TODO: read this as a parameter?
+      double criticalLength = parameters_.maxGapWidth / 3.0;
+      int nSlopesCritical = floor(2 * windowRadius * criticalLength / pow(map_.getResolution(), 2));
+
+      if (countUntraversableCells(parameters_.slopeType, index) > nSlopesCritical) {
+        setFootprintCache("slope_footprint", index, 0.0);
+        return false;
+      }
+      setFootprintCache("slope_footprint", index, 1.0);
+    } else if (cachedSlope == 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FilterChecks::checkForRoughness(const grid_map::Index& index) {
+  if (map_.at(parameters_.roughnessType, index) == 0.0) {
+    const float cachedRoughness = getFootprintCache("roughness_footprint", index);
+    if (!std::isfinite(cachedRoughness)) {
+      double windowRadius = parameters_.windowKernel.radius * map_.getResolution();  // TODO: read this as a parameter?
+      double criticalLength = parameters_.maxGapWidth / 3.0;
+      int nRoughnessCritical = floor(1.5 * windowRadius * criticalLength / pow(map_.getResolution(), 2));
+
+      if (countUntraversableCells(parameters_.roughnessType, index) > nRoughnessCritical) {
+        setFootprintCache("roughness_footprint", index, 0.0);
+        return false;
+      }
+      setFootprintCache("roughness_footprint", index, 1.0);
+    } else if (cachedRoughness == 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int FilterChecks::countUntraversableCells(const std::string& layer, const grid_map::Index& index) {
+  const int radius = parameters_.windowKernel.radius;
+  const grid_map::Matrix& data = map_[layer];
+  int nCells = 0;
+  if ((index >= radius).all() && (index < map_.getSize() - radius).all()) {
+    parameters_.windowKernel.apply(data, index(0), index(1),
+                                   [&nCells](const bool isInside, const float value) { nCells += isInside && value == 0.0f; });
+    return nCells;
+  }
+  // The window is clipped at the map border.
+  grid_map::Position center;
+  map_.getPosition(index, center);
+  for (grid_map::CircleIterator circleIterator(map_, center, radius * map_.getResolution()); !circleIterator.isPastEnd();
+       ++circleIterator) {
+    const grid_map::Index cell(*circleIterator);
+    if (data(cell(0), cell(1)) == 0.0) nCells++;
+  }
+  return nCells;
+}
+
+}  // namespace traversability_estimation
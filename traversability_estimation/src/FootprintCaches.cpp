@@ -0,0 +1,109 @@
+/*
+ * FootprintCaches.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/FootprintCaches.hpp"
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace traversability_estimation {
+
+const std::array<std::string, 4> FootprintCaches::layers{{"traversability_footprint", "step_footprint", "slope_footprint", "roughness_footprint"}};
+
+FootprintCaches::FootprintCaches() : backend_(Backend::Auto), sparseDensity_(0.05), isSparse_(false) {}
+
+void FootprintCaches::setBackend(const Backend backend, const double sparseDensity) {
+  backend_ = backend;
+  sparseDensity_ = sparseDensity;
+}
+
+bool FootprintCaches::shouldUseSparse(const grid_map::GridMap& map) const {
+  return backend_ == Backend::Sparse || (backend_ == Backend::Auto && getDensity(map) < sparseDensity_);
+}
+
+bool FootprintCaches::shouldUseDense(const grid_map::GridMap& map) const {
+  return isSparse_ && backend_ == Backend::Auto && getDensity(map) > 2.0 * sparseDensity_;
+}
+
+void FootprintCaches::reset(grid_map::GridMap& map, const bool isSparse, const std::vector<std::string>& denseLayers) {
+  sparseCaches_.clear();
+  isSparse_ = isSparse;
+  if (isSparse_) {
+    for (const auto& layer : layers) {
+      if (map.exists(layer)) map.erase(layer);
+    }
+  } else {
+    for (const auto& layer : denseLayers) map.add(layer);
+  }
+}
+
+void FootprintCaches::ensure(grid_map::GridMap& map, const std::string& layer) const {
+  if (!isSparse_ && !map.exists(layer)) map.add(layer);
+}
+
+double FootprintCaches::getDensity(const grid_map::GridMap& map) const {
+  const auto nCells = map.getSize().prod();
+  if (nCells == 0) return 0.0;
+  size_t nCachedCells = 0;
+  for (const auto& layer : layers) {
+    if (isSparse_) {
+      const auto sparseCache = sparseCaches_.find(layer);
+      if (sparseCache != sparseCaches_.end()) nCachedCells = std::max(nCachedCells, sparseCache->second.size());
+    } else if (map.exists(layer)) {
+      const grid_map::Matrix& data = map[layer];
+      nCachedCells = std::max(nCachedCells, static_cast<size_t>((data.array() == data.array()).count()));
+    }
+  }
+  return static_cast<double>(nCachedCells) / nCells;
+}
+
+void FootprintCaches::useDense(grid_map::GridMap& map) {
+  if (!isSparse_) return;
+  const auto rows = static_cast<uint32_t>(map.getSize()(0));
+  for (const auto& sparseCache : sparseCaches_) {
+    map.add(sparseCache.first);
+    grid_map::Matrix& data = map[sparseCache.first];
+    sparseCache.second.forEach([&](const uint32_t key, const float value) { data(key % rows, key / rows) = value; });
+  }
+  sparseCaches_.clear();
+  isSparse_ = false;
+}
+
+void FootprintCaches::swapSparseCaches(std::map<std::string, SparseCellCache>& sparseCaches, const bool isSparse) {
+  std::swap(sparseCaches_, sparseCaches);
+  isSparse_ = isSparse;
+}
+
+void FootprintCaches::swapSparseCaches(const std::string& layer, const std::string& otherLayer) {
+  if (isSparse_) std::swap(sparseCaches_[layer], sparseCaches_[otherLayer]);
+}
+
+void FootprintCaches::clear(grid_map::GridMap& map, const std::string& layer) {
+  if (map.exists(layer)) map.clear(layer);
+  const auto sparseCache = sparseCaches_.find(layer);
+  if (sparseCache != sparseCaches_.end()) sparseCache->second.clear();
+}
+
+void FootprintCaches::clearBlock(grid_map::GridMap& map, const std::string& layer, const grid_map::Index& startIndex,
+                                 const grid_map::Size& size) {
+  if (map.exists(layer)) map[layer].block(startIndex(0), startIndex(1), size(0), size(1)).setConstant(NAN);
+  const auto sparseCache = sparseCaches_.find(layer);
+  if (sparseCache != sparseCaches_.end()) {
+    sparseCache->second.eraseBlock(startIndex(0), startIndex(1), size(0), size(1), map.getSize()(0));
+  }
+}
+
+void FootprintCaches::eraseSparseCache(const std::string& layer) { sparseCaches_.erase(layer); }
+
+void FootprintCaches::addMemoryUsage(std::map<std::string, size_t>& usage) const {
+  for (const auto& sparseCache : sparseCaches_) usage[sparseCache.first] += sparseCache.second.getMemorySize();
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,59 @@
+/*
+ * LatencyStatistics.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/LatencyStatistics.hpp"
+
+// ROS
+#include <ros/console.h>
+
+// STD
+#include <algorithm>
+#include <cmath>
+
+namespace traversability_estimation {
+
+LatencyStatistics::LatencyStatistics(const std::string& name, const size_t windowSize) : name_(name), windowSize_(windowSize) {
+  samples_.reserve(windowSize_);
+}
+
+void LatencyStatistics::setWindowSize(const size_t windowSize) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  windowSize_ = windowSize;
+  samples_.clear();
+  samples_.reserve(windowSize_);
+}
+
+void LatencyStatistics::add(const double latency) {
+  std::vector<double> window;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (windowSize_ == 0) return;
+    samples_.push_back(latency);
+    if (samples_.size() < windowSize_) return;
+    window.swap(samples_);
+    samples_.reserve(windowSize_);
+  }
+
+  // Report outside of the lock, the percentiles reorder the window.
+  const double p50 = computePercentile(window, 50.0);
+  const double p99 = computePercentile(window, 99.0);
+  const double p999 = computePercentile(window, 99.9);
+  const double max = *std::max_element(window.begin(), window.end());
+  ROS_INFO("%s latency over %zu requests: p50 %.3f ms, p99 %.3f ms, p99.9 %.3f ms, max %.3f ms.", name_.c_str(), window.size(),
+           1e3 * p50, 1e3 * p99, 1e3 * p999, 1e3 * max);
+}
+
+double LatencyStatistics::computePercentile(std::vector<double>& samples, const double percentile) {
+  if (samples.empty()) return 0.0;
+  const double rank = std::ceil(percentile / 100.0 * static_cast<double>(samples.size()));
+  const size_t index = std::min(samples.size() - 1, static_cast<size_t>(std::max(rank, 1.0)) - 1);
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+}  // namespace traversability_estimation
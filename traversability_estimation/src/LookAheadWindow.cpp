@@ -0,0 +1,126 @@
+/*
+ * LookAheadWindow.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/LookAheadWindow.hpp"
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace traversability_estimation {
+
+LookAheadWindow::LookAheadWindow() : area_(25.0), timeHorizon_(2.0), margin_(0.5), minLength_(1.0), hasPreviousWindow_(false) {}
+
+void LookAheadWindow::setParameters(const double area, const double timeHorizon, const double margin, const double minLength) {
+  area_ = area;
+  timeHorizon_ = timeHorizon;
+  margin_ = margin;
+  // The window with the minimal side length still has to fit into the area.
+  minLength_ = std::min(minLength, std::sqrt(area));
+  reset();
+}
+
+void LookAheadWindow::reset() { hasPreviousWindow_ = false; }
+
+void LookAheadWindow::update(const grid_map::Position& robotPosition, const Eigen::Vector2d& velocity,
+                             const std::vector<grid_map::Position>& path, const double resolution, grid_map::Position& center,
+                             grid_map::Length& length) {
+  const std::vector<grid_map::Position> lookAheadPoints = getLookAheadPoints(robotPosition, velocity, path);
+
+  // Bounding box of the robot and the look-ahead points with margin.
+  grid_map::Position minCorner = robotPosition;
+  grid_map::Position maxCorner = robotPosition;
+  for (const auto& point : lookAheadPoints) {
+    minCorner = minCorner.cwiseMin(point);
+    maxCorner = maxCorner.cwiseMax(point);
+  }
+  minCorner.array() -= margin_;
+  maxCorner.array() += margin_;
+
+  // Scale the box to the area, keeping its aspect ratio within the minimal side length.
+  length = (maxCorner - minCorner).cwiseMax(minLength_);
+  length *= std::sqrt(area_ / length.prod());
+  for (int i = 0; i < 2; i++) {
+    if (length(i) < minLength_) {
+      length(i) = minLength_;
+      length(1 - i) = area_ / minLength_;
+    }
+  }
+
+  // The window grows and is cut at the far end along the axes the robot is heading, i.e. it starts behind
+  // the robot at the margin, and symmetrically along the others.
+  const grid_map::Position heading = 0.5 * (minCorner + maxCorner) - robotPosition;
+  for (int i = 0; i < 2; i++) {
+    if (heading(i) > margin_) {
+      center(i) = minCorner(i) + 0.5 * length(i);
+    } else if (heading(i) < -margin_) {
+      center(i) = maxCorner(i) - 0.5 * length(i);
+    } else {
+      center(i) = 0.5 * (minCorner(i) + maxCorner(i));
+      const double maxOffset = std::max(0.5 * length(i) - margin_, 0.0);
+      center(i) = std::min(std::max(center(i), robotPosition(i) - maxOffset), robotPosition(i) + maxOffset);
+    }
+  }
+
+  // Align the window to the cells such that consecutive maps share them.
+  if (resolution > 0.0) {
+    center = (center / resolution).array().round() * resolution;
+    length = (length / resolution).array().floor() * resolution;
+  }
+
+  // Keep the previous window while it covers the robot and the look-ahead points of the new window.
+  const bool isPreviousWindowValid =
+      hasPreviousWindow_ && covers(previousCenter_, previousLength_, robotPosition) &&
+      std::all_of(lookAheadPoints.begin(), lookAheadPoints.end(), [&](const grid_map::Position& point) {
+        return !covers(center, length, point) || covers(previousCenter_, previousLength_, point);
+      });
+  if (isPreviousWindowValid) {
+    center = previousCenter_;
+    length = previousLength_;
+    return;
+  }
+  previousCenter_ = center;
+  previousLength_ = length;
+  hasPreviousWindow_ = true;
+}
+
+std::vector<grid_map::Position> LookAheadWindow::getLookAheadPoints(const grid_map::Position& robotPosition,
+                                                                    const Eigen::Vector2d& velocity,
+                                                                    const std::vector<grid_map::Position>& path) const {
+  std::vector<grid_map::Position> points;
+  const double lookAheadDistance = velocity.norm() * timeHorizon_;
+  if (lookAheadDistance > margin_) points.emplace_back(robotPosition + velocity * timeHorizon_);
+  if (path.empty()) return points;
+
+  // Follow the path from its pose closest to the robot, at least over half the side length of a square window.
+  size_t closestIndex = 0;
+  double closestDistance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < path.size(); i++) {
+    const double distance = (path[i] - robotPosition).norm();
+    if (distance < closestDistance) {
+      closestDistance = distance;
+      closestIndex = i;
+    }
+  }
+  const double maxPathLength = std::max(lookAheadDistance, 0.5 * std::sqrt(area_));
+  double pathLength = 0.0;
+  points.push_back(path[closestIndex]);
+  for (size_t i = closestIndex + 1; i < path.size(); i++) {
+    pathLength += (path[i] - path[i - 1]).norm();
+    if (pathLength > maxPathLength) break;
+    points.push_back(path[i]);
+  }
+  return points;
+}
+
+bool LookAheadWindow::covers(const grid_map::Position& center, const grid_map::Length& length, const grid_map::Position& point) const {
+  return ((point - center).cwiseAbs().array() + margin_ <= 0.5 * length.array()).all();
+}
+
+}  // namespace traversability_estimation
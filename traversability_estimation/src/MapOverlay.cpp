@@ -0,0 +1,175 @@
+/*
+ * MapOverlay.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MapOverlay.hpp"
+
+// System
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace traversability_estimation {
+
+MapOverlay::MapOverlay() : version_(0) {}
+
+MapOverlay::Region MapOverlay::createRegion(const std::vector<geometry_msgs::Point32>& points, const State state, const ros::Time& expiry) {
+  Region region;
+  for (const auto& point : points) region.polygon.addVertex(grid_map::Position(point.x, point.y));
+  region.state = state;
+  region.expiry = expiry;
+  return region;
+}
+
+void MapOverlay::setGeometry(const grid_map::GridMap& map) {
+  const grid_map::Size size = map.getSize();
+  states_.setConstant(size(0), size(1), static_cast<uint8_t>(State::None));
+  Eigen::AlignedBox2d bounds;
+  for (const auto& region : dynamicObstacles_) bounds.extend(getBounds(region.polygon));
+  for (const auto& entry : overrides_) bounds.extend(getBounds(entry.second.polygon));
+  if (!bounds.isEmpty()) rasterize(map, bounds);
+}
+
+MapOverlay::ChangedBounds MapOverlay::setDynamicObstacles(const std::vector<Region>& obstacles, const grid_map::GridMap& map) {
+  // Obstacles which are in both lists keep their cells, each old obstacle matches at most one new one.
+  std::vector<bool> isUnchanged(obstacles.size(), false);
+  ChangedBounds changedBounds;
+  for (const auto& region : dynamicObstacles_) {
+    bool isMatched = false;
+    for (size_t i = 0; i < obstacles.size() && !isMatched; ++i) {
+      if (isUnchanged[i] || !isSameRegion(region, obstacles[i])) continue;
+      isUnchanged[i] = true;
+      isMatched = true;
+    }
+    if (!isMatched) addBounds(changedBounds, getBounds(region.polygon));
+  }
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    if (!isUnchanged[i]) addBounds(changedBounds, getBounds(obstacles[i].polygon));
+  }
+  dynamicObstacles_ = obstacles;
+  return applyChange(map, changedBounds);
+}
+
+MapOverlay::ChangedBounds MapOverlay::setOverride(const std::string& id, const Region& region, const grid_map::GridMap& map) {
+  ChangedBounds changedBounds;
+  const auto overrideIterator = overrides_.find(id);
+  if (overrideIterator != overrides_.end()) {
+    // A new lifetime of the same region does not change the cells.
+    const bool isUnchanged = isSameRegion(overrideIterator->second, region);
+    if (!isUnchanged) addBounds(changedBounds, getBounds(overrideIterator->second.polygon));
+    overrideIterator->second = region;
+    if (isUnchanged) return changedBounds;
+  }
+  addBounds(changedBounds, getBounds(region.polygon));
+  overrides_[id] = region;
+  return applyChange(map, changedBounds);
+}
+
+MapOverlay::ChangedBounds MapOverlay::removeOverride(const std::string& id, const grid_map::GridMap& map) {
+  ChangedBounds changedBounds;
+  const auto overrideIterator = overrides_.find(id);
+  if (overrideIterator == overrides_.end()) return changedBounds;
+  addBounds(changedBounds, getBounds(overrideIterator->second.polygon));
+  overrides_.erase(overrideIterator);
+  return applyChange(map, changedBounds);
+}
+
+MapOverlay::ChangedBounds MapOverlay::clearOverrides(const grid_map::GridMap& map) {
+  ChangedBounds changedBounds;
+  for (const auto& entry : overrides_) addBounds(changedBounds, getBounds(entry.second.polygon));
+  overrides_.clear();
+  return applyChange(map, changedBounds);
+}
+
+MapOverlay::ChangedBounds MapOverlay::removeExpired(const ros::Time& time, const grid_map::GridMap& map) {
+  ChangedBounds changedBounds;
+  auto isExpired = [&](const Region& region) {
+    if (region.expiry.isZero() || region.expiry > time) return false;
+    addBounds(changedBounds, getBounds(region.polygon));
+    return true;
+  };
+  dynamicObstacles_.erase(std::remove_if(dynamicObstacles_.begin(), dynamicObstacles_.end(), isExpired), dynamicObstacles_.end());
+  for (auto overrideIterator = overrides_.begin(); overrideIterator != overrides_.end();) {
+    overrideIterator = isExpired(overrideIterator->second) ? overrides_.erase(overrideIterator) : std::next(overrideIterator);
+  }
+  return applyChange(map, changedBounds);
+}
+
+void MapOverlay::rasterize(const grid_map::GridMap& map, const Eigen::AlignedBox2d& bounds) {
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  if (!getIndexRange(map, bounds, startIndex, size)) return;
+  states_.block(startIndex(0), startIndex(1), size(0), size(1)).setConstant(static_cast<uint8_t>(State::None));
+
+  const grid_map::Index endIndex = startIndex + size;
+  auto rasterizeRegion = [&](const Region& region) {
+    if (!bounds.intersects(getBounds(region.polygon))) return;
+    for (grid_map::PolygonIterator iterator(map, region.polygon); !iterator.isPastEnd(); ++iterator) {
+      const grid_map::Index index(*iterator);
+      if ((index < startIndex).any() || (index >= endIndex).any()) continue;
+      uint8_t& state = states_(index(0), index(1));
+      state = std::max(state, static_cast<uint8_t>(region.state));
+    }
+  };
+  for (const auto& region : dynamicObstacles_) rasterizeRegion(region);
+  for (const auto& entry : overrides_) rasterizeRegion(entry.second);
+}
+
+const MapOverlay::ChangedBounds& MapOverlay::applyChange(const grid_map::GridMap& map, const ChangedBounds& changedBounds) {
+  if (changedBounds.empty()) return changedBounds;
+  if (states_.size() != 0) {
+    for (const auto& bounds : changedBounds) rasterize(map, bounds);
+  }
+  ++version_;
+  return changedBounds;
+}
+
+void MapOverlay::addBounds(ChangedBounds& changedBounds, Eigen::AlignedBox2d bounds) {
+  if (bounds.isEmpty()) return;
+  // Overlapping bounds are merged, which can make the merged bounds overlap others.
+  for (auto iterator = changedBounds.begin(); iterator != changedBounds.end();) {
+    if (iterator->intersects(bounds)) {
+      bounds.extend(*iterator);
+      changedBounds.erase(iterator);
+      iterator = changedBounds.begin();
+    } else {
+      ++iterator;
+    }
+  }
+  changedBounds.push_back(bounds);
+}
+
+bool MapOverlay::isSameRegion(const Region& regionA, const Region& regionB) {
+  if (regionA.state != regionB.state) return false;
+  const std::vector<grid_map::Position>& verticesA = regionA.polygon.getVertices();
+  const std::vector<grid_map::Position>& verticesB = regionB.polygon.getVertices();
+  return verticesA.size() == verticesB.size() && std::equal(verticesA.begin(), verticesA.end(), verticesB.begin());
+}
+
+Eigen::AlignedBox2d getBounds(const grid_map::Polygon& polygon) {
+  Eigen::AlignedBox2d bounds;
+  for (const auto& vertex : polygon.getVertices()) bounds.extend(vertex);
+  return bounds;
+}
+
+bool getIndexRange(const grid_map::GridMap& map, const Eigen::AlignedBox2d& bounds, grid_map::Index& startIndex, grid_map::Size& size) {
+  if (bounds.isEmpty()) return false;
+  // The index increases with decreasing position, starting at the cell with the largest coordinates.
+  grid_map::Position firstCell;
+  map.getPosition(grid_map::Index(0, 0), firstCell);
+  const double resolution = map.getResolution();
+  const grid_map::Size mapSize = map.getSize();
+  grid_map::Index endIndex;
+  for (int i = 0; i < 2; ++i) {
+    startIndex(i) = std::max(static_cast<int>(std::ceil((firstCell(i) - bounds.max()(i)) / resolution)), 0);
+    endIndex(i) = std::min(static_cast<int>(std::floor((firstCell(i) - bounds.min()(i)) / resolution)), mapSize(i) - 1);
+  }
+  size = endIndex - startIndex + 1;
+  return (size > 0).all();
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,109 @@
+/*
+ * MapSessions.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MapSessions.hpp"
+
+// ROS
+#include <ros/ros.h>
+
+// System
+#include <algorithm>
+#include <limits>
+
+namespace traversability_estimation {
+
+MapSessions::MapSessions() : lastSession_(0), lastSnapshot_(0), defaultTimeout_(1.0), maxTimeout_(10.0) {}
+
+void MapSessions::setTimeouts(const double defaultTimeout, const double maxTimeout) {
+  defaultTimeout_ = defaultTimeout;
+  maxTimeout_ = maxTimeout;
+}
+
+unsigned int MapSessions::open(const double timeout, const uint64_t generation, const uint64_t overlayVersion,
+                               const MapOverlay& overlay) {
+  if (++lastSession_ == 0) ++lastSession_;
+  Session& session = sessions_[lastSession_];
+  const auto snapshot = std::find_if(snapshots_.begin(), snapshots_.end(), [&](const std::pair<const uint64_t, Snapshot>& snapshot) {
+    return snapshot.second.generation == generation && snapshot.second.overlayVersion == overlayVersion;
+  });
+  if (snapshot != snapshots_.end()) {
+    session.snapshot = snapshot->first;
+  } else {
+    session.snapshot = ++lastSnapshot_;
+    Snapshot& newSnapshot = snapshots_[session.snapshot];
+    newSnapshot.id = session.snapshot;
+    newSnapshot.generation = generation;
+    newSnapshot.overlayVersion = overlayVersion;
+    newSnapshot.overlay = overlay;
+    newSnapshot.clearanceExactDistance = std::numeric_limits<double>::infinity();
+  }
+  session.timeout = timeout > 0.0 ? std::min(timeout, maxTimeout_) : defaultTimeout_;
+  session.expiry = ros::WallTime::now() + ros::WallDuration(session.timeout);
+  return lastSession_;
+}
+
+bool MapSessions::close(const unsigned int session) { return sessions_.erase(session) > 0; }
+
+MapSessions::Snapshot* MapSessions::use(const unsigned int session) {
+  const auto iterator = sessions_.find(session);
+  if (iterator == sessions_.end() || iterator->second.expiry < ros::WallTime::now()) return nullptr;
+  iterator->second.expiry = ros::WallTime::now() + ros::WallDuration(iterator->second.timeout);
+  return &snapshots_.at(iterator->second.snapshot);
+}
+
+void MapSessions::expire(std::vector<std::pair<uint64_t, uint64_t>>& removedSnapshots) {
+  removedSnapshots.clear();
+  const ros::WallTime now = ros::WallTime::now();
+  for (auto iterator = sessions_.begin(); iterator != sessions_.end();) {
+    if (iterator->second.expiry < now) {
+      ROS_DEBUG("Traversability Estimation: Session %u has expired.", iterator->first);
+      iterator = sessions_.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+  for (auto iterator = snapshots_.begin(); iterator != snapshots_.end();) {
+    const uint64_t id = iterator->first;
+    if (std::none_of(sessions_.begin(), sessions_.end(),
+                     [id](const std::pair<const unsigned int, Session>& session) { return session.second.snapshot == id; })) {
+      removedSnapshots.emplace_back(iterator->second.generation, id);
+      iterator = snapshots_.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+  for (auto iterator = retainedMaps_.begin(); iterator != retainedMaps_.end();) {
+    if (!isPinned(iterator->first)) {
+      iterator = retainedMaps_.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+}
+
+bool MapSessions::isPinned(const uint64_t generation) const {
+  return std::any_of(snapshots_.begin(), snapshots_.end(), [generation](const std::pair<const uint64_t, Snapshot>& snapshot) {
+    return snapshot.second.generation == generation;
+  });
+}
+
+void MapSessions::retain(const uint64_t generation, grid_map::GridMap& map) { retainedMaps_[generation] = std::move(map); }
+
+size_t MapSessions::getMemorySize() const {
+  size_t size = 0;
+  for (const auto& retainedMap : retainedMaps_) {
+    for (const auto& layer : retainedMap.second.getLayers()) size += static_cast<size_t>(retainedMap.second[layer].size()) * sizeof(float);
+  }
+  for (const auto& snapshot : snapshots_) {
+    size += static_cast<size_t>(snapshot.second.clearance.size()) * sizeof(float);
+    for (const auto& sparseFootprintCache : snapshot.second.sparseFootprintCaches) size += sparseFootprintCache.second.getMemorySize();
+  }
+  return size;
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,82 @@
+/*
+ * MemoryBudget.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MemoryBudget.hpp"
+#include "traversability_estimation/common.h"
+
+// ROS
+#include <ros/ros.h>
+
+// STD
+#include <algorithm>
+#include <utility>
+
+namespace traversability_estimation {
+
+MemoryBudget::MemoryBudget() : budget_(0), clock_(0) {}
+
+void MemoryBudget::setBudget(const size_t budget) { budget_ = budget; }
+
+void MemoryBudget::setEvictable(const std::string& layer) { evictableLayers_.insert(layer); }
+
+bool MemoryBudget::isEvictable(const std::string& layer) const { return evictableLayers_.count(layer) > 0; }
+
+void MemoryBudget::touch(const std::string& layer) { lastUse_[layer] = ++clock_; }
+
+std::vector<std::string> MemoryBudget::getLayersToEvict(const std::map<std::string, size_t>& usage) const {
+  std::vector<std::string> layersToEvict;
+  size_t total = getTotal(usage);
+  if (budget_ == 0 || total <= budget_) return layersToEvict;
+
+  // Layers which were never used are evicted first.
+  std::vector<std::pair<uint64_t, std::string>> candidates;
+  for (const auto& layer : usage) {
+    if (layer.second == 0 || !isEvictable(layer.first)) continue;
+    const auto lastUse = lastUse_.find(layer.first);
+    candidates.emplace_back(lastUse == lastUse_.end() ? 0 : lastUse->second, layer.first);
+  }
+  std::sort(candidates.begin(), candidates.end());
+  for (const auto& candidate : candidates) {
+    if (total <= budget_) break;
+    layersToEvict.push_back(candidate.second);
+    total -= usage.at(candidate.second);
+  }
+  return layersToEvict;
+}
+
+bool MemoryBudget::enforce(std::map<std::string, size_t>& usage, const std::function<void(const std::string&)>& evict) const {
+  for (const auto& layer : getLayersToEvict(usage)) {
+    ROS_DEBUG("Memory budget: Evicting layer '%s' (%zu bytes).", layer.c_str(), usage[layer]);
+    evict(layer);
+    usage.erase(layer);
+  }
+  const size_t total = getTotal(usage);
+  if (budget_ == 0 || total <= budget_) return true;
+  ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Memory budget: %.1f MB in use exceed the memory budget of %.1f MB.", total * 1e-6,
+                    budget_ * 1e-6);
+  return false;
+}
+
+void MemoryBudget::produceDiagnostics(const std::map<std::string, size_t>& usage, diagnostic_updater::DiagnosticStatusWrapper& status) const {
+  const size_t total = getTotal(usage);
+  if (budget_ > 0 && total > budget_) {
+    status.summaryf(diagnostic_msgs::DiagnosticStatus::WARN, "%.1f MB in use, over the budget of %.1f MB.", total * 1e-6, budget_ * 1e-6);
+  } else {
+    status.summaryf(diagnostic_msgs::DiagnosticStatus::OK, "%.1f MB in use.", total * 1e-6);
+  }
+  status.add("budget [bytes]", budget_);
+  for (const auto& layer : usage) status.add(layer.first + (isEvictable(layer.first) ? " (evictable) [bytes]" : " [bytes]"), layer.second);
+}
+
+size_t MemoryBudget::getTotal(const std::map<std::string, size_t>& usage) {
+  size_t total = 0;
+  for (const auto& layer : usage) total += layer.second;
+  return total;
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,113 @@
+/*
+ * MotionPrimitiveSet.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MotionPrimitiveSet.hpp"
+
+// Eigen
+#include <Eigen/Geometry>
+
+// System
+#include <algorithm>
+#include <cmath>
+
+namespace traversability_estimation {
+
+MotionPrimitiveSet::MotionPrimitiveSet(const std::vector<std::vector<geometry_msgs::Pose2D>>& primitives,
+                                       const std::vector<grid_map::Position>& footprint, const double radius,
+                                       const unsigned int nHeadingBins)
+    : primitives_(primitives), footprint_(footprint), radius_(radius), nHeadingBins_(std::max(nHeadingBins, 1u)), resolution_(0.0) {
+  for (const auto& primitive : primitives_) {
+    double length = 0.0;
+    for (size_t i = 1; i < primitive.size(); ++i) {
+      length += std::hypot(primitive[i].x - primitive[i - 1].x, primitive[i].y - primitive[i - 1].y);
+    }
+    lengths_.push_back(length);
+  }
+}
+
+void MotionPrimitiveSet::computeSweptCells(const double resolution) {
+  resolution_ = resolution;
+  sweptCells_.assign(primitives_.size(), std::vector<std::vector<grid_map::Index>>(nHeadingBins_));
+
+  for (size_t primitive = 0; primitive < primitives_.size(); ++primitive) {
+    for (unsigned int headingBin = 0; headingBin < nHeadingBins_; ++headingBin) {
+      // Poses of the primitive for a start pose at the origin with the heading of the bin.
+      const double startYaw = 2.0 * M_PI * headingBin / nHeadingBins_;
+      const Eigen::Rotation2Dd startRotation(startYaw);
+      std::vector<geometry_msgs::Pose2D> poses;
+      for (const auto& relativePose : primitives_[primitive]) {
+        const grid_map::Position position = startRotation * grid_map::Position(relativePose.x, relativePose.y);
+        geometry_msgs::Pose2D pose;
+        pose.x = position.x();
+        pose.y = position.y();
+        pose.theta = startYaw + relativePose.theta;
+        poses.push_back(pose);
+      }
+      if (poses.empty()) continue;
+
+      // Polygons swept between consecutive poses.
+      std::vector<grid_map::Polygon> polygons;
+      grid_map::Polygon previousFootprint = getFootprintPolygon(poses[0]);
+      if (poses.size() == 1) polygons.push_back(previousFootprint);
+      for (size_t i = 1; i < poses.size(); ++i) {
+        grid_map::Polygon footprint = getFootprintPolygon(poses[i]);
+        polygons.push_back(grid_map::Polygon::convexHull(previousFootprint, footprint));
+        previousFootprint = footprint;
+      }
+
+      // Rasterize the polygons on a map centered at the start cell.
+      double maxDistance = 0.0;
+      for (const auto& polygon : polygons) {
+        for (const auto& vertex : polygon.getVertices()) maxDistance = std::max(maxDistance, vertex.cwiseAbs().maxCoeff());
+      }
+      const int halfSize = static_cast<int>(std::ceil(maxDistance / resolution)) + 1;
+      grid_map::GridMap map;
+      map.setGeometry(grid_map::Length::Constant((2 * halfSize + 1) * resolution), resolution);
+      map.add("swept", 0.0);
+      grid_map::Index startIndex;
+      map.getIndex(grid_map::Position::Zero(), startIndex);
+      auto& swept = map["swept"];
+      std::vector<grid_map::Index>& sweptCells = sweptCells_[primitive][headingBin];
+      for (const auto& polygon : polygons) {
+        for (grid_map::PolygonIterator iterator(map, polygon); !iterator.isPastEnd(); ++iterator) {
+          const grid_map::Index index(*iterator);
+          if (swept(index(0), index(1)) != 0.0) continue;
+          swept(index(0), index(1)) = 1.0;
+          sweptCells.push_back(index - startIndex);
+        }
+      }
+    }
+  }
+}
+
+double MotionPrimitiveSet::getResolution() const { return resolution_; }
+
+size_t MotionPrimitiveSet::getNumberOfPrimitives() const { return primitives_.size(); }
+
+unsigned int MotionPrimitiveSet::getHeadingBin(const double yaw) const {
+  const int headingBin = static_cast<int>(std::lround(yaw / (2.0 * M_PI) * nHeadingBins_)) % static_cast<int>(nHeadingBins_);
+  return static_cast<unsigned int>(headingBin < 0 ? headingBin + nHeadingBins_ : headingBin);
+}
+
+const std::vector<grid_map::Index>& MotionPrimitiveSet::getSweptCells(const size_t primitive, const unsigned int headingBin) const {
+  return sweptCells_[primitive][headingBin];
+}
+
+double MotionPrimitiveSet::getLength(const size_t primitive) const { return lengths_[primitive]; }
+
+grid_map::Polygon MotionPrimitiveSet::getFootprintPolygon(const geometry_msgs::Pose2D& pose) const {
+  if (footprint_.empty()) return grid_map::Polygon::fromCircle(grid_map::Position(pose.x, pose.y), radius_);
+  grid_map::Polygon polygon;
+  const Eigen::Rotation2Dd rotation(pose.theta);
+  for (const auto& vertex : footprint_) {
+    polygon.addVertex(grid_map::Position(pose.x, pose.y) + rotation * vertex);
+  }
+  return polygon;
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,160 @@
+/*
+ * PointCloudRasterizer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/PointCloudRasterizer.hpp"
+#include "traversability_estimation/common.h"
+
+// Traversability estimation filters
+#include <filters/ThreadPool.hpp>
+
+// STD
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace traversability_estimation {
+
+PointCloudRasterizer::PointCloudRasterizer()
+    : map_({"elevation", "upper_bound", "lower_bound", "variance", "time"}),
+      zPosition_(0.0),
+      isInitialized_(false),
+      reduction_(Reduction::Max),
+      temporalWeight_(0.5) {}
+
+void PointCloudRasterizer::setGeometry(const grid_map::Length& length, const double resolution, const std::string& frameId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  map_.setGeometry(length, resolution);
+  map_.setFrameId(frameId);
+  map_.clearAll();
+  isInitialized_ = false;
+}
+
+void PointCloudRasterizer::setReduction(const Reduction reduction) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reduction_ = reduction;
+}
+
+void PointCloudRasterizer::setTemporalWeight(const double weight) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  temporalWeight_ = std::min(std::max(weight, std::numeric_limits<double>::epsilon()), 1.0);
+}
+
+void PointCloudRasterizer::move(const grid_map::Position3& center) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  map_.move(center.head<2>());
+  zPosition_ = center.z();
+}
+
+bool PointCloudRasterizer::addPointCloud(const sensor_msgs::PointCloud2& cloud, const Eigen::Affine3f& transform) {
+  // Byte offsets of the coordinates within a point.
+  std::array<uint32_t, 3> offsets;
+  const std::array<std::string, 3> coordinates{{"x", "y", "z"}};
+  for (size_t k = 0; k < coordinates.size(); ++k) {
+    const auto field = std::find_if(cloud.fields.begin(), cloud.fields.end(),
+                                    [&](const sensor_msgs::PointField& field) { return field.name == coordinates[k]; });
+    if (field == cloud.fields.end() || field->datatype != sensor_msgs::PointField::FLOAT32) {
+      ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Point cloud rasterizer: The point cloud has no float field '%s'.", coordinates[k].c_str());
+      return false;
+    }
+    offsets[k] = field->offset;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const grid_map::Size size = map_.getSize();
+  const int nPoints = static_cast<int>(cloud.width * cloud.height);
+  const int pointsPerTask = 4096;
+
+  // Transform the points and find their cells (linear buffer index, -1 if outside of the map).
+  std::vector<int> cells(nPoints);
+  std::vector<float> heights(nPoints);
+  filters::ThreadPool::getInstance().parallelFor(0, nPoints, pointsPerTask, [&](const int begin, const int end) {
+    for (int i = begin; i < end; ++i) {
+      const uint8_t* data = &cloud.data[(i / cloud.width) * cloud.row_step + (i % cloud.width) * cloud.point_step];
+      Eigen::Vector3f point;
+      for (int k = 0; k < 3; ++k) std::memcpy(&point(k), data + offsets[k], sizeof(float));
+      cells[i] = -1;
+      if (!point.allFinite()) continue;
+      point = transform * point;
+      grid_map::Index index;
+      if (!map_.getIndex(point.head<2>().cast<double>(), index)) continue;
+      cells[i] = index(0) + index(1) * size(0);
+      heights[i] = point.z();
+    }
+  });
+
+  // Sort the heights by cell (counting sort), such that the cells can be reduced independently.
+  std::vector<int> cellBegin(size.prod() + 1, 0);
+  for (const int cell : cells) {
+    if (cell >= 0) cellBegin[cell + 1]++;
+  }
+  std::partial_sum(cellBegin.begin(), cellBegin.end(), cellBegin.begin());
+  std::vector<float> sortedHeights(cellBegin.back());
+  std::vector<int> nextPoint(cellBegin.begin(), cellBegin.end() - 1);
+  for (int i = 0; i < nPoints; ++i) {
+    if (cells[i] >= 0) sortedHeights[nextPoint[cells[i]]++] = heights[i];
+  }
+
+  // Reduce the heights of each cell and merge them into the map.
+  grid_map::Matrix& elevation = map_["elevation"];
+  grid_map::Matrix& upperBound = map_["upper_bound"];
+  grid_map::Matrix& lowerBound = map_["lower_bound"];
+  grid_map::Matrix& variance = map_["variance"];
+  grid_map::Matrix& time = map_["time"];
+  const float weight = static_cast<float>(temporalWeight_);
+  if (!isInitialized_) initialStamp_ = cloud.header.stamp;
+  const float stamp = static_cast<float>((cloud.header.stamp - initialStamp_).toSec());
+  filters::ThreadPool::getInstance().parallelFor(0, size(1), 16, [&](const int columnBegin, const int columnEnd) {
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        const int cell = i + j * size(0);
+        const int nCellPoints = cellBegin[cell + 1] - cellBegin[cell];
+        if (nCellPoints == 0) continue;
+        float minimum = std::numeric_limits<float>::infinity();
+        float maximum = -std::numeric_limits<float>::infinity();
+        float sum = 0.0f, sumOfSquares = 0.0f;
+        for (int k = cellBegin[cell]; k < cellBegin[cell + 1]; ++k) {
+          minimum = std::min(minimum, sortedHeights[k]);
+          maximum = std::max(maximum, sortedHeights[k]);
+          sum += sortedHeights[k];
+          sumOfSquares += sortedHeights[k] * sortedHeights[k];
+        }
+        const float mean = sum / nCellPoints;
+        const float cloudVariance = std::max(sumOfSquares / nCellPoints - mean * mean, 0.0f);
+        const float height = reduction_ == Reduction::Max ? maximum : mean;
+        if (std::isfinite(elevation(i, j))) {
+          elevation(i, j) += weight * (height - elevation(i, j));
+          variance(i, j) += weight * (cloudVariance - variance(i, j));
+        } else {
+          elevation(i, j) = height;
+          variance(i, j) = cloudVariance;
+        }
+        upperBound(i, j) = std::max(maximum, elevation(i, j));
+        lowerBound(i, j) = std::min(minimum, elevation(i, j));
+        time(i, j) = stamp;
+      }
+    }
+  });
+  isInitialized_ = true;
+  return true;
+}
+
+bool PointCloudRasterizer::getMap(const std::vector<std::string>& layers, grid_map::GridMap& map, double& zPosition) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!isInitialized_) return false;
+  map = map_;
+  zPosition = zPosition_;
+  for (const auto& layer : layers) {
+    if (!map.exists(layer)) map.add(layer, 0.0);
+  }
+  return true;
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,126 @@
+/*
+ * SegmentCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/SegmentCache.hpp"
+
+// ROS
+#include <ros/ros.h>
+
+// System
+#include <cmath>
+
+namespace traversability_estimation {
+
+SegmentCache::SegmentCache()
+    : generation_(0), snapshot_(0), positionResolution_(0.001), orientationResolution_(0.001), maxSize_(100000), nHits_(0), nMisses_(0) {}
+
+void SegmentCache::setResolution(const double positionResolution, const double orientationResolution) {
+  positionResolution_ = positionResolution;
+  orientationResolution_ = orientationResolution;
+  clear();
+}
+
+void SegmentCache::setMaxSize(const size_t maxSize) {
+  maxSize_ = maxSize;
+  clear();
+}
+
+void SegmentCache::setGeneration(const uint64_t generation, const uint64_t snapshot) {
+  generation_ = generation;
+  snapshot_ = snapshot;
+}
+
+void SegmentCache::remove(const uint64_t generation, const uint64_t snapshot) {
+  for (auto iterator = segments_.begin(); iterator != segments_.end();) {
+    if (iterator->first.generation == generation && iterator->first.snapshot == snapshot) {
+      iterator = segments_.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+}
+
+void SegmentCache::clear() {
+  if (nHits_ + nMisses_ > 0) {
+    ROS_DEBUG("Segment cache: %zu hits, %zu misses on %zu segments.", nHits_, nMisses_, segments_.size());
+  }
+  segments_.clear();
+  nHits_ = 0;
+  nMisses_ = 0;
+}
+
+void SegmentCache::invalidate(const Eigen::AlignedBox2d& bounds) {
+  for (auto iterator = segments_.begin(); iterator != segments_.end();) {
+    if (iterator->first.generation == generation_ && iterator->first.snapshot == snapshot_ && iterator->second.bounds.intersects(bounds)) {
+      iterator = segments_.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+}
+
+SegmentCache::Key SegmentCache::getKey(const uint64_t footprint, const geometry_msgs::Pose& start, const geometry_msgs::Pose& end,
+                                       const bool useOrientation) const {
+  Key key;
+  key.generation = generation_;
+  key.snapshot = snapshot_;
+  key.footprint = footprint;
+  key.poses.fill(0);
+  size_t i = 0;
+  for (const auto* pose : {&start, &end}) {
+    key.poses[i++] = quantize(pose->position.x, positionResolution_);
+    key.poses[i++] = quantize(pose->position.y, positionResolution_);
+    if (useOrientation) {
+      // The sign of the quaternion is ambiguous, use the one with non-negative w.
+      const double sign = pose->orientation.w < 0.0 ? -1.0 : 1.0;
+      key.poses[i++] = quantize(sign * pose->orientation.x, orientationResolution_);
+      key.poses[i++] = quantize(sign * pose->orientation.y, orientationResolution_);
+      key.poses[i++] = quantize(sign * pose->orientation.z, orientationResolution_);
+      key.poses[i++] = quantize(sign * pose->orientation.w, orientationResolution_);
+    } else {
+      i += 4;
+    }
+  }
+  return key;
+}
+
+bool SegmentCache::get(const Key& key, Segment& segment) {
+  if (maxSize_ == 0) return false;
+  const auto iterator = segments_.find(key);
+  if (iterator == segments_.end()) {
+    nMisses_++;
+    return false;
+  }
+  nHits_++;
+  segment = iterator->second;
+  return true;
+}
+
+void SegmentCache::insert(const Key& key, const Segment& segment) {
+  if (maxSize_ == 0) return;
+  if (segments_.size() >= maxSize_) clear();
+  segments_[key] = segment;
+}
+
+void SegmentCache::combineHash(uint64_t& hash, const uint64_t value) {
+  hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+}
+
+size_t SegmentCache::KeyHash::operator()(const Key& key) const {
+  uint64_t hash = key.footprint;
+  combineHash(hash, key.generation);
+  combineHash(hash, key.snapshot);
+  for (const auto value : key.poses) combineHash(hash, static_cast<uint64_t>(value));
+  return static_cast<size_t>(hash);
+}
+
+int64_t SegmentCache::quantize(const double value, const double resolution) {
+  return static_cast<int64_t>(std::llround(value / resolution));
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,77 @@
+/*
+ * SparseCellCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/SparseCellCache.hpp"
+
+// STD
+#include <utility>
+
+namespace traversability_estimation {
+
+namespace {
+const size_t minCapacity = 64;
+}  // namespace
+
+constexpr uint32_t SparseCellCache::emptyKey;
+
+SparseCellCache::SparseCellCache() : mask_(0), shift_(64), nEntries_(0) {}
+
+void SparseCellCache::set(const uint32_t key, const float value) {
+  if (2 * (nEntries_ + 1) > keys_.size()) rehash(keys_.empty() ? minCapacity : 2 * keys_.size());
+  size_t slot = getSlot(key);
+  while (keys_[slot] != emptyKey && keys_[slot] != key + 1) slot = (slot + 1) & mask_;
+  if (keys_[slot] == emptyKey) {
+    keys_[slot] = key + 1;
+    nEntries_++;
+  }
+  values_[slot] = value;
+}
+
+void SparseCellCache::eraseBlock(const int startRow, const int startCol, const int nRows, const int nCols, const int rows) {
+  if (nEntries_ == 0) return;
+  // Linear probing does not allow to simply empty slots, the remaining cells are reinserted instead.
+  std::vector<uint32_t> keys;
+  std::vector<float> values;
+  std::swap(keys, keys_);
+  std::swap(values, values_);
+  const size_t capacity = keys.size();
+  keys_.assign(capacity, emptyKey);
+  values_.assign(capacity, NAN);
+  nEntries_ = 0;
+  for (size_t slot = 0; slot < capacity; ++slot) {
+    if (keys[slot] == emptyKey) continue;
+    const int row = static_cast<int>((keys[slot] - 1) % rows);
+    const int col = static_cast<int>((keys[slot] - 1) / rows);
+    if (row >= startRow && row < startRow + nRows && col >= startCol && col < startCol + nCols) continue;
+    set(keys[slot] - 1, values[slot]);
+  }
+}
+
+void SparseCellCache::clear() {
+  std::vector<uint32_t>().swap(keys_);
+  std::vector<float>().swap(values_);
+  mask_ = 0;
+  shift_ = 64;
+  nEntries_ = 0;
+}
+
+void SparseCellCache::rehash(const size_t capacity) {
+  std::vector<uint32_t> keys(capacity, emptyKey);
+  std::vector<float> values(capacity, NAN);
+  std::swap(keys, keys_);
+  std::swap(values, values_);
+  mask_ = capacity - 1;
+  shift_ = 64;
+  for (size_t c = capacity; c > 1; c >>= 1) shift_--;
+  nEntries_ = 0;
+  for (size_t slot = 0; slot < keys.size(); ++slot) {
+    if (keys[slot] != emptyKey) set(keys[slot] - 1, values[slot]);
+  }
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,56 @@
+/*
+ * TiledLayer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/TiledLayer.hpp"
+
+// System
+#include <algorithm>
+#include <cmath>
+
+namespace traversability_estimation {
+
+constexpr uint32_t TiledLayer::tileBits;
+constexpr uint32_t TiledLayer::tileMask;
+constexpr uint32_t TiledLayer::blockBits;
+constexpr uint32_t TiledLayer::blockMask;
+
+void TiledLayer::fromMatrix(const grid_map::Matrix& matrix) {
+  const uint32_t tileSize = 1u << tileBits;
+  const uint32_t tileRows = (static_cast<uint32_t>(matrix.rows()) + tileMask) >> tileBits;
+  const uint32_t tileColumns = (static_cast<uint32_t>(matrix.cols()) + tileMask) >> tileBits;
+  data_.clear();
+  blockColumns_ = 0;
+  if (tileRows == 0 || tileColumns == 0) return;
+
+  // Tiles of the blocks at the border which are outside of the layer are left unused.
+  const size_t blockRows = (tileRows + blockMask) >> blockBits;
+  blockColumns_ = (tileColumns + blockMask) >> blockBits;
+  data_.assign((blockRows * blockColumns_) << (2 * (blockBits + tileBits)), NAN);
+  data_.shrink_to_fit();
+  for (uint32_t tileColumn = 0; tileColumn < tileColumns; ++tileColumn) {
+    for (uint32_t tileRow = 0; tileRow < tileRows; ++tileRow) {
+      float* tile = data_.data() + getTileOffset(tileRow, tileColumn);
+      const uint32_t rowBegin = tileRow << tileBits;
+      const uint32_t columnBegin = tileColumn << tileBits;
+      const uint32_t rows = std::min(tileSize, static_cast<uint32_t>(matrix.rows()) - rowBegin);
+      const uint32_t columns = std::min(tileSize, static_cast<uint32_t>(matrix.cols()) - columnBegin);
+      for (uint32_t column = 0; column < columns; ++column) {
+        const float* source = matrix.data() + static_cast<size_t>(columnBegin + column) * matrix.rows() + rowBegin;
+        std::copy(source, source + rows, tile + (column << tileBits));
+      }
+    }
+  }
+}
+
+void TiledLayer::clear() {
+  data_.clear();
+  blockColumns_ = 0;
+  data_.shrink_to_fit();
+}
+
+}  // namespace traversability_estimation
@@ -10,15 +10,47 @@
 #include "traversability_estimation/common.h"
 #include <traversability_msgs/TraversabilityResult.h>
 #include <param_io/get_param.hpp>
+#include <filters/ThreadPool.hpp>
 
 // ROS
 #include <geometry_msgs/Pose.h>
 #include <ros/package.h>
+#include <tf_conversions/tf_eigen.h>
+
+// STD
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#ifdef __linux__
+#include <linux/capability.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 namespace traversability_estimation {
 
+#ifdef __linux__
+namespace {
+
+//! Checks if all future allocations can be locked, i.e. the memlock limit is infinite or does not apply.
+bool canLockFutureMemory() {
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY) return true;
+  __user_cap_header_struct header{_LINUX_CAPABILITY_VERSION_3, 0};
+  __user_cap_data_struct data[_LINUX_CAPABILITY_U32S_3];
+  return syscall(SYS_capget, &header, data) == 0 && (data[CAP_TO_INDEX(CAP_IPC_LOCK)].effective & CAP_TO_MASK(CAP_IPC_LOCK)) != 0;
+}
+
+}  // namespace
+#endif
+
 TraversabilityEstimation::TraversabilityEstimation(ros::NodeHandle& nodeHandle)
     : nodeHandle_(nodeHandle),
       acceptGridMapToInitTraversabilityMap_(false),
@@ -29,28 +61,81 @@ TraversabilityEstimation::TraversabilityEstimation(ros::NodeHandle& nodeHandle)
       roughnessType_("traversability_roughness"),
       robotSlopeType_("robot_slope"),
       getImageCallback_(false),
-      useRawMap_(false) {
+      useRawMap_(false),
+      useRealtimeThreads_(false),
+      nQueryThreads_(1),
+      queryPriority_(0),
+      computePriority_(0),
+      isMemoryLockEnabled_(false),
+      isMemoryLockRequested_(false),
+      pathCheckLatency_("Check footprint path", 0),
+      nComputeServiceWorkers_(1),
+      useLookAhead_(false),
+      useCacheWarming_(false),
+      cacheWarmingTimeHorizon_(2.0),
+      velocityInterval_(0.5),
+      plannedPathTimeout_(5.0),
+      elevationMapResolution_(0.0) {
   ROS_DEBUG("Traversability estimation node started.");
   readParameters();
   traversabilityMap_.createLayers(useRawMap_);
   submapClient_ = nodeHandle_.serviceClient<grid_map_msgs::GetGridMap>(submapServiceName_);
 
+  // The queries and the map update are served by their own threads, such that they can be pinned and prioritized.
+  queryNodeHandle_ = nodeHandle_;
+  computeNodeHandle_ = nodeHandle_;
+  if (useRealtimeThreads_) {
+    queryNodeHandle_.setCallbackQueue(&queryQueue_);
+    computeNodeHandle_.setCallbackQueue(&computeQueue_);
+  }
+
   if (!updateDuration_.isZero()) {
-    updateTimer_ = nodeHandle_.createTimer(updateDuration_, &TraversabilityEstimation::updateTimerCallback, this);
+    updateTimer_ = computeNodeHandle_.createTimer(updateDuration_, &TraversabilityEstimation::updateTimerCallback, this);
   } else {
     ROS_WARN("Update rate is zero. No traversability map will be published.");
   }
 
   loadElevationMapService_ = nodeHandle_.advertiseService("load_elevation_map", &TraversabilityEstimation::loadElevationMap, this);
-  updateTraversabilityService_ =
-      nodeHandle_.advertiseService("update_traversability", &TraversabilityEstimation::updateServiceCallback, this);
+  // The update service waits for the timer updates if the timer is running, so it only shares their thread if it computes itself.
+  updateTraversabilityService_ = (updateDuration_.isZero() ? computeNodeHandle_ : nodeHandle_)
+                                     .advertiseService("update_traversability", &TraversabilityEstimation::updateServiceCallback, this);
   getTraversabilityService_ = nodeHandle_.advertiseService("get_traversability", &TraversabilityEstimation::getTraversabilityMap, this);
-  footprintPathService_ = nodeHandle_.advertiseService("check_footprint_path", &TraversabilityEstimation::checkFootprintPath, this);
+  footprintPathService_ = queryNodeHandle_.advertiseService("check_footprint_path", &TraversabilityEstimation::checkFootprintPath, this);
+  nearestTraversablePoseService_ =
+      queryNodeHandle_.advertiseService("get_nearest_traversable_pose", &TraversabilityEstimation::getNearestTraversablePose, this);
+  registerMotionPrimitivesService_ =
+      nodeHandle_.advertiseService("register_motion_primitives", &TraversabilityEstimation::registerMotionPrimitives, this);
+  checkMotionPrimitivesService_ =
+      queryNodeHandle_.advertiseService("check_motion_primitives", &TraversabilityEstimation::checkMotionPrimitives, this);
+  checkConnectivityService_ = queryNodeHandle_.advertiseService("check_connectivity", &TraversabilityEstimation::checkConnectivity, this);
+  openSessionService_ = nodeHandle_.advertiseService("open_session", &TraversabilityEstimation::openSession, this);
+  closeSessionService_ = nodeHandle_.advertiseService("close_session", &TraversabilityEstimation::closeSession, this);
+  getSessionTraversabilityService_ =
+      nodeHandle_.advertiseService("get_session_traversability", &TraversabilityEstimation::getSessionTraversabilityMap, this);
+  // Stateless computations are served by their own threads, such that they neither block nor outnumber the other callbacks.
+  ros::NodeHandle computeServiceNodeHandle = nodeHandle_;
+  computeServiceNodeHandle.setCallbackQueue(&computeServiceQueue_);
+  computeTraversabilityService_ =
+      computeServiceNodeHandle.advertiseService("compute_traversability", &TraversabilityEstimation::computeTraversability, this);
+  overwriteService_ = nodeHandle_.advertiseService("overwrite", &TraversabilityEstimation::overwrite, this);
   updateParameters_ = nodeHandle_.advertiseService("update_parameters", &TraversabilityEstimation::updateParameter, this);
   traversabilityFootprint_ =
       nodeHandle_.advertiseService("traversability_footprint", &TraversabilityEstimation::traversabilityFootprint, this);
   saveToBagService_ = nodeHandle_.advertiseService("save_traversability_map_to_bag", &TraversabilityEstimation::saveToBag, this);
   imageSubscriber_ = nodeHandle_.subscribe(imageTopic_, 1, &TraversabilityEstimation::imageCallback, this);
+  dynamicObstaclesSubscriber_ = nodeHandle_.subscribe("dynamic_obstacles", 1, &TraversabilityEstimation::dynamicObstaclesCallback, this);
+  if (!plannedPathTopic_.empty()) {
+    plannedPathSubscriber_ = nodeHandle_.subscribe(plannedPathTopic_, 1, &TraversabilityEstimation::plannedPathCallback, this);
+  }
+
+  if (usePointCloud_) {
+    pointCloudRasterizer_.setGeometry(mapLength_, pointCloudResolution_, traversabilityMap_.getMapFrameId());
+    // The clouds are queued until their transform is available instead of waiting for it in the callback.
+    pointCloudSubscriber_.subscribe(computeNodeHandle_, pointCloudTopic_, 1);
+    pointCloudFilter_.reset(new tf::MessageFilter<sensor_msgs::PointCloud2>(pointCloudSubscriber_, transformListener_,
+                                                                           traversabilityMap_.getMapFrameId(), 5, computeNodeHandle_));
+    pointCloudFilter_->registerCallback(&TraversabilityEstimation::pointCloudCallback, this);
+  }
 
   if (acceptGridMapToInitTraversabilityMap_) {
     gridMapToInitTraversabilityMapSubscriber_ = nodeHandle_.subscribe(
@@ -68,10 +153,23 @@ TraversabilityEstimation::TraversabilityEstimation(ros::NodeHandle& nodeHandle)
     elevationMapLayers_.push_back("horizontal_variance_xy");
     elevationMapLayers_.push_back("time");
   }
+
+  if (useRealtimeThreads_) {
+    querySpinner_.reset(new ros::AsyncSpinner(nQueryThreads_, &queryQueue_));
+    computeSpinner_.reset(new ros::AsyncSpinner(1, &computeQueue_));
+    querySpinner_->start();
+    computeSpinner_->start();
+  }
+  computeServiceSpinner_.reset(new ros::AsyncSpinner(nComputeServiceWorkers_, &computeServiceQueue_));
+  computeServiceSpinner_->start();
 }
 
 TraversabilityEstimation::~TraversabilityEstimation() {
   updateTimer_.stop();
+  if (computeServiceSpinner_) computeServiceSpinner_->stop();
+  if (querySpinner_) querySpinner_->stop();
+  if (computeSpinner_) computeSpinner_->stop();
+  pointCloudFilter_.reset();
   nodeHandle_.shutdown();
 }
 
@@ -114,11 +212,52 @@ bool TraversabilityEstimation::readParameters() {
   mapLength_.y() = param_io::param(nodeHandle_, "map_length_y", 5.0);
   footprintYaw_ = param_io::param(nodeHandle_, "footprint_yaw", M_PI_2);
 
+  // Submap placement from the motion of the robot.
+  useLookAhead_ = param_io::param<bool>(nodeHandle_, "look_ahead/enable", false);
+  lookAheadWindow_.setParameters(mapLength_.prod(), param_io::param(nodeHandle_, "look_ahead/time_horizon", 2.0),
+                                 param_io::param(nodeHandle_, "look_ahead/margin", 0.5),
+                                 param_io::param(nodeHandle_, "look_ahead/min_length", 2.0));
+  velocityInterval_ = param_io::param(nodeHandle_, "look_ahead/velocity_interval", 0.5);
+  plannedPathTimeout_ = param_io::param(nodeHandle_, "look_ahead/path_timeout", 5.0);
+  plannedPathTopic_ = param_io::param<std::string>(nodeHandle_, "look_ahead/path_topic", "");
+
+  // Footprint cache warming along the upcoming motion.
+  useCacheWarming_ = param_io::param<bool>(nodeHandle_, "cache_warming/enable", false);
+  cacheWarmingTimeHorizon_ = param_io::param(nodeHandle_, "cache_warming/time_horizon", 2.0);
+
   // Grid map to initialize elevation layer
   acceptGridMapToInitTraversabilityMap_ = param_io::param<bool>(nodeHandle_, "grid_map_to_initialize_traversability_map/enable", false);
   gridMapToInitTraversabilityMapTopic_ =
       param_io::param<std::string>(nodeHandle_, "grid_map_to_initialize_traversability_map/grid_map_topic_name", "initial_elevation_map");
 
+  // Point cloud input.
+  usePointCloud_ = param_io::param<bool>(nodeHandle_, "point_cloud/enable", false);
+  pointCloudTopic_ = param_io::param<std::string>(nodeHandle_, "point_cloud/topic", "points");
+  pointCloudResolution_ = param_io::param(nodeHandle_, "point_cloud/resolution", 0.04);
+  const auto reduction = param_io::param<std::string>(nodeHandle_, "point_cloud/reduction", "max");
+  if (reduction == "max") {
+    pointCloudRasterizer_.setReduction(PointCloudRasterizer::Reduction::Max);
+  } else if (reduction == "mean") {
+    pointCloudRasterizer_.setReduction(PointCloudRasterizer::Reduction::Mean);
+  } else {
+    ROS_ERROR("Traversability Estimation: Unknown point cloud reduction '%s', using 'max'.", reduction.c_str());
+  }
+  pointCloudRasterizer_.setTemporalWeight(param_io::param(nodeHandle_, "point_cloud/temporal_weight", 0.5));
+
+  // Stateless traversability computations.
+  nComputeServiceWorkers_ = std::max(1, param_io::param(nodeHandle_, "compute_service/workers", 1));
+  configureFilterChainPool();
+
+  // Real-time configuration.
+  useRealtimeThreads_ = param_io::param<bool>(nodeHandle_, "realtime/enable", false);
+  nQueryThreads_ = std::max(1, param_io::param(nodeHandle_, "realtime/query_threads", 1));
+  queryCpus_ = param_io::param(nodeHandle_, "realtime/query_cpus", std::vector<int>());
+  queryPriority_ = param_io::param(nodeHandle_, "realtime/query_priority", 0);
+  computeCpus_ = param_io::param(nodeHandle_, "realtime/compute_cpus", std::vector<int>());
+  computePriority_ = param_io::param(nodeHandle_, "realtime/compute_priority", 0);
+  isMemoryLockEnabled_ = param_io::param<bool>(nodeHandle_, "realtime/lock_memory", false);
+  pathCheckLatency_.setWindowSize(std::max(0, param_io::param(nodeHandle_, "realtime/latency_window", 0)));
+
   return true;
 }
 
@@ -151,6 +290,26 @@ bool TraversabilityEstimation::loadElevationMap(grid_map_msgs::ProcessFile::Requ
   return true;
 }
 
+bool TraversabilityEstimation::overwrite(traversability_msgs::Overwrite::Request& request,
+                                         traversability_msgs::Overwrite::Response& response) {
+  if (!request.enable) {
+    response.success = static_cast<unsigned char>(traversabilityMap_.removeOverride(request.id));
+    return true;
+  }
+  const bool isKeepOut = request.type == traversability_msgs::Overwrite::Request::KEEP_OUT;
+  if (!isKeepOut && request.type != traversability_msgs::Overwrite::Request::TRAVERSABLE) {
+    ROS_WARN("Traversability Estimation: overwrite: Unknown override type %u.", request.type);
+    response.success = static_cast<unsigned char>(false);
+    return true;
+  }
+  response.success = static_cast<unsigned char>(traversabilityMap_.setOverride(request.id, request.polygon, isKeepOut, request.lifetime));
+  return true;
+}
+
+void TraversabilityEstimation::dynamicObstaclesCallback(const traversability_msgs::DynamicObstacles& dynamicObstacles) {
+  traversabilityMap_.setDynamicObstacles(dynamicObstacles);
+}
+
 void TraversabilityEstimation::imageCallback(const sensor_msgs::Image& image) {
   if (!getImageCallback_) {
     grid_map::GridMapRosConverter::initializeFromImage(image, imageResolution_, imageGridMap_, imagePosition_);
@@ -167,11 +326,15 @@ void TraversabilityEstimation::imageCallback(const sensor_msgs::Image& image) {
   traversabilityMap_.setElevationMap(elevationMap);
 }
 
-void TraversabilityEstimation::updateTimerCallback(const ros::TimerEvent& timerEvent) { updateTraversability(); }
+void TraversabilityEstimation::updateTimerCallback(const ros::TimerEvent& timerEvent) {
+  configureComputeThread();
+  updateTraversability();
+}
 
 bool TraversabilityEstimation::updateServiceCallback(grid_map_msgs::GetGridMapInfo::Request&,
                                                      grid_map_msgs::GetGridMapInfo::Response& response) {
   if (updateDuration_.isZero()) {
+    configureComputeThread();
     if (!updateTraversability()) {
       ROS_ERROR("Traversability Estimation: Cannot update traversability!");
       return false;
@@ -201,7 +364,17 @@ bool TraversabilityEstimation::updateServiceCallback(grid_map_msgs::GetGridMapIn
 
 bool TraversabilityEstimation::updateTraversability() {
   grid_map_msgs::GridMap elevationMap;
-  if (!getImageCallback_) {
+  if (usePointCloud_) {
+    grid_map::GridMap map;
+    double zPosition;
+    if (!pointCloudRasterizer_.getMap(elevationMapLayers_, map, zPosition)) {
+      ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "No point cloud received yet.");
+      return false;
+    }
+    if (!traversabilityMap_.setElevationMap(map, zPosition)) return false;
+    updateRobotPosition();
+    if (!traversabilityMap_.computeTraversability()) return false;
+  } else if (!getImageCallback_) {
     ROS_DEBUG("Sending request to %s.", submapServiceName_.c_str());
     if (!submapClient_.waitForExistence(ros::Duration(2.0))) {
       return false;
@@ -209,6 +382,7 @@ bool TraversabilityEstimation::updateTraversability() {
     ROS_DEBUG("Sending request to %s.", submapServiceName_.c_str());
     if (requestElevationMap(elevationMap)) {
       traversabilityMap_.setElevationMap(elevationMap);
+      updateRobotPosition();
       if (!traversabilityMap_.computeTraversability()) return false;
     } else {
       ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Failed to retrieve elevation grid map.");
@@ -218,6 +392,8 @@ bool TraversabilityEstimation::updateTraversability() {
     if (!traversabilityMap_.computeTraversability()) return false;
   }
 
+  if (useCacheWarming_) warmFootprintCaches();
+  if (isMemoryLockEnabled_ && !isMemoryLockRequested_.exchange(true)) lockMemory();
   return true;
 }
 
@@ -242,6 +418,78 @@ bool TraversabilityEstimation::updateParameter(std_srvs::Empty::Request&, std_sr
   }
 
   if (!traversabilityMap_.updateFilter()) return false;
+  configureFilterChainPool();
+  return true;
+}
+
+bool TraversabilityEstimation::checkConnectivity(traversability_msgs::CheckConnectivity::Request& request,
+                                                 traversability_msgs::CheckConnectivity::Response& response) {
+  configureQueryThread();
+  response.success = static_cast<unsigned char>(request.positions_a.size() == request.positions_b.size());
+  response.is_connected.clear();
+  for (size_t i = 0; i < request.positions_a.size() && response.success; i++) {
+    bool isConnected = false;
+    const grid_map::Position positionA(request.positions_a[i].x, request.positions_a[i].y);
+    const grid_map::Position positionB(request.positions_b[i].x, request.positions_b[i].y);
+    response.success = static_cast<unsigned char>(traversabilityMap_.areInSameTraversableComponent(positionA, positionB, isConnected));
+    response.is_connected.push_back(static_cast<unsigned char>(isConnected));
+  }
+  if (!response.success) response.is_connected.clear();
+  return true;
+}
+
+void TraversabilityEstimation::configureFilterChainPool() {
+  XmlRpc::XmlRpcValue config;
+  if (!param_io::getParam(nodeHandle_, "traversability_map_filters", config)) {
+    ROS_WARN("Traversability Estimation: No filter chain configuration for the compute_traversability service.");
+  }
+  filterChainPool_.configure(config, static_cast<size_t>(nComputeServiceWorkers_));
+}
+
+bool TraversabilityEstimation::computeTraversability(traversability_msgs::ComputeTraversability::Request& request,
+                                                     traversability_msgs::ComputeTraversability::Response& response) {
+  response.success = static_cast<unsigned char>(false);
+  if (request.parameter_names.size() != request.parameter_values.size()) {
+    response.message = "The number of parameter names and values differ.";
+    return true;
+  }
+  grid_map::GridMap elevationMap;
+  grid_map::GridMapRosConverter::fromMessage(request.elevation_map, elevationMap);
+  for (const auto& layer : elevationMapLayers_) {
+    if (!elevationMap.exists(layer)) {
+      response.message = "The elevation map has no layer '" + layer + "'.";
+      return true;
+    }
+  }
+
+  FilterChainPool::Overrides overrides;
+  for (size_t i = 0; i < request.parameter_names.size(); i++) {
+    overrides.emplace_back(request.parameter_names[i], request.parameter_values[i]);
+  }
+  const ros::WallTime start = ros::WallTime::now();
+  grid_map::GridMap map;
+  if (!filterChainPool_.update(elevationMap, map, overrides, response.message)) {
+    ROS_WARN("Traversability Estimation: compute_traversability failed: %s", response.message.c_str());
+    return true;
+  }
+  map.convertToDefaultStartIndex();
+  // The map is computed in the frame of the request, independent of the frame of the map of the node.
+  map.setFrameId(elevationMap.getFrameId());
+  map.setTimestamp(elevationMap.getTimestamp());
+  ROS_DEBUG("Traversability Estimation: compute_traversability took %f s.", (ros::WallTime::now() - start).toSec());
+
+  if (request.layers.empty()) {
+    grid_map::GridMapRosConverter::toMessage(map, response.traversability_map);
+  } else {
+    for (const auto& layer : request.layers) {
+      if (!map.exists(layer)) {
+        response.message = "The traversability map has no layer '" + layer + "'.";
+        return true;
+      }
+    }
+    grid_map::GridMapRosConverter::toMessage(map, request.layers, response.traversability_map);
+  }
+  response.success = static_cast<unsigned char>(true);
   return true;
 }
 
@@ -256,19 +504,139 @@ bool TraversabilityEstimation::requestElevationMap(grid_map_msgs::GridMap& map)
     return false;
   }
 
+  grid_map::Position center(submapPointTransformed.point.x, submapPointTransformed.point.y);
+  grid_map::Length length = mapLength_;
+  if (useLookAhead_ && !computeLookAheadWindow(center, length)) return false;
+
   grid_map_msgs::GetGridMap submapService;
-  submapService.request.position_x = submapPointTransformed.point.x;
-  submapService.request.position_y = submapPointTransformed.point.y;
-  submapService.request.length_x = mapLength_.x();
-  submapService.request.length_y = mapLength_.y();
+  submapService.request.position_x = center.x();
+  submapService.request.position_y = center.y();
+  submapService.request.length_x = length.x();
+  submapService.request.length_y = length.y();
   submapService.request.layers = elevationMapLayers_;
 
   if (!submapClient_.call(submapService)) return false;
   map = submapService.response.map;
+  elevationMapResolution_ = map.info.resolution;
+
+  return true;
+}
+
+void TraversabilityEstimation::plannedPathCallback(const geometry_msgs::PoseArray& path) { setPlannedPath(path); }
+
+void TraversabilityEstimation::pointCloudCallback(const sensor_msgs::PointCloud2ConstPtr& cloud) {
+  const std::string& mapFrameId = traversabilityMap_.getMapFrameId();
+  tf::StampedTransform sensorTransform;
+  geometry_msgs::PointStamped center;
+  try {
+    transformListener_.lookupTransform(mapFrameId, cloud->header.frame_id, cloud->header.stamp, sensorTransform);
+    geometry_msgs::PointStamped submapPoint = submapPoint_;
+    submapPoint.header.stamp = ros::Time(0);
+    transformListener_.transformPoint(mapFrameId, submapPoint, center);
+  } catch (tf::TransformException& ex) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "%s", ex.what());
+    return;
+  }
 
+  Eigen::Affine3d transform;
+  tf::transformTFToEigen(sensorTransform, transform);
+  pointCloudRasterizer_.move(grid_map::Position3(center.point.x, center.point.y, center.point.z));
+  pointCloudRasterizer_.addPointCloud(*cloud, transform.cast<float>());
+}
+
+bool TraversabilityEstimation::getRobotPosition(grid_map::Position& position) {
+  geometry_msgs::PointStamped robotOrigin, robotOriginTransformed;
+  robotOrigin.header.frame_id = robotFrameId_;
+  robotOrigin.header.stamp = ros::Time(0);
+
+  try {
+    transformListener_.transformPoint(traversabilityMap_.getMapFrameId(), robotOrigin, robotOriginTransformed);
+  } catch (tf::TransformException& ex) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "%s", ex.what());
+    return false;
+  }
+
+  position.x() = robotOriginTransformed.point.x;
+  position.y() = robotOriginTransformed.point.y;
   return true;
 }
 
+void TraversabilityEstimation::updateRobotPosition() {
+  // The robot position is only used for the cost-to-go.
+  if (!traversabilityMap_.isCostToGoEnabled()) return;
+  grid_map::Position robotPosition;
+  if (getRobotPosition(robotPosition)) traversabilityMap_.setRobotPosition(robotPosition);
+}
+
+bool TraversabilityEstimation::getRobotMotion(grid_map::Position& position, Eigen::Vector2d& velocity) {
+  geometry_msgs::PointStamped robotOrigin, robotOriginTransformed, previousRobotOriginTransformed;
+  robotOrigin.header.frame_id = robotFrameId_;
+  robotOrigin.header.stamp = ros::Time(0);
+
+  try {
+    transformListener_.transformPoint(traversabilityMap_.getMapFrameId(), robotOrigin, robotOriginTransformed);
+  } catch (tf::TransformException& ex) {
+    ROS_ERROR("%s", ex.what());
+    return false;
+  }
+  position.x() = robotOriginTransformed.point.x;
+  position.y() = robotOriginTransformed.point.y;
+
+  velocity.setZero();
+  robotOrigin.header.stamp = robotOriginTransformed.header.stamp - ros::Duration(velocityInterval_);
+  try {
+    transformListener_.transformPoint(traversabilityMap_.getMapFrameId(), robotOrigin, previousRobotOriginTransformed);
+  } catch (tf::TransformException& ex) {
+    ROS_DEBUG("Traversability Estimation: No robot velocity: %s", ex.what());
+    return true;
+  }
+  velocity.x() = (robotOriginTransformed.point.x - previousRobotOriginTransformed.point.x) / velocityInterval_;
+  velocity.y() = (robotOriginTransformed.point.y - previousRobotOriginTransformed.point.y) / velocityInterval_;
+  return true;
+}
+
+bool TraversabilityEstimation::computeLookAheadWindow(grid_map::Position& center, grid_map::Length& length) {
+  grid_map::Position robotPosition;
+  Eigen::Vector2d velocity;
+  if (!getRobotMotion(robotPosition, velocity)) return false;
+  std::vector<grid_map::Position> path;
+  {
+    std::lock_guard<std::mutex> lock(plannedPathMutex_);
+    if ((ros::Time::now() - plannedPathStamp_).toSec() <= plannedPathTimeout_) path = plannedPath_;
+  }
+  lookAheadWindow_.update(robotPosition, velocity, path, elevationMapResolution_, center, length);
+  ROS_DEBUG("Traversability Estimation: Look-ahead window at (%f, %f) of size %f x %f m.", center.x(), center.y(), length.x(),
+            length.y());
+  return true;
+}
+
+void TraversabilityEstimation::setPlannedPath(const geometry_msgs::PoseArray& path) {
+  if (!path.header.frame_id.empty() && path.header.frame_id != traversabilityMap_.getMapFrameId()) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Traversability Estimation: The planned path is not in the map frame '%s'.",
+                      traversabilityMap_.getMapFrameId().c_str());
+    return;
+  }
+  std::lock_guard<std::mutex> lock(plannedPathMutex_);
+  plannedPath_.clear();
+  for (const auto& pose : path.poses) plannedPath_.emplace_back(pose.position.x, pose.position.y);
+  plannedPathStamp_ = ros::Time::now();
+}
+
+void TraversabilityEstimation::warmFootprintCaches() {
+  grid_map::Position robotPosition;
+  Eigen::Vector2d velocity;
+  if (!getRobotMotion(robotPosition, velocity)) return;
+  std::vector<grid_map::Position> corridor{robotPosition};
+  {
+    std::lock_guard<std::mutex> lock(plannedPathMutex_);
+    if ((ros::Time::now() - plannedPathStamp_).toSec() <= plannedPathTimeout_) {
+      corridor.insert(corridor.end(), plannedPath_.begin(), plannedPath_.end());
+    }
+  }
+  if (corridor.size() == 1) corridor.emplace_back(robotPosition + velocity * cacheWarmingTimeHorizon_);
+  traversabilityMap_.warmFootprintCaches(corridor);
+}
+
 bool TraversabilityEstimation::traversabilityFootprint(std_srvs::Empty::Request& request, std_srvs::Empty::Response& response) {
   if (!traversabilityMap_.traversabilityFootprint(footprintYaw_)) return false;
 
@@ -277,20 +645,70 @@ bool TraversabilityEstimation::traversabilityFootprint(std_srvs::Empty::Request&
 
 bool TraversabilityEstimation::checkFootprintPath(traversability_msgs::CheckFootprintPath::Request& request,
                                                   traversability_msgs::CheckFootprintPath::Response& response) {
+  configureQueryThread();
+  const ros::WallTime start = ros::WallTime::now();
   const int nPaths = request.path.size();
   if (nPaths == 0) {
     ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "No footprint path available to check!");
     return false;
   }
 
+  if ((useLookAhead_ || useCacheWarming_) && plannedPathTopic_.empty() && request.session == 0) {
+    // Without a planned path topic, the checked path is taken as the one the robot is planned to drive. Paths
+    // checked in sessions are alternatives evaluated by a planner and do not move the submap.
+    setPlannedPath(request.path.front().poses);
+  }
+
   traversability_msgs::TraversabilityResult result;
   traversability_msgs::FootprintPath path;
   for (int j = 0; j < nPaths; j++) {
     path = request.path[j];
-    if (!traversabilityMap_.checkFootprintPath(path, result, true)) return false;
+    if (!traversabilityMap_.checkFootprintPath(path, result, true, request.session)) return false;
     response.result.push_back(result);
   }
 
+  pathCheckLatency_.add((ros::WallTime::now() - start).toSec());
+  return true;
+}
+
+bool TraversabilityEstimation::getNearestTraversablePose(traversability_msgs::GetNearestTraversablePose::Request& request,
+                                                         traversability_msgs::GetNearestTraversablePose::Response& response) {
+  configureQueryThread();
+  const bool success = traversabilityMap_.getNearestTraversablePose(request.goal, request.radius, request.footprint.polygon.points,
+                                                                    request.headings, request.max_distance, response.pose);
+  response.success = static_cast<unsigned char>(success);
+  if (success) {
+    response.distance = std::hypot(response.pose.position.x - request.goal.position.x, response.pose.position.y - request.goal.position.y);
+  }
+  return true;
+}
+
+bool TraversabilityEstimation::registerMotionPrimitives(traversability_msgs::RegisterMotionPrimitives::Request& request,
+                                                        traversability_msgs::RegisterMotionPrimitives::Response& response) {
+  const auto& points = request.footprint.polygon.points;
+  if (points.empty() && request.radius <= 0.0) {
+    ROS_WARN("Traversability Estimation: register motion primitives: Neither footprint polygon nor radius defined.");
+    response.success = static_cast<unsigned char>(false);
+    return true;
+  }
+  std::vector<std::vector<geometry_msgs::Pose2D>> primitives;
+  for (const auto& primitive : request.primitives) primitives.push_back(primitive.poses);
+  std::vector<grid_map::Position> footprint;
+  for (const auto& point : points) footprint.emplace_back(point.x, point.y);
+  response.primitive_set =
+      traversabilityMap_.registerMotionPrimitiveSet(MotionPrimitiveSet(primitives, footprint, request.radius, request.heading_bins));
+  response.success = static_cast<unsigned char>(true);
+  return true;
+}
+
+bool TraversabilityEstimation::checkMotionPrimitives(traversability_msgs::CheckMotionPrimitives::Request& request,
+                                                     traversability_msgs::CheckMotionPrimitives::Response& response) {
+  configureQueryThread();
+  std::vector<bool> isSafe;
+  const bool success = traversabilityMap_.checkMotionPrimitives(request.primitive_set, request.primitives, request.starts, isSafe,
+                                                                response.traversability, response.cost);
+  response.success = static_cast<unsigned char>(success);
+  response.is_safe.assign(isSafe.begin(), isSafe.end());
   return true;
 }
 
@@ -315,6 +733,37 @@ bool TraversabilityEstimation::getTraversabilityMap(grid_map_msgs::GetGridMap::R
   return isSuccess;
 }
 
+bool TraversabilityEstimation::openSession(traversability_msgs::OpenSession::Request& request,
+                                           traversability_msgs::OpenSession::Response& response) {
+  response.success = static_cast<unsigned char>(traversabilityMap_.openSession(request.timeout, response.session, response.map_generation));
+  return true;
+}
+
+bool TraversabilityEstimation::closeSession(traversability_msgs::CloseSession::Request& request,
+                                            traversability_msgs::CloseSession::Response& response) {
+  response.success = static_cast<unsigned char>(traversabilityMap_.closeSession(request.session));
+  return true;
+}
+
+bool TraversabilityEstimation::getSessionTraversabilityMap(traversability_msgs::GetSessionTraversability::Request& request,
+                                                           traversability_msgs::GetSessionTraversability::Response& response) {
+  grid_map::GridMap map;
+  if (!traversabilityMap_.getTraversabilityMap(request.session, map)) {
+    response.success = static_cast<unsigned char>(false);
+    return true;
+  }
+  bool isSuccess;
+  grid_map::GridMap subMap =
+      map.getSubmap(grid_map::Position(request.position_x, request.position_y), grid_map::Length(request.length_x, request.length_y), isSuccess);
+  if (request.layers.empty()) {
+    grid_map::GridMapRosConverter::toMessage(subMap, response.map);
+  } else {
+    grid_map::GridMapRosConverter::toMessage(subMap, request.layers, response.map);
+  }
+  response.success = static_cast<unsigned char>(isSuccess);
+  return true;
+}
+
 bool TraversabilityEstimation::saveToBag(grid_map_msgs::ProcessFile::Request& request, grid_map_msgs::ProcessFile::Response& response) {
   ROS_INFO("Save to bag.");
   if (request.file_path.empty() || request.topic_name.empty()) {
@@ -376,4 +825,62 @@ void TraversabilityEstimation::gridMapToInitTraversabilityMapCallback(const grid
   }
 }
 
+void TraversabilityEstimation::configureQueryThread() const {
+  // Only the threads of the dedicated query queue are configured, shared spinner threads keep their scheduling.
+  static thread_local bool isConfigured = false;
+  if (!useRealtimeThreads_ || isConfigured) return;
+  isConfigured = true;
+  filters::configureCurrentThread(queryCpus_, queryPriority_, 0);
+}
+
+void TraversabilityEstimation::configureComputeThread() const {
+  static thread_local bool isConfigured = false;
+  if (!useRealtimeThreads_ || isConfigured) return;
+  isConfigured = true;
+  filters::configureCurrentThread(computeCpus_, computePriority_, 0);
+}
+
+bool TraversabilityEstimation::lockMemory() {
+#ifdef __linux__
+  // With a finite memlock limit, locking the future memory makes the allocations fail once the limit is reached.
+  const bool lockFuture = canLockFutureMemory();
+  if (mlockall(lockFuture ? MCL_CURRENT | MCL_FUTURE : MCL_CURRENT) != 0) {
+    ROS_WARN("Traversability Estimation: Could not lock the memory: %s (missing CAP_IPC_LOCK or memlock limit?).", std::strerror(errno));
+    return false;
+  }
+  // Freed memory stays in the heap for the next update instead of being returned to the system and faulted in again.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+  if (lockFuture) {
+    ROS_INFO("Traversability Estimation: Locked the current and future memory of the process.");
+    return true;
+  }
+
+  // Prefault and lock heap memory for the buffers of the next update, a copy of the map, which is kept in the heap
+  // once freed.
+  std::map<std::string, size_t> usage;
+  traversabilityMap_.getMemoryUsage(usage);
+  size_t size = 0;
+  for (const auto& layer : usage) size += layer.second;
+  void* buffer = std::malloc(size);
+  int error = ENOMEM;
+  if (buffer != nullptr) {
+    std::memset(buffer, 0, size);
+    error = mlock(buffer, size) == 0 ? 0 : errno;
+  }
+  std::free(buffer);
+  if (error != 0) {
+    ROS_WARN("Traversability Estimation: Locked the current memory, but not the %zu bytes for the next update: %s.", size,
+             std::strerror(error));
+    return true;
+  }
+  ROS_INFO("Traversability Estimation: Locked the current memory of the process and %zu bytes for the next update (memlock limit).",
+           size);
+  return true;
+#else
+  ROS_WARN("Traversability Estimation: Locking the memory is only supported on Linux.");
+  return false;
+#endif
+}
+
 }  // namespace traversability_estimation
@@ -7,10 +7,30 @@
  */
 
 #include "traversability_estimation/TraversabilityMap.hpp"
+#include "traversability_estimation/ContourExtraction.hpp"
+#include "traversability_estimation/CostToGo.hpp"
+#include "traversability_estimation/DistanceTransform.hpp"
+#include "traversability_estimation/FilterChecks.hpp"
 #include "traversability_estimation/common.h"
 
+#ifdef TRAVERSABILITY_STATIC_FILTER_PIPELINE
+#include <filters/FilterPipeline.hpp>
+#include <filters/RoughnessFilter.hpp>
+#include <filters/SlopeFilter.hpp>
+#include <filters/StepFilter.hpp>
+#include <filters/SurfaceNormalsFilter.hpp>
+#include <filters/WeightedSumFilter.hpp>
+#endif
+
 // System
 #include <algorithm>
+#include <cmath>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // Grid Map
 #include <grid_map_msgs/GetGridMap.h>
@@ -21,6 +41,7 @@
 #include <geometry_msgs/PolygonStamped.h>
 #include <geometry_msgs/Pose.h>
 #include <ros/package.h>
+#include <traversability_msgs/UntraversablePolygons.h>
 #include <xmlrpcpp/XmlRpcValue.h>
 
 // kindr
@@ -38,28 +59,125 @@ using namespace std;
 
 namespace traversability_estimation {
 
+namespace {
+
+//! Suffixes of the filter layers of the risk variants, computed from the elevation bounds.
+const std::array<std::string, 2> riskVariantSuffixes{{"_pessimistic", "_optimistic"}};
+
+//! Margin added to the radius of circular footprints, within which untraversable cells reduce the traversability.
+constexpr double circularFootprintOffset = 0.15;
+
+//! Largest accepted traversability weight of a cost, the cost-to-go queue grows linearly with it.
+constexpr double maxTraversabilityWeight = 100.0;
+
+//! Attempts to compute the clearance without the map lock, the last one holds it if the map kept changing.
+constexpr int maxClearanceAttempts = 3;
+
+}  // namespace
+
+#ifdef TRAVERSABILITY_STATIC_FILTER_PIPELINE
+struct TraversabilityMap::StaticFilterPipeline {
+  //! Types of the stages in the filter chain configuration.
+  static const std::array<std::string, 5> stageTypes;
+
+  filters::FilterPipeline<grid_map::GridMap, filters::SurfaceNormalsFilter<grid_map::GridMap>, filters::SlopeFilter<grid_map::GridMap>,
+                          filters::StepFilter<grid_map::GridMap>, filters::RoughnessFilter<grid_map::GridMap>,
+                          filters::WeightedSumFilter<grid_map::GridMap>>
+      stages;
+
+  //! Layers removed after the stages, from the deletion filters of the configuration.
+  std::vector<std::string> deletedLayers;
+};
+
+const std::array<std::string, 5> TraversabilityMap::StaticFilterPipeline::stageTypes{
+    {"traversabilityFilters/SurfaceNormalsFilter", "traversabilityFilters/SlopeFilter", "traversabilityFilters/StepFilter",
+     "traversabilityFilters/RoughnessFilter", "traversabilityFilters/WeightedSumFilter"}};
+#else
+struct TraversabilityMap::StaticFilterPipeline {};
+#endif
+
+struct TraversabilityMap::PublishingQueue {
+  ros::Publisher publisher;
+  std::mutex mutex;
+  //! Map waiting for publication and its height, replaced by a newer map.
+  std::unique_ptr<grid_map::GridMap> map;
+  double zPosition = 0.0;
+  //! If a task publishes the waiting maps.
+  bool isPublishing = false;
+};
+
 TraversabilityMap::TraversabilityMap(ros::NodeHandle& nodeHandle)
     : nodeHandle_(nodeHandle),
+      publishUntraversablePolygons_(false),
+      untraversablePolygonsTolerance_(0.05),
+      checkRobotInclination_(false),
       traversabilityType_("traversability"),
       slopeType_("traversability_slope"),
       stepType_("traversability_step"),
       roughnessType_("traversability_roughness"),
       robotSlopeType_("robot_slope"),
+      clearanceType_("clearance"),
+      costToGoType_("cost_to_go"),
+      traversableComponentType_("traversable_component"),
+      precomputeClearance_(false),
+      useTiledLayers_(false),
+      tiledLayersValid_(false),
+      circularFootprintRadius_(0.0),
+      clearancePreCheck_(true),
+      isRiskVariantActive_(false),
+      footprintInscribedRadius_(0.0),
+      footprintCircumscribedRadius_(0.0),
+      computeCostToGo_(false),
+      costToGoTraversabilityWeight_(1.0),
+      motionPrimitiveTraversabilityWeight_(1.0),
+      computeTraversableComponents_(false),
+      traversableComponents_(traversableComponentType_),
+      robotPositionInitialized_(false),
       filter_chain_("grid_map::GridMap"),
-      zPosition_(0),
-      elevationMapInitialized_(false),
+      publishingQueue_(std::make_shared<PublishingQueue>()),
       traversabilityMapInitialized_(false),
-      checkForRoughness_(false),
-      checkRobotInclination_(false) {
+      mapGeneration_(0),
+      elevationMapInitialized_(false),
+      maxFootprintRadius_(0.0),
+      clearanceExactDistance_(std::numeric_limits<double>::infinity()),
+      tiledLayersEvicted_(false),
+      warmedFootprintRadius_(0.0),
+      zPosition_(0) {
   ROS_INFO("Traversability Map started.");
+  filterCheckParameters_.stepType = stepType_;
+  filterCheckParameters_.slopeType = slopeType_;
+  filterCheckParameters_.roughnessType = roughnessType_;
 
   readParameters();
+
+  // Derived layers which are rebuilt on demand can be evicted to stay within the memory budget.
+  std::vector<std::string> suffixes(riskVariantSuffixes.begin(), riskVariantSuffixes.end());
+  suffixes.emplace_back();
+  for (const auto& suffix : suffixes) {
+    for (const std::string layer : {"traversability_footprint", "step_footprint", "slope_footprint", "roughness_footprint"}) {
+      memoryBudget_.setEvictable(layer + suffix);
+    }
+  }
+  memoryBudget_.setEvictable(clearanceType_);
+  memoryBudget_.setEvictable("traversability_x");
+  memoryBudget_.setEvictable("traversability_rot");
+  memoryBudget_.setEvictable("tiled_layers");
+  diagnosticUpdater_.setHardwareID("none");
+  diagnosticUpdater_.add("Traversability map memory", this, &TraversabilityMap::produceMemoryDiagnostics);
+  diagnosticUpdater_.add("Thread pool", this, &TraversabilityMap::produceThreadPoolDiagnostics);
   traversabilityMapPublisher_ = nodeHandle_.advertise<grid_map_msgs::GridMap>("traversability_map", 1, true);
+  publishingQueue_->publisher = traversabilityMapPublisher_;
   footprintPublisher_ = nodeHandle_.advertise<geometry_msgs::PolygonStamped>("footprint_polygon", 1, true);
   untraversablePolygonPublisher_ = nodeHandle_.advertise<geometry_msgs::PolygonStamped>("untraversable_polygon", 1, true);
+  untraversablePolygonsPublisher_ = nodeHandle_.advertise<traversability_msgs::UntraversablePolygons>("untraversable_polygons", 1, true);
+  cacheWarming_.start([this](grid_map::GridMap& geometry, uint64_t& generation) { return prepareCacheWarming(geometry, generation); },
+                      [this](const std::vector<grid_map::Index>& cells, const uint64_t generation) { return warmCells(cells, generation); });
 }
 
-TraversabilityMap::~TraversabilityMap() { nodeHandle_.shutdown(); }
+TraversabilityMap::~TraversabilityMap() {
+  cacheWarming_.stop();
+  nodeHandle_.shutdown();
+}
 
 bool TraversabilityMap::createLayers(bool useRawMap) {
   boost::recursive_mutex::scoped_lock scopedLockForElevationMap(elevationMapMutex_);
@@ -110,9 +228,67 @@ bool TraversabilityMap::readParameters() {
   // Safety check
   traversabilityDefaultReadAtInit_ = boundTraversabilityValue(traversabilityDefaultReadAtInit_);
   setDefaultTraversabilityUnknownRegions(traversabilityDefaultReadAtInit_);
-  checkForRoughness_ = param_io::param(nodeHandle_, "footprint/verify_roughness_footprint", false);
+  filterCheckParameters_.checkForRoughness = param_io::param(nodeHandle_, "footprint/verify_roughness_footprint", false);
   checkRobotInclination_ = param_io::param(nodeHandle_, "footprint/check_robot_inclination", false);
-  maxGapWidth_ = param_io::param(nodeHandle_, "max_gap_width", 0.3);
+  filterCheckParameters_.maxGapWidth = param_io::param(nodeHandle_, "max_gap_width", 0.3);
+  precomputeClearance_ = param_io::param(nodeHandle_, "precompute_clearance", false);
+  useTiledLayers_ = param_io::param(nodeHandle_, "tiled_layers", false);
+  circularFootprintRadius_ = param_io::param(nodeHandle_, "footprint/circular_footprint_radius", 0.0);
+  clearancePreCheck_ = param_io::param(nodeHandle_, "footprint/clearance_pre_check", true);
+  cacheWarming_.setParameters(param_io::param<bool>(nodeHandle_, "cache_warming/enable", false),
+                             param_io::param(nodeHandle_, "cache_warming/corridor_radius", 0.5),
+                             param_io::param(nodeHandle_, "cache_warming/nice", 19));
+  maxFootprintRadius_ = circularFootprintRadius_;
+  if (!footprintPoints_.empty()) {
+    // The circles are only conservative if they are inscribed in and circumscribe the footprint polygon.
+    double inscribedRadius, circumscribedRadius;
+    computeFootprintRadii(footprintPoints_, inscribedRadius, circumscribedRadius);
+    footprintInscribedRadius_ = param_io::param(nodeHandle_, "footprint/circular_footprint_radius_inscribed", inscribedRadius);
+    footprintCircumscribedRadius_ = param_io::param(nodeHandle_, "footprint/circular_footprint_radius", circumscribedRadius);
+    if (footprintInscribedRadius_ > inscribedRadius) {
+      ROS_WARN("Traversability Map: Inscribed footprint radius (%f) exceeds the footprint polygon, using %f.", footprintInscribedRadius_,
+               inscribedRadius);
+      footprintInscribedRadius_ = inscribedRadius;
+    }
+    if (footprintCircumscribedRadius_ < circumscribedRadius) {
+      ROS_WARN("Traversability Map: Circular footprint radius (%f) does not enclose the footprint polygon, using %f.",
+               footprintCircumscribedRadius_, circumscribedRadius);
+      footprintCircumscribedRadius_ = circumscribedRadius;
+    }
+    maxFootprintRadius_ = std::max(maxFootprintRadius_, footprintCircumscribedRadius_);
+  }
+  computeCostToGo_ = param_io::param(nodeHandle_, "cost_to_go/enable", false);
+  costToGoTraversabilityWeight_ = param_io::param(nodeHandle_, "cost_to_go/traversability_weight", 1.0);
+  if (!(costToGoTraversabilityWeight_ >= 0.0 && costToGoTraversabilityWeight_ <= maxTraversabilityWeight)) {
+    ROS_WARN("Traversability Map: Cost-to-go traversability weight (%f) is not within [0.0, %f], using 1.0.", costToGoTraversabilityWeight_,
+             maxTraversabilityWeight);
+    costToGoTraversabilityWeight_ = 1.0;
+  }
+  motionPrimitiveTraversabilityWeight_ = param_io::param(nodeHandle_, "motion_primitives/traversability_weight", 1.0);
+  if (!(motionPrimitiveTraversabilityWeight_ >= 0.0 && motionPrimitiveTraversabilityWeight_ <= maxTraversabilityWeight)) {
+    ROS_WARN("Traversability Map: Motion primitive traversability weight (%f) is not within [0.0, %f], using 1.0.",
+             motionPrimitiveTraversabilityWeight_, maxTraversabilityWeight);
+    motionPrimitiveTraversabilityWeight_ = 1.0;
+  }
+  computeTraversableComponents_ = param_io::param(nodeHandle_, "traversable_components/enable", false);
+  publishUntraversablePolygons_ = param_io::param(nodeHandle_, "untraversable_polygons/enable", false);
+  untraversablePolygonsTolerance_ = param_io::param(nodeHandle_, "untraversable_polygons/simplification_tolerance", 0.05);
+  sessions_.setTimeouts(param_io::param(nodeHandle_, "sessions/default_timeout", 1.0),
+                        param_io::param(nodeHandle_, "sessions/max_timeout", 10.0));
+  segmentCache_.setResolution(param_io::param(nodeHandle_, "segment_cache/position_resolution", 0.001),
+                              param_io::param(nodeHandle_, "segment_cache/orientation_resolution", 0.001));
+  segmentCache_.setMaxSize(static_cast<size_t>(std::max(param_io::param(nodeHandle_, "segment_cache/max_size", 100000), 0)));
+  memoryBudget_.setBudget(static_cast<size_t>(std::max(param_io::param(nodeHandle_, "memory_budget", 0.0), 0.0) * 1e6));
+  const std::string footprintCacheBackendName = param_io::param<std::string>(nodeHandle_, "footprint_cache/backend", "auto");
+  FootprintCaches::Backend footprintCacheBackend = FootprintCaches::Backend::Auto;
+  if (footprintCacheBackendName == "dense") {
+    footprintCacheBackend = FootprintCaches::Backend::Dense;
+  } else if (footprintCacheBackendName == "sparse") {
+    footprintCacheBackend = FootprintCaches::Backend::Sparse;
+  } else if (footprintCacheBackendName != "auto") {
+    ROS_WARN("Traversability Map: Unknown footprint cache backend '%s', using 'auto'.", footprintCacheBackendName.c_str());
+  }
+  footprintCaches_.setBackend(footprintCacheBackend, param_io::param(nodeHandle_, "footprint_cache/sparse_density", 0.05));
 
   XmlRpc::XmlRpcValue filterParameter;
   bool filterParamsAvailable = param_io::getParam(nodeHandle_, "traversability_map_filters", filterParameter);
@@ -120,39 +296,315 @@ bool TraversabilityMap::readParameters() {
     ROS_ASSERT(filterParameter.getType() == XmlRpc::XmlRpcValue::TypeArray);
     for (int index = 0; index < filterParameter.size(); index++) {
       if (filterParameter[index]["name"] == "stepFilter") {
-        criticalStepHeight_ = (double)filterParameter[index]["params"]["critical_value"];
+        filterCheckParameters_.criticalStepHeight = (double)filterParameter[index]["params"]["critical_value"];
       }
     }
   }
 
+  // Configure the thread pool of the node.
+  const unsigned int nCores = std::thread::hardware_concurrency();
+  const int nThreads = param_io::param(nodeHandle_, "thread_pool/threads", -1);
+  filters::ThreadPool::getInstance().configure(nThreads >= 0 ? nThreads : (nCores > 1 ? nCores - 1 : 0),
+                                               param_io::param(nodeHandle_, "thread_pool/cpus", std::vector<int>()),
+                                               param_io::param(nodeHandle_, "thread_pool/priority", 0),
+                                               param_io::param(nodeHandle_, "thread_pool/nice", 0));
+
+  // Select the kernels of the filters, the best variant supported by the CPU unless forced.
+  if (!filters::setSimdVariant(param_io::param<std::string>(nodeHandle_, "simd_variant", "auto"))) filters::setSimdVariant("auto");
+
+  configureFilters();
+  return true;
+}
+
+bool TraversabilityMap::configureFilters() {
+  const ros::WallTime start = ros::WallTime::now();
+  staticFilterPipeline_.reset();
+  const std::string filterPipeline = param_io::param<std::string>(nodeHandle_, "filter_pipeline", "plugins");
+  if (filterPipeline == "static") {
+    XmlRpc::XmlRpcValue config;
+    if (param_io::getParam(nodeHandle_, "traversability_map_filters", config) && configureStaticFilterPipeline(config)) {
+      ROS_INFO("Traversability Map: Static filter pipeline configured in %f s.", (ros::WallTime::now() - start).toSec());
+      return true;
+    }
+    ROS_WARN("Traversability Map: Using the filter chain instead of the static filter pipeline.");
+  } else if (filterPipeline != "plugins") {
+    ROS_WARN("Traversability Map: Unknown filter pipeline '%s', using 'plugins'.", filterPipeline.c_str());
+  }
+
   // Configure filter chain
   if (!filter_chain_.configure("traversability_map_filters", nodeHandle_)) {
     ROS_ERROR("Could not configure the filter chain!");
+    return false;
   }
+  ROS_INFO("Traversability Map: Filter chain configured in %f s.", (ros::WallTime::now() - start).toSec());
   return true;
 }
 
-bool TraversabilityMap::setElevationMap(const grid_map_msgs::GridMap& msg) {
-  if (getMapFrameId() != msg.info.header.frame_id) {
-    ROS_ERROR("Received elevation map has frame_id = '%s', but an elevation map with frame_id = '%s' is expected.",
-              msg.info.header.frame_id.c_str(), getMapFrameId().c_str());
+bool TraversabilityMap::configureStaticFilterPipeline(XmlRpc::XmlRpcValue& config) {
+#ifdef TRAVERSABILITY_STATIC_FILTER_PIPELINE
+  if (config.getType() != XmlRpc::XmlRpcValue::TypeArray) return false;
+  const auto& stageTypes = StaticFilterPipeline::stageTypes;
+  std::unique_ptr<StaticFilterPipeline> pipeline(new StaticFilterPipeline);
+  XmlRpc::XmlRpcValue stagesConfig;
+  for (int index = 0; index < config.size(); index++) {
+    const std::string type = static_cast<std::string>(config[index]["type"]);
+    if (index < static_cast<int>(stageTypes.size())) {
+      if (type != stageTypes[index]) {
+        ROS_WARN("Traversability Map: Filter %i is of type '%s', the static filter pipeline expects '%s'.", index, type.c_str(),
+                 stageTypes[index].c_str());
+        return false;
+      }
+      stagesConfig[index] = config[index];
+    } else if (type == "gridMapFilters/DeletionFilter") {
+      XmlRpc::XmlRpcValue& layers = config[index]["params"]["layers"];
+      for (int layer = 0; layer < layers.size(); layer++) pipeline->deletedLayers.push_back(static_cast<std::string>(layers[layer]));
+    } else {
+      ROS_WARN("Traversability Map: Filter %i of type '%s' is not part of the static filter pipeline.", index, type.c_str());
+      return false;
+    }
+  }
+  if (config.size() < static_cast<int>(stageTypes.size())) {
+    ROS_WARN("Traversability Map: The static filter pipeline needs %zu filters, %i are configured.", stageTypes.size(), config.size());
     return false;
   }
+  if (!pipeline->stages.configure(stagesConfig)) {
+    ROS_ERROR("Traversability Map: Could not configure the static filter pipeline!");
+    return false;
+  }
+  staticFilterPipeline_ = std::move(pipeline);
+  return true;
+#else
+  ROS_WARN("Traversability Map: The static filter pipeline is not compiled in (CMake option STATIC_FILTER_PIPELINE).");
+  return false;
+#endif
+}
+
+bool TraversabilityMap::updateFilters(grid_map::GridMap& elevationMap, grid_map::GridMap& traversabilityMap) {
+#ifdef TRAVERSABILITY_STATIC_FILTER_PIPELINE
+  if (staticFilterPipeline_) {
+    // The stages run in place on the elevation map, which then becomes the traversability map.
+    if (!staticFilterPipeline_->stages.update(elevationMap)) return false;
+    for (const auto& layer : staticFilterPipeline_->deletedLayers) {
+      if (elevationMap.exists(layer)) elevationMap.erase(layer);
+    }
+    traversabilityMap = std::move(elevationMap);
+    return true;
+  }
+#endif
+  return filter_chain_.update(elevationMap, traversabilityMap);
+}
+
+bool TraversabilityMap::setElevationMap(const grid_map_msgs::GridMap& msg) {
   grid_map::GridMap elevationMap;
   grid_map::GridMapRosConverter::fromMessage(msg, elevationMap);
+  return setElevationMap(elevationMap, msg.info.pose.position.z);
+}
+
+bool TraversabilityMap::setElevationMap(const grid_map::GridMap& elevationMap, const double zPosition) {
+  if (getMapFrameId() != elevationMap.getFrameId()) {
+    ROS_ERROR("Received elevation map has frame_id = '%s', but an elevation map with frame_id = '%s' is expected.",
+              elevationMap.getFrameId().c_str(), getMapFrameId().c_str());
+    return false;
+  }
   boost::recursive_mutex::scoped_lock scopedLockForElevationMap(elevationMapMutex_);
-  zPosition_ = msg.info.pose.position.z;
   for (auto& layer : elevationMapLayers_) {
     if (!elevationMap.exists(layer)) {
       ROS_WARN("Traversability Map: Can't set elevation map because there is no layer %s.", layer.c_str());
       return false;
     }
   }
+  zPosition_ = zPosition;
   elevationMap_ = elevationMap;
   elevationMapInitialized_ = true;
   return true;
 }
 
+bool TraversabilityMap::openSession(const double timeout, unsigned int& session, uint64_t& generation) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (!traversabilityMapInitialized_) {
+    ROS_WARN("Traversability Estimation: open session: Traversability map not yet initialized.");
+    return false;
+  }
+  // The snapshot does not contain the regions which have expired by now.
+  updateOverlay();
+  expireSessions();
+  session = sessions_.open(timeout, mapGeneration_, overlay_.getVersion(), overlay_);
+  generation = mapGeneration_;
+  return true;
+}
+
+bool TraversabilityMap::closeSession(const unsigned int session) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  const bool isOpen = sessions_.close(session);
+  expireSessions();
+  return isOpen;
+}
+
+bool TraversabilityMap::getTraversabilityMap(const unsigned int session, grid_map::GridMap& map) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (session == 0) {
+    map = traversabilityMap_;
+    return true;
+  }
+  const MapSessions::Snapshot* snapshot = useSession(session);
+  if (snapshot == nullptr) return false;
+  map = snapshot->generation == mapGeneration_ ? traversabilityMap_ : sessions_.getRetainedMap(snapshot->generation);
+  return true;
+}
+
+MapSessions::Snapshot* TraversabilityMap::useSession(const unsigned int session) {
+  expireSessions();
+  MapSessions::Snapshot* snapshot = sessions_.use(session);
+  if (snapshot == nullptr) ROS_WARN("Traversability Estimation: Session %u is not open or has expired.", session);
+  return snapshot;
+}
+
+void TraversabilityMap::expireSessions() {
+  std::vector<std::pair<uint64_t, uint64_t>> removedSnapshots;
+  sessions_.expire(removedSnapshots);
+  for (const auto& snapshot : removedSnapshots) segmentCache_.remove(snapshot.first, snapshot.second);
+}
+
+void TraversabilityMap::replaceTraversabilityMap(grid_map::GridMap& traversabilityMap) {
+  // The footprint caches of the new map are stored sparsely if only few cells of the replaced map were queried.
+  const bool useSparseFootprintCaches = footprintCaches_.shouldUseSparse(traversabilityMap_);
+  // The replaced map is moved into the retained maps if a session reads it, such that it is never copied.
+  expireSessions();
+  if (sessions_.isPinned(mapGeneration_)) {
+    // The snapshots keep their own caches and clearance, drop the ones derived with the latest overlay.
+    if (traversabilityMap_.exists(clearanceType_)) traversabilityMap_.erase(clearanceType_);
+    for (const auto& layer : FootprintCaches::layers) {
+      if (traversabilityMap_.exists(layer)) traversabilityMap_.erase(layer);
+      for (const auto& suffix : riskVariantSuffixes) {
+        if (traversabilityMap_.exists(layer + suffix)) traversabilityMap_.erase(layer + suffix);
+      }
+    }
+    sessions_.retain(mapGeneration_, traversabilityMap_);
+  }
+  segmentCache_.remove(mapGeneration_, 0);
+  traversabilityMap_ = std::move(traversabilityMap);
+  mapGeneration_++;
+  traversableComponents_.invalidate();
+  std::vector<std::string> denseFootprintLayers{"step_footprint", "slope_footprint", "traversability_footprint"};
+  if (filterCheckParameters_.checkForRoughness) denseFootprintLayers.push_back("roughness_footprint");
+  footprintCaches_.reset(traversabilityMap_, useSparseFootprintCaches, denseFootprintLayers);
+  // Footprint caches of the risk variants, for the filter layers which have variants.
+  const std::vector<std::pair<std::string, std::string>> footprintLayers{{"traversability_footprint", traversabilityType_},
+                                                                         {"step_footprint", stepType_},
+                                                                         {"slope_footprint", slopeType_},
+                                                                         {"roughness_footprint", roughnessType_}};
+  for (const auto& suffix : riskVariantSuffixes) {
+    for (const auto& footprintLayer : footprintLayers) {
+      if (traversabilityMap_.exists(footprintLayer.first) && traversabilityMap_.exists(footprintLayer.second + suffix)) {
+        traversabilityMap_.add(footprintLayer.first + suffix);
+      } else if (traversabilityMap_.exists(footprintLayer.first + suffix)) {
+        traversabilityMap_.erase(footprintLayer.first + suffix);
+      }
+    }
+  }
+  overlay_.setGeometry(traversabilityMap_);
+  updateTiledLayers();
+  tiledLayersEvicted_ = false;
+}
+
+void TraversabilityMap::updateTiledLayers() {
+  tiledLayersValid_ = false;
+  std::vector<std::pair<TiledLayer*, std::string>> layers{
+      {&tiledTraversability_, traversabilityType_}, {&tiledStep_, stepType_}, {&tiledElevation_, "elevation"}};
+  for (auto& layer : layers) {
+    if (useTiledLayers_ && traversabilityMap_.exists(layer.second)) {
+      layer.first->fromMatrix(traversabilityMap_[layer.second]);
+    } else {
+      layer.first->clear();
+    }
+  }
+  tiledLayersValid_ = useTiledLayers_ && traversabilityMap_.exists(traversabilityType_) && traversabilityMap_.exists(stepType_) &&
+                      traversabilityMap_.exists("elevation");
+}
+
+void TraversabilityMap::getMemoryUsage(std::map<std::string, size_t>& usage) const {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  usage.clear();
+  for (const auto& layer : traversabilityMap_.getLayers()) {
+    usage[layer] = static_cast<size_t>(traversabilityMap_[layer].size()) * sizeof(float);
+  }
+  size_t tiledLayersSize = 0;
+  for (const TiledLayer* tiledLayer : {&tiledTraversability_, &tiledStep_, &tiledElevation_}) {
+    tiledLayersSize += tiledLayer->getMemorySize();
+  }
+  usage["tiled_layers"] = tiledLayersSize;
+  footprintCaches_.addMemoryUsage(usage);
+  usage["retained_maps"] = sessions_.getMemorySize();
+}
+
+void TraversabilityMap::enforceMemoryBudget() {
+  if (memoryBudget_.getBudget() > 0) {
+    boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+    std::map<std::string, size_t> usage;
+    getMemoryUsage(usage);
+    memoryBudget_.enforce(usage, [this](const std::string& layer) {
+      if (layer == "tiled_layers") {
+        for (TiledLayer* tiledLayer : {&tiledTraversability_, &tiledStep_, &tiledElevation_}) {
+          tiledLayer->clear();
+        }
+        tiledLayersValid_ = false;
+        tiledLayersEvicted_ = useTiledLayers_;
+      } else {
+        traversabilityMap_.erase(layer);
+        footprintCaches_.eraseSparseCache(layer);
+        if (layer == clearanceType_) clearanceExactDistance_ = std::numeric_limits<double>::infinity();
+      }
+    });
+  }
+  diagnosticUpdater_.update();
+}
+
+void TraversabilityMap::ensureLayer(const std::string& layer) {
+  memoryBudget_.touch(layer);
+  if (!traversabilityMap_.exists(layer)) traversabilityMap_.add(layer);
+}
+
+void TraversabilityMap::ensureFootprintLayers() {
+  ensureFootprintCache("traversability_footprint");
+  ensureFootprintCache("step_footprint");
+  ensureFootprintCache("slope_footprint");
+  if (filterCheckParameters_.checkForRoughness) ensureFootprintCache("roughness_footprint");
+}
+
+void TraversabilityMap::ensureFootprintCache(const std::string& layer) {
+  memoryBudget_.touch(layer);
+  footprintCaches_.ensure(traversabilityMap_, layer);
+}
+
+float TraversabilityMap::getFootprintCache(const std::string& layer, const grid_map::Index& index) {
+  return getFilterChecks().getFootprintCache(layer, index);
+}
+
+void TraversabilityMap::setFootprintCache(const std::string& layer, const grid_map::Index& index, const float value) {
+  getFilterChecks().setFootprintCache(layer, index, value);
+}
+
+void TraversabilityMap::useDenseFootprintCaches() {
+  if (!footprintCaches_.isSparse()) return;
+  footprintCaches_.useDense(traversabilityMap_);
+  ensureFootprintLayers();
+}
+
+void TraversabilityMap::produceMemoryDiagnostics(diagnostic_updater::DiagnosticStatusWrapper& status) {
+  std::map<std::string, size_t> usage;
+  getMemoryUsage(usage);
+  memoryBudget_.produceDiagnostics(usage, status);
+}
+
+void TraversabilityMap::produceThreadPoolDiagnostics(diagnostic_updater::DiagnosticStatusWrapper& status) {
+  const filters::ThreadPool::Metrics metrics = filters::ThreadPool::getInstance().getMetrics();
+  status.summaryf(diagnostic_msgs::DiagnosticStatus::OK, "%zu threads, %zu queued tasks.", metrics.nThreads, metrics.queueDepth);
+  status.add("threads", metrics.nThreads);
+  status.add("queued tasks", metrics.queueDepth);
+  status.add("tasks run", metrics.nTasks);
+  status.add("steals", metrics.nSteals);
+}
+
 bool TraversabilityMap::setTraversabilityMap(const grid_map_msgs::GridMap& msg) {
   grid_map::GridMap traversabilityMap;
   grid_map::GridMapRosConverter::fromMessage(msg, traversabilityMap);
@@ -164,25 +616,79 @@ bool TraversabilityMap::setTraversabilityMap(const grid_map_msgs::GridMap& msg)
       return false;
     }
   }
-  traversabilityMap_ = traversabilityMap;
+  // Whole-map computations (e.g. clearance) assume that map and buffer indices coincide.
+  traversabilityMap.convertToDefaultStartIndex();
+  replaceTraversabilityMap(traversabilityMap);
   traversabilityMapInitialized_ = true;
   return true;
 }
 
 void TraversabilityMap::publishTraversabilityMap() {
   if (!traversabilityMapPublisher_.getNumSubscribers() < 1) {
-    grid_map_msgs::GridMap mapMessage;
     boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-    grid_map::GridMap traversabilityMapCopy = traversabilityMap_;
+    std::unique_ptr<grid_map::GridMap> map(new grid_map::GridMap(traversabilityMap_));
     scopedLockForTraversabilityMap.unlock();
-    if (traversabilityMapCopy.exists("upper_bound") && traversabilityMapCopy.exists("lower_bound")) {
-      traversabilityMapCopy.add("uncertainty_range", traversabilityMapCopy.get("upper_bound") - traversabilityMapCopy.get("lower_bound"));
+    // Serialize and publish in the thread pool, one map at a time such that the maps are published in order. A
+    // map still waiting is replaced. The task does not access this object.
+    const std::shared_ptr<PublishingQueue> queue = publishingQueue_;
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->map = std::move(map);
+      queue->zPosition = zPosition_;
+      if (queue->isPublishing) return;
+      queue->isPublishing = true;
     }
+    filters::ThreadPool::getInstance().submit([queue]() {
+      std::unique_lock<std::mutex> lock(queue->mutex);
+      while (queue->map) {
+        const std::unique_ptr<grid_map::GridMap> map = std::move(queue->map);
+        const double zPosition = queue->zPosition;
+        lock.unlock();
+        if (map->exists("upper_bound") && map->exists("lower_bound")) {
+          map->add("uncertainty_range", map->get("upper_bound") - map->get("lower_bound"));
+        }
+        grid_map_msgs::GridMap mapMessage;
+        grid_map::GridMapRosConverter::toMessage(*map, mapMessage);
+        mapMessage.info.pose.position.z = zPosition;
+        queue->publisher.publish(mapMessage);
+        lock.lock();
+      }
+      queue->isPublishing = false;
+    });
+  }
+}
+
+void TraversabilityMap::publishUntraversablePolygons() {
+  if (untraversablePolygonsPublisher_.getNumSubscribers() < 1) return;
+  // Computes a missing clearance without the lock, the second call only recomputes it if the map changed meanwhile.
+  if (!ensureClearance(0.0)) return;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (!ensureClearance(0.0)) return;
+  const BinaryMatrix isUntraversable = (traversabilityMap_[clearanceType_].array() <= 0.0).matrix();
+  traversability_msgs::UntraversablePolygons message;
+  message.header.frame_id = getMapFrameId();
+  message.header.stamp.fromNSec(traversabilityMap_.getTimestamp());
+  message.map_generation = mapGeneration_;
+  // Index coordinates map linearly to positions, starting at the center of the first cell.
+  grid_map::Position origin;
+  traversabilityMap_.getPosition(grid_map::Index(0, 0), origin);
+  const double resolution = traversabilityMap_.getResolution();
+  scopedLockForTraversabilityMap.unlock();
 
-    grid_map::GridMapRosConverter::toMessage(traversabilityMapCopy, mapMessage);
-    mapMessage.info.pose.position.z = zPosition_;
-    traversabilityMapPublisher_.publish(mapMessage);
+  std::vector<Contour> contours;
+  extractContours(isUntraversable, contours);
+  for (const auto& contour : contours) {
+    geometry_msgs::Polygon polygon;
+    for (const auto& vertex : simplifyContour(contour, untraversablePolygonsTolerance_ / resolution)) {
+      geometry_msgs::Point32 point;
+      point.x = origin.x() - resolution * vertex.x();
+      point.y = origin.y() - resolution * vertex.y();
+      point.z = zPosition_;
+      polygon.points.push_back(point);
+    }
+    message.polygons.push_back(polygon);
   }
+  untraversablePolygonsPublisher_.publish(message);
 }
 
 grid_map::GridMap TraversabilityMap::getTraversabilityMap() {
@@ -192,11 +698,18 @@ grid_map::GridMap TraversabilityMap::getTraversabilityMap() {
 
 bool TraversabilityMap::traversabilityMapInitialized() { return traversabilityMapInitialized_; }
 
+uint64_t TraversabilityMap::getMapGeneration() const {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  return mapGeneration_;
+}
+
 void TraversabilityMap::resetTraversabilityFootprintLayers() {
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  if (traversabilityMap_.exists("step_footprint")) traversabilityMap_.clear("step_footprint");
-  if (traversabilityMap_.exists("slope_footprint")) traversabilityMap_.clear("slope_footprint");
-  if (traversabilityMap_.exists("traversability_footprint")) traversabilityMap_.clear("traversability_footprint");
+  std::vector<std::string> layers{"step_footprint", "slope_footprint", "traversability_footprint"};
+  for (const auto& suffix : riskVariantSuffixes) {
+    for (const std::string layer : {"step_footprint", "traversability_footprint"}) layers.push_back(layer + suffix);
+  }
+  for (const auto& layer : layers) footprintCaches_.clear(traversabilityMap_, layer);
 }
 
 bool TraversabilityMap::computeTraversability() {
@@ -211,26 +724,31 @@ bool TraversabilityMap::computeTraversability() {
   ros::WallTime start = ros::WallTime::now();
 
   if (elevationMapInitialized_) {
-    if (!filter_chain_.update(elevationMapCopy, traversabilityMapCopy)) {
+    if (!updateFilters(elevationMapCopy, traversabilityMapCopy)) {
       ROS_ERROR("Traversability Estimation: Could not update the filter chain! No traversability computed!");
       traversabilityMapInitialized_ = false;
       return false;
     }
+    ROS_DEBUG("Traversability filters have been updated in %f s.", (ros::WallTime::now() - start).toSec());
   } else {
     ROS_ERROR("Traversability Estimation: Elevation map is not initialized!");
     traversabilityMapInitialized_ = false;
     return false;
   }
   traversabilityMapInitialized_ = true;
-  traversabilityMapCopy.add("step_footprint");
-  traversabilityMapCopy.add("slope_footprint");
-  if (checkForRoughness_) traversabilityMapCopy.add("roughness_footprint");
-  traversabilityMapCopy.add("traversability_footprint");
+  // Whole-map computations (e.g. clearance) assume that map and buffer indices coincide.
+  traversabilityMapCopy.convertToDefaultStartIndex();
 
   scopedLockForTraversabilityMap.lock();
-  traversabilityMap_ = traversabilityMapCopy;
+  replaceTraversabilityMap(traversabilityMapCopy);
   scopedLockForTraversabilityMap.unlock();
+  // The clearance is computed without the lock, the layers derived from it take it.
+  if (precomputeClearance_) computeClearance();
+  if (computeCostToGo_) computeCostToGoFromRobot();
+  if (computeTraversableComponents_) computeTraversableComponents();
+  enforceMemoryBudget();
   publishTraversabilityMap();
+  if (publishUntraversablePolygons_) publishUntraversablePolygons();
 
   ROS_DEBUG("Traversability map has been updated in %f s.", (ros::WallTime::now() - start).toSec());
   return true;
@@ -243,11 +761,13 @@ bool TraversabilityMap::traversabilityFootprint(double footprintYaw) {
   ros::WallTime start = ros::WallTime::now();
 
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  // All cells are checked, which is what the dense caches are for.
+  useDenseFootprintCaches();
+  ensureFootprintLayers();
   traversabilityMap_.add("traversability_x");
   traversabilityMap_.add("traversability_rot");
-
-  grid_map::Position position;
-  grid_map::Polygon polygonX, polygonRot;
+  memoryBudget_.touch("traversability_x");
+  memoryBudget_.touch("traversability_rot");
 
   ROS_DEBUG_STREAM("footprint yaw: " << footprintYaw);
   // Compute Orientation
@@ -257,47 +777,54 @@ bool TraversabilityMap::traversabilityFootprint(double footprintYaw) {
   Eigen::Quaterniond orientationX = xquat.toImplementation();
   Eigen::Quaterniond orientationRot = rquat.toImplementation();
 
-  for (grid_map::GridMapIterator iterator(traversabilityMap_); !iterator.isPastEnd(); ++iterator) {
-    polygonX.removeVertices();
-    polygonRot.removeVertices();
-    traversabilityMap_.getPosition(*iterator, position);
-
-    grid_map::Position3 positionToVertex, positionToVertexTransformedX, positionToVertexTransformedRot;
-    Eigen::Translation<double, 3> toPosition;
-    Eigen::Quaterniond orientation;
-
-    toPosition.x() = position.x();
-    toPosition.y() = position.y();
-    toPosition.z() = 0.0;
+  // The cells are checked first, then each footprint only reads the results and writes its own cell. Neither
+  // takes the lock, which is held by this thread.
+  BinaryMatrix isUntraversable;
+  grid_map::Matrix cellTraversability;
+  checkAllCells(isUntraversable, cellTraversability);
+  grid_map::Matrix& traversabilityX = traversabilityMap_["traversability_x"];
+  grid_map::Matrix& traversabilityRot = traversabilityMap_["traversability_rot"];
+  const grid_map::Size size = traversabilityMap_.getSize();
+  filters::ThreadPool::getInstance().parallelFor(0, size(1), 8, [&](const int columnBegin, const int columnEnd) {
+    grid_map::Position position;
+    grid_map::Polygon polygonX, polygonRot;
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        polygonX.removeVertices();
+        polygonRot.removeVertices();
+        traversabilityMap_.getPosition(grid_map::Index(i, j), position);
+
+        grid_map::Position3 positionToVertex, positionToVertexTransformedX, positionToVertexTransformedRot;
+        Eigen::Translation<double, 3> toPosition;
+
+        toPosition.x() = position.x();
+        toPosition.y() = position.y();
+        toPosition.z() = 0.0;
+
+        for (const auto& point : footprintPoints_) {
+          positionToVertex.x() = point.x;
+          positionToVertex.y() = point.y;
+          positionToVertex.z() = point.z;
+          positionToVertexTransformedX = toPosition * orientationX * positionToVertex;
+          positionToVertexTransformedRot = toPosition * orientationRot * positionToVertex;
+
+          grid_map::Position vertexX, vertexRot;
+          vertexX.x() = positionToVertexTransformedX.x();
+          vertexRot.x() = positionToVertexTransformedRot.x();
+          vertexX.y() = positionToVertexTransformedX.y();
+          vertexRot.y() = positionToVertexTransformedRot.y();
+          polygonX.addVertex(vertexX);
+          polygonRot.addVertex(vertexRot);
+        }
 
-    for (const auto& point : footprintPoints_) {
-      positionToVertex.x() = point.x;
-      positionToVertex.y() = point.y;
-      positionToVertex.z() = point.z;
-      positionToVertexTransformedX = toPosition * orientationX * positionToVertex;
-      positionToVertexTransformedRot = toPosition * orientationRot * positionToVertex;
-
-      grid_map::Position vertexX, vertexRot;
-      vertexX.x() = positionToVertexTransformedX.x();
-      vertexRot.x() = positionToVertexTransformedRot.x();
-      vertexX.y() = positionToVertexTransformedX.y();
-      vertexRot.y() = positionToVertexTransformedRot.y();
-      polygonX.addVertex(vertexX);
-      polygonRot.addVertex(vertexRot);
-    }
-
-    double traversability;
-    if (isTraversable(polygonX, traversability))
-      traversabilityMap_.at("traversability_x", *iterator) = traversability;
-    else
-      traversabilityMap_.at("traversability_x", *iterator) = 0.0;
-    if (isTraversable(polygonRot, traversability))
-      traversabilityMap_.at("traversability_rot", *iterator) = traversability;
-    else
-      traversabilityMap_.at("traversability_rot", *iterator) = 0.0;
-  }
+        traversabilityX(i, j) = getPolygonTraversability(polygonX, isUntraversable, cellTraversability);
+        traversabilityRot(i, j) = getPolygonTraversability(polygonRot, isUntraversable, cellTraversability);
+      }
+    }
+  });
   scopedLockForTraversabilityMap.unlock();
 
+  enforceMemoryBudget();
   publishTraversabilityMap();
 
   ROS_INFO("Traversability of footprint has been computed in %f s.", (ros::WallTime::now() - start).toSec());
@@ -305,21 +832,130 @@ bool TraversabilityMap::traversabilityFootprint(double footprintYaw) {
 }
 
 bool TraversabilityMap::traversabilityFootprint(const double& radius, const double& offset) {
-  double traversability;
-  grid_map::Position center;
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  for (grid_map::GridMapIterator iterator(traversabilityMap_); !iterator.isPastEnd(); ++iterator) {
-    traversabilityMap_.getPosition(*iterator, center);
-    isTraversable(center, radius + offset, traversability, radius);
-  }
+  // All cells are checked and the footprint layer is published.
+  useDenseFootprintCaches();
+  ensureFootprintLayers();
+  const double radiusMax = radius + offset;
+  maxFootprintRadius_ = std::max(maxFootprintRadius_, radiusMax);
+  BinaryMatrix isUntraversable;
+  grid_map::Matrix cellTraversability;
+  checkAllCells(isUntraversable, cellTraversability);
+  // Each footprint only writes the cache of its center cell.
+  grid_map::Matrix& footprintCache = traversabilityMap_["traversability_footprint"];
+  const grid_map::Size size = traversabilityMap_.getSize();
+  filters::ThreadPool::getInstance().parallelFor(0, size(1), 8, [&](const int columnBegin, const int columnEnd) {
+    grid_map::Position center;
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        if (std::isfinite(footprintCache(i, j))) continue;
+        traversabilityMap_.getPosition(grid_map::Index(i, j), center);
+        footprintCache(i, j) = static_cast<float>(getCircleTraversability(center, radiusMax, radius, isUntraversable, cellTraversability));
+      }
+    }
+  });
   scopedLockForTraversabilityMap.unlock();
+  enforceMemoryBudget();
   publishTraversabilityMap();
   return true;
 }
 
+class TraversabilityMap::SnapshotScope {
+ public:
+  SnapshotScope(TraversabilityMap& map, MapSessions::Snapshot* snapshot)
+      : map_(map),
+        snapshot_(snapshot),
+        retainedMap_(nullptr),
+        hasClearance_(false),
+        clearanceExactDistance_(map.clearanceExactDistance_),
+        useSparseFootprintCaches_(map.footprintCaches_.isSparse()),
+        tiledLayersValid_(map.tiledLayersValid_) {
+    if (snapshot_ == nullptr) return;
+    // A retained map shares no layers with the tiled copies of the latest map.
+    if (snapshot_->generation != map_.mapGeneration_) {
+      retainedMap_ = &map_.sessions_.getRetainedMap(snapshot_->generation);
+      std::swap(map_.traversabilityMap_, *retainedMap_);
+      map_.tiledLayersValid_ = false;
+    }
+    std::swap(map_.overlay_, snapshot_->overlay);
+    // Snapshots are only read by few queries, their footprint caches are sparse.
+    map_.footprintCaches_.swapSparseCaches(snapshot_->sparseFootprintCaches, true);
+    grid_map::GridMap& gridMap = map_.traversabilityMap_;
+    hasClearance_ = gridMap.exists(map_.clearanceType_);
+    if (hasClearance_) gridMap[map_.clearanceType_].swap(clearance_);
+    if (snapshot_->clearance.size() > 0) {
+      if (!hasClearance_) gridMap.add(map_.clearanceType_);
+      gridMap[map_.clearanceType_].swap(snapshot_->clearance);
+      map_.clearanceExactDistance_ = snapshot_->clearanceExactDistance;
+    } else if (hasClearance_) {
+      gridMap.erase(map_.clearanceType_);
+    }
+  }
+
+  ~SnapshotScope() {
+    if (snapshot_ == nullptr) return;
+    grid_map::GridMap& gridMap = map_.traversabilityMap_;
+    if (gridMap.exists(map_.clearanceType_)) {
+      gridMap[map_.clearanceType_].swap(snapshot_->clearance);
+      snapshot_->clearanceExactDistance = map_.clearanceExactDistance_;
+      if (!hasClearance_) gridMap.erase(map_.clearanceType_);
+    }
+    if (hasClearance_) {
+      if (!gridMap.exists(map_.clearanceType_)) gridMap.add(map_.clearanceType_);
+      gridMap[map_.clearanceType_].swap(clearance_);
+    }
+    map_.clearanceExactDistance_ = clearanceExactDistance_;
+    map_.footprintCaches_.swapSparseCaches(snapshot_->sparseFootprintCaches, useSparseFootprintCaches_);
+    std::swap(map_.overlay_, snapshot_->overlay);
+    if (retainedMap_ != nullptr) std::swap(map_.traversabilityMap_, *retainedMap_);
+    map_.tiledLayersValid_ = tiledLayersValid_;
+  }
+
+ private:
+  TraversabilityMap& map_;
+  MapSessions::Snapshot* snapshot_;
+  grid_map::GridMap* retainedMap_;
+  //! Clearance of the latest map while the snapshot is swapped in.
+  grid_map::Matrix clearance_;
+  bool hasClearance_;
+  double clearanceExactDistance_;
+  bool useSparseFootprintCaches_;
+  bool tiledLayersValid_;
+};
+
+class TraversabilityMap::RiskVariantScope {
+ public:
+  RiskVariantScope(TraversabilityMap& map, const std::string& suffix)
+      : map_(map), suffix_(suffix), isActive_(!suffix.empty() && map.swapRiskVariantLayers(suffix)), tiledLayersValid_(map.tiledLayersValid_) {
+    if (!isActive_) return;
+    // The tiled copies and the clearance hold the nominal layers.
+    map_.isRiskVariantActive_ = true;
+    map_.tiledLayersValid_ = false;
+  }
+
+  ~RiskVariantScope() {
+    if (!isActive_) return;
+    map_.swapRiskVariantLayers(suffix_);
+    map_.isRiskVariantActive_ = false;
+    map_.tiledLayersValid_ = tiledLayersValid_;
+  }
+
+  bool isActive() const { return isActive_; }
+
+ private:
+  TraversabilityMap& map_;
+  const std::string suffix_;
+  const bool isActive_;
+  const bool tiledLayersValid_;
+};
+
 bool TraversabilityMap::checkFootprintPath(const traversability_msgs::FootprintPath& path,
-                                           traversability_msgs::TraversabilityResult& result, const bool publishPolygons) {
+                                           traversability_msgs::TraversabilityResult& result, const bool publishPolygons,
+                                           const unsigned int session) {
+  const CacheWarming::ActiveQuery activeQuery(cacheWarming_);
   bool successfullyCheckedFootprint;
+  result.segment_traversability.clear();
+  result.first_unsafe_segment = -1;
   if (!traversabilityMapInitialized_) {
     ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Traversability Estimation: check Footprint path: Traversability map not yet initialized.");
     result.is_safe = static_cast<unsigned char>(false);
@@ -333,29 +969,121 @@ bool TraversabilityMap::checkFootprintPath(const traversability_msgs::FootprintP
     return false;
   }
 
-  if (path.footprint.polygon.points.size() == 0) {
-    successfullyCheckedFootprint = checkCircularFootprintPath(path, publishPolygons, result);
+  // Computes a missing clearance for the pre-check of the latest map without the lock.
+  if (session == 0 && clearancePreCheck_ && !path.footprint.polygon.points.empty() &&
+      path.risk_mode == traversability_msgs::FootprintPath::RISK_NOMINAL) {
+    double inscribedRadius, circumscribedRadius;
+    computeFootprintRadii(path.footprint.polygon.points, inscribedRadius, circumscribedRadius);
+    ensureClearance(circumscribedRadius);
+  }
+
+  // The whole path is checked on the same map, which also protects the collected untraversable cells.
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  MapSessions::Snapshot* snapshot = nullptr;
+  if (session != 0) {
+    snapshot = useSession(session);
+    if (snapshot == nullptr) {
+      result.is_safe = static_cast<unsigned char>(false);
+      return false;
+    }
+    // While the latest map and overlay are those of the snapshot, the session shares their caches.
+    if (snapshot->generation == mapGeneration_ && snapshot->overlayVersion == overlay_.getVersion()) snapshot = nullptr;
   } else {
-    successfullyCheckedFootprint = checkPolygonalFootprintPath(path, publishPolygons, result);
+    updateOverlay();
+  }
+  // Tiled copies evicted for the memory budget are rebuilt on demand.
+  if (tiledLayersEvicted_) {
+    updateTiledLayers();
+    tiledLayersEvicted_ = false;
+  }
+  if (tiledLayersValid_) memoryBudget_.touch("tiled_layers");
+  // Check on the snapshot of the session while the lock is held, until the end of the scope.
+  {
+    const SnapshotScope snapshotScope(*this, snapshot);
+    ensureFootprintLayers();
+    if (path.compute_untraversable_polygon) untraversableCells_.reset(traversabilityMap_.getSize());
+    if (snapshot != nullptr) {
+      segmentCache_.setGeneration(snapshot->generation, snapshot->id);
+    } else {
+      segmentCache_.setGeneration(mapGeneration_);
+    }
+    result.untraversable_polygons.clear();
+
+    // The layers of the requested risk variant take the place of the nominal layers during the check.
+    std::string riskVariantSuffix;
+    bool isRiskModeAvailable = true;
+    if (path.risk_mode == traversability_msgs::FootprintPath::RISK_PESSIMISTIC ||
+        path.risk_mode == traversability_msgs::FootprintPath::RISK_OPTIMISTIC) {
+      riskVariantSuffix = riskVariantSuffixes[path.risk_mode == traversability_msgs::FootprintPath::RISK_PESSIMISTIC ? 0 : 1];
+    } else if (path.risk_mode != traversability_msgs::FootprintPath::RISK_NOMINAL) {
+      ROS_WARN("Traversability Estimation: check Footprint path: Unknown risk mode %u.", path.risk_mode);
+      isRiskModeAvailable = false;
+    }
+    const RiskVariantScope riskVariantScope(*this, riskVariantSuffix);
+    if (!riskVariantSuffix.empty()) {
+      isRiskModeAvailable = riskVariantScope.isActive();
+      if (!isRiskModeAvailable) {
+        ROS_WARN_THROTTLE(periodThrottledConsoleMessages,
+                          "Traversability Estimation: check Footprint path: The map has no '%s' layers, enable compute_bound_variants of "
+                          "the filters.",
+                          riskVariantSuffix.c_str());
+      }
+    }
+
+    if (!isRiskModeAvailable) {
+      result.is_safe = static_cast<unsigned char>(false);
+      successfullyCheckedFootprint = false;
+    } else if (path.footprint.polygon.points.size() == 0) {
+      successfullyCheckedFootprint = checkCircularFootprintPath(path, publishPolygons, result);
+    } else {
+      successfullyCheckedFootprint = checkPolygonalFootprintPath(path, publishPolygons, result);
+    }
+
+    if (path.compute_untraversable_polygon && path.untraversable_components) {
+      const double zPosition = computeMeanHeightFromPoses(path.poses.poses);
+      for (const auto& component : untraversableCells_.getComponents(traversabilityMap_)) {
+        geometry_msgs::Polygon polygon;
+        for (const auto& vertex : component.getVertices()) {
+          geometry_msgs::Point32 point;
+          point.x = vertex.x();
+          point.y = vertex.y();
+          point.z = zPosition;
+          polygon.points.push_back(point);
+        }
+        result.untraversable_polygons.push_back(polygon);
+      }
+    }
   }
 
+  // Switch to the dense caches once the queries cover a larger part of the map, with hysteresis to the selection for a new map.
+  if (snapshot == nullptr && footprintCaches_.shouldUseDense(traversabilityMap_)) {
+    useDenseFootprintCaches();
+  }
+  scopedLockForTraversabilityMap.unlock();
+  enforceMemoryBudget();
   return successfullyCheckedFootprint;
 }
 
 bool TraversabilityMap::checkCircularFootprintPath(const traversability_msgs::FootprintPath& path, const bool publishPolygons,
                                                    traversability_msgs::TraversabilityResult& result) {
   double radius = path.radius;
-  double offset = 0.15;
+  const double offset = circularFootprintOffset;
+  warmedFootprintRadius_ = radius;
   grid_map::Position start, end;
   const auto arraySize = path.poses.poses.size();
   const bool computeUntraversablePolygon = path.compute_untraversable_polygon;
+  UntraversableCells* untraversableCells = computeUntraversablePolygon ? &untraversableCells_ : nullptr;
   result.is_safe = static_cast<unsigned char>(false);
   result.traversability = 0.0;
   result.area = 0.0;
   double traversability = 0.0;
-  double area = 0.0;
-  grid_map::Polygon untraversablePolygon;
+  double lengthPath = 0.0;
   auto robotHeight = computeMeanHeightFromPoses(path.poses.poses);
+  // The untraversable cells are only collected when the segments are evaluated.
+  const bool useSegmentCache = !computeUntraversablePolygon;
+  const uint64_t footprintKey = getFootprintKey(path);
+  SegmentCache::Segment segment;
+  const grid_map::Position footprintReach = grid_map::Position::Constant(radius + offset);
 
   for (int i = 0; i < arraySize; i++) {
     start = end;
@@ -363,68 +1091,77 @@ bool TraversabilityMap::checkCircularFootprintPath(const traversability_msgs::Fo
     end.y() = path.poses.poses[i].position.y;
 
     if (arraySize == 1) {
-      if (checkRobotInclination_) {
-        if (!checkInclination(end, end)) {
-          return true;
+      const auto segmentKey = segmentCache_.getKey(footprintKey, path.poses.poses[i], path.poses.poses[i], false);
+      if (!useSegmentCache || !segmentCache_.get(segmentKey, segment)) {
+        segment.traversability = 0.0;
+        segment.area = 0.0;
+        segment.bounds = Eigen::AlignedBox2d(end - footprintReach, end + footprintReach);
+        segment.isSafe = !checkRobotInclination_ || checkInclination(end, end);
+        if (segment.isSafe) {
+          segment.isSafe = isTraversable(end, radius + offset, segment.traversability, untraversableCells, radius);
         }
+        if (useSegmentCache) segmentCache_.insert(segmentKey, segment);
       }
-      bool pathIsTraversable =
-          isTraversable(end, radius + offset, computeUntraversablePolygon, traversability, untraversablePolygon, radius);
+      const bool pathIsTraversable = segment.isSafe;
+      traversability = segment.traversability;
       if (publishPolygons) {
         grid_map::Polygon polygon = grid_map::Polygon::fromCircle(end, radius + offset);
         polygon.setFrameId(getMapFrameId());
         polygon.setTimestamp(ros::Time::now().toNSec());
         publishFootprintPolygon(polygon);
         if (computeUntraversablePolygon) {
-          publishUntraversablePolygon(untraversablePolygon, robotHeight);
+          publishUntraversablePolygon(robotHeight);
         }
       }
       if (!pathIsTraversable) {
         // return such that default values in result - i.e. non traversable - are used.
+        setUnsafeSegment(path, 0, result);
         return true;
       }
       result.traversability = traversability;
+      result.segment_traversability.push_back(traversability);
     }
 
     if (arraySize > 1 && i > 0) {
-      if (checkRobotInclination_) {
-        if (!checkInclination(start, end)) {
-          return true;
-        }
-      }
-      double traversabilityTemp, traversabilitySum = 0.0;
-      int nLine = 0;
-      grid_map::Index startIndex, endIndex;
-      boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-      traversabilityMap_.getIndex(start, startIndex);
-      traversabilityMap_.getIndex(end, endIndex);
-      int nSkip = 3;  // TODO: Remove magic number.
-      grid_map::Polygon auxiliaryUntraversablePolygon;
-      bool pathIsTraversable = true;
-      for (grid_map::LineIterator lineIterator(traversabilityMap_, endIndex, startIndex); !lineIterator.isPastEnd(); ++lineIterator) {
-        grid_map::Position center;
-        traversabilityMap_.getPosition(*lineIterator, center);
-        pathIsTraversable = pathIsTraversable && isTraversable(center, radius + offset, computeUntraversablePolygon, traversabilityTemp,
-                                                               auxiliaryUntraversablePolygon, radius);
-
-        if (publishPolygons && computeUntraversablePolygon && auxiliaryUntraversablePolygon.nVertices() > 0) {
-          untraversablePolygon = grid_map::Polygon::convexHull(untraversablePolygon, auxiliaryUntraversablePolygon);
-        }
-
-        if (!pathIsTraversable && !computeUntraversablePolygon && !publishPolygons) {
-          // return such that default values in result - i.e. non traversable - are used.
-          return true;
-        }
+      const auto segmentKey = segmentCache_.getKey(footprintKey, path.poses.poses[i - 1], path.poses.poses[i], false);
+      if (!useSegmentCache || !segmentCache_.get(segmentKey, segment)) {
+        segment.traversability = 0.0;
+        segment.area = 0.0;
+        segment.bounds = Eigen::AlignedBox2d(start.cwiseMin(end) - footprintReach, start.cwiseMax(end) + footprintReach);
+        segment.isSafe = !checkRobotInclination_ || checkInclination(start, end);
+        if (segment.isSafe) {
+          double traversabilityTemp, traversabilitySum = 0.0;
+          int nLine = 0;
+          grid_map::Index startIndex, endIndex;
+          boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+          traversabilityMap_.getIndex(start, startIndex);
+          traversabilityMap_.getIndex(end, endIndex);
+          int nSkip = 3;  // TODO: Remove magic number.
+          for (grid_map::LineIterator lineIterator(traversabilityMap_, endIndex, startIndex); !lineIterator.isPastEnd(); ++lineIterator) {
+            grid_map::Position center;
+            traversabilityMap_.getPosition(*lineIterator, center);
+            segment.isSafe =
+                segment.isSafe && isTraversable(center, radius + offset, traversabilityTemp, untraversableCells, radius);
+
+            if (!segment.isSafe && !computeUntraversablePolygon && !publishPolygons) {
+              // Do not keep on checking this segment, one footprint is already non-traversable.
+              break;
+            }
 
-        traversabilitySum += traversabilityTemp;
-        nLine++;
-        for (int j = 0; j < nSkip; j++) {
-          if (!lineIterator.isPastEnd()) {
-            ++lineIterator;
+            traversabilitySum += traversabilityTemp;
+            nLine++;
+            for (int j = 0; j < nSkip; j++) {
+              if (!lineIterator.isPastEnd()) {
+                ++lineIterator;
+              }
+            }
           }
+          scopedLockForTraversabilityMap.unlock();
+          if (segment.isSafe) segment.traversability = traversabilitySum / (double)nLine;
         }
+        if (useSegmentCache) segmentCache_.insert(segmentKey, segment);
       }
-      scopedLockForTraversabilityMap.unlock();
+      const bool pathIsTraversable = segment.isSafe;
 
       if (publishPolygons) {
         grid_map::Polygon polygon = grid_map::Polygon::fromCircle(end, radius + offset);
@@ -432,18 +1169,16 @@ bool TraversabilityMap::checkCircularFootprintPath(const traversability_msgs::Fo
         polygon.setTimestamp(ros::Time::now().toNSec());
         publishFootprintPolygon(polygon);
         if (computeUntraversablePolygon) {
-          untraversablePolygon.setFrameId(auxiliaryUntraversablePolygon.getFrameId());
-          untraversablePolygon.setTimestamp(auxiliaryUntraversablePolygon.getTimestamp());
-          publishUntraversablePolygon(untraversablePolygon, robotHeight);
+          publishUntraversablePolygon(robotHeight);
         }
       }
 
       if (pathIsTraversable) {
-        traversability = traversabilitySum / (double)nLine;
-        double lengthSegment, lengthPreviousPath, lengthPath;
-        lengthSegment = (end - start).norm();
-        if (i > 1) {
-          lengthPreviousPath = lengthPath;
+        traversability = segment.traversability;
+        result.segment_traversability.push_back(traversability);
+        const double lengthSegment = (end - start).norm();
+        if (lengthPath > 0.0) {
+          const double lengthPreviousPath = lengthPath;
           lengthPath += lengthSegment;
           result.traversability = (lengthSegment * traversability + lengthPreviousPath * result.traversability) / lengthPath;
         } else {
@@ -452,12 +1187,15 @@ bool TraversabilityMap::checkCircularFootprintPath(const traversability_msgs::Fo
         }
       } else {
         // return such that default values in result - i.e. non traversable - are used.
-        return true;
+        setUnsafeSegment(path, i - 1, result);
+        if (!path.evaluate_all_segments) return true;
       }
     }
   }
 
-  result.is_safe = static_cast<unsigned char>(true);
+  result.is_safe = static_cast<unsigned char>(result.first_unsafe_segment < 0);
+  // An unsafe path is not traversable, the safe segments after the first unsafe one only have their own values.
+  if (!result.is_safe) result.traversability = 0.0;
   return true;
 }
 
@@ -466,12 +1204,40 @@ bool TraversabilityMap::checkPolygonalFootprintPath(const traversability_msgs::F
   grid_map::Position start, end;
   const auto arraySize = path.poses.poses.size();
   const bool computeUntraversablePolygon = path.compute_untraversable_polygon;
+  UntraversableCells* untraversableCells = computeUntraversablePolygon ? &untraversableCells_ : nullptr;
   result.is_safe = static_cast<unsigned char>(false);
   result.traversability = 0.0;
   result.area = 0.0;
   double traversability = 0.0;
-  grid_map::Polygon untraversablePolygon;
   auto robotHeight = computeMeanHeightFromPoses(path.poses.poses);
+  // The untraversable cells are only collected when the segments are evaluated.
+  const bool useSegmentCache = !computeUntraversablePolygon;
+  const uint64_t footprintKey = getFootprintKey(path);
+  SegmentCache::Segment segment;
+
+  // Radii for the pre-check with the clearance layer, configured for the robot footprint.
+  double inscribedRadius = footprintInscribedRadius_;
+  double circumscribedRadius = footprintCircumscribedRadius_;
+  const auto& points = path.footprint.polygon.points;
+  const bool isRobotFootprint =
+      points.size() == footprintPoints_.size() &&
+      std::equal(points.begin(), points.end(), footprintPoints_.begin(),
+                 [](const geometry_msgs::Point32& a, const geometry_msgs::Point32& b) { return a.x == b.x && a.y == b.y; });
+  if (!isRobotFootprint) computeFootprintRadii(points, inscribedRadius, circumscribedRadius);
+  maxFootprintRadius_ = std::max(maxFootprintRadius_, circumscribedRadius);
+  auto checkPolygon = [&](const grid_map::Position& start, const grid_map::Position& end, const grid_map::Polygon& polygon,
+                          double& traversability) {
+    FootprintClearance clearance = FootprintClearance::Undecided;
+    // The clearance layer is computed from the nominal layers.
+    if (clearancePreCheck_ && !isRiskVariantActive_ &&
+        ensureClearance(circumscribedRadius + M_SQRT2 * traversabilityMap_.getResolution())) {
+      clearance = checkFootprintClearance(start, end, inscribedRadius, circumscribedRadius);
+    }
+    if (clearance == FootprintClearance::Free) return getMeanTraversability(polygon, traversability);
+    // The untraversable cells are still collected if requested.
+    if (clearance == FootprintClearance::Occupied && untraversableCells == nullptr) return false;
+    return isTraversable(polygon, traversability, untraversableCells);
+  };
 
   grid_map::Polygon polygon, polygon1, polygon2;
   polygon1.setFrameId(getMapFrameId());
@@ -521,80 +1287,148 @@ bool TraversabilityMap::checkPolygonalFootprintPath(const traversability_msgs::F
 
     if (arraySize == 1) {
       polygon = polygon2;
-      if (checkRobotInclination_) {
-        if (!checkInclination(end, end)) return true;
+      const auto segmentKey = segmentCache_.getKey(footprintKey, path.poses.poses[i], path.poses.poses[i], true);
+      if (!useSegmentCache || !segmentCache_.get(segmentKey, segment)) {
+        segment.traversability = 0.0;
+        segment.area = polygon.getArea();
+        segment.bounds = getBounds(polygon);
+        segment.isSafe = !checkRobotInclination_ || checkInclination(end, end);
+        if (segment.isSafe) segment.isSafe = checkPolygon(end, end, polygon, segment.traversability);
+        if (useSegmentCache) segmentCache_.insert(segmentKey, segment);
       }
-      bool pathIsTraversable = isTraversable(polygon, computeUntraversablePolygon, traversability, untraversablePolygon);
+      const bool pathIsTraversable = segment.isSafe;
+      traversability = segment.traversability;
 
       if (publishPolygons) {
         publishFootprintPolygon(polygon);
         if (computeUntraversablePolygon) {
-          publishUntraversablePolygon(untraversablePolygon, robotHeight);
+          publishUntraversablePolygon(robotHeight);
         }
       }
 
       if (!pathIsTraversable) {
         // return such that default values in result - i.e. non traversable - are used.
+        setUnsafeSegment(path, 0, result);
         return true;
       }
 
       result.traversability = traversability;
-      result.area = polygon.getArea();
+      result.area = segment.area;
+      result.segment_traversability.push_back(traversability);
     }
 
     if (arraySize > 1 && i > 0) {
-      polygon = grid_map::Polygon::convexHull(polygon1, polygon2);
-      polygon.setFrameId(getMapFrameId());
-      polygon.setTimestamp(ros::Time::now().toNSec());
-
-      if (checkRobotInclination_) {
-        if (!checkInclination(start, end)) {
-          return true;
-        }
+      const auto segmentKey = segmentCache_.getKey(footprintKey, path.poses.poses[i - 1], path.poses.poses[i], true);
+      const bool isCached = useSegmentCache && segmentCache_.get(segmentKey, segment);
+      if (!isCached || publishPolygons) {
+        polygon = grid_map::Polygon::convexHull(polygon1, polygon2);
+        polygon.setFrameId(getMapFrameId());
+        polygon.setTimestamp(ros::Time::now().toNSec());
       }
-      bool pathIsTraversable = isTraversable(polygon, computeUntraversablePolygon, traversability, untraversablePolygon);
+      if (!isCached) {
+        segment.traversability = 0.0;
+        segment.area = polygon.getArea();
+        segment.bounds = getBounds(polygon);
+        segment.isSafe = !checkRobotInclination_ || checkInclination(start, end);
+        if (segment.isSafe) segment.isSafe = checkPolygon(start, end, polygon, segment.traversability);
+        if (useSegmentCache) segmentCache_.insert(segmentKey, segment);
+      }
+      const bool pathIsTraversable = segment.isSafe;
+      traversability = segment.traversability;
 
       if (publishPolygons) {
         publishFootprintPolygon(polygon, robotHeight);
         if (computeUntraversablePolygon) {
-          publishUntraversablePolygon(untraversablePolygon, robotHeight);
+          publishUntraversablePolygon(robotHeight);
         }
       }
 
       if (!pathIsTraversable) {
         // return such that default values in result - i.e. non traversable - are used.
-        return true;
+        setUnsafeSegment(path, i - 1, result);
+        if (!path.evaluate_all_segments) return true;
+        continue;
       }
 
+      result.segment_traversability.push_back(traversability);
       double areaPolygon, areaPrevious;
-      if (i > 1) {
+      if (result.area > 0.0) {
         areaPrevious = result.area;
-        areaPolygon = polygon.getArea() - polygon1.getArea();
+        areaPolygon = segment.area - polygon1.getArea();
         result.area += areaPolygon;
         result.traversability = (areaPolygon * traversability + areaPrevious * result.traversability) / result.area;
       } else {
-        result.area = polygon.getArea();
+        result.area = segment.area;
         result.traversability = traversability;
       }
     }
   }
 
-  result.is_safe = static_cast<unsigned char>(true);
+  result.is_safe = static_cast<unsigned char>(result.first_unsafe_segment < 0);
+  // An unsafe path is not traversable, the safe segments after the first unsafe one only have their own values.
+  if (!result.is_safe) result.traversability = 0.0;
   return true;
 }
 
+uint64_t TraversabilityMap::getFootprintKey(const traversability_msgs::FootprintPath& path) const {
+  uint64_t key = 0;
+  const auto combineValue = [&key](const double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    SegmentCache::combineHash(key, bits);
+  };
+  combineValue(path.radius);
+  for (const auto& point : path.footprint.polygon.points) {
+    combineValue(point.x);
+    combineValue(point.y);
+    combineValue(point.z);
+  }
+  SegmentCache::combineHash(key, static_cast<uint64_t>(path.conservative));
+  SegmentCache::combineHash(key, static_cast<uint64_t>(checkRobotInclination_));
+  SegmentCache::combineHash(key, static_cast<uint64_t>(path.risk_mode));
+  return key;
+}
+
+bool TraversabilityMap::swapRiskVariantLayers(const std::string& suffix) {
+  if (!traversabilityMap_.exists(traversabilityType_ + suffix)) return false;
+  // Footprint caches have a variant if the filter layer they are derived from has one.
+  const std::vector<std::pair<std::string, std::string>> footprintLayers{{"traversability_footprint", traversabilityType_},
+                                                                         {"step_footprint", stepType_},
+                                                                         {"slope_footprint", slopeType_},
+                                                                         {"roughness_footprint", roughnessType_}};
+  for (const auto& footprintLayer : footprintLayers) {
+    if (!traversabilityMap_.exists(footprintLayer.second + suffix)) continue;
+    ensureFootprintCache(footprintLayer.first);
+    ensureFootprintCache(footprintLayer.first + suffix);
+    footprintCaches_.swapSparseCaches(footprintLayer.first, footprintLayer.first + suffix);
+  }
+  const std::vector<std::string> layers{traversabilityType_, slopeType_,        stepType_,        roughnessType_,
+                                        "traversability_footprint", "slope_footprint", "step_footprint", "roughness_footprint"};
+  for (const auto& layer : layers) {
+    // Layers without variant (e.g. the slope, which does not depend on the bounds) are shared.
+    if (traversabilityMap_.exists(layer) && traversabilityMap_.exists(layer + suffix)) {
+      traversabilityMap_[layer].swap(traversabilityMap_[layer + suffix]);
+    }
+  }
+  return true;
+}
+
+void TraversabilityMap::setUnsafeSegment(const traversability_msgs::FootprintPath& path, const int segment,
+                                         traversability_msgs::TraversabilityResult& result) const {
+  result.segment_traversability.push_back(0.0);
+  if (result.first_unsafe_segment >= 0) return;
+  result.first_unsafe_segment = segment;
+  result.first_unsafe_position = path.poses.poses[segment].position;
+}
+
 bool TraversabilityMap::isTraversable(const grid_map::Polygon& polygon, double& traversability) {
-  const bool computeUntraversablePolygon = false;
-  grid_map::Polygon untraversablePolygon;
-  return isTraversable(polygon, computeUntraversablePolygon, traversability, untraversablePolygon);
+  return isTraversable(polygon, traversability, nullptr);
 }
 
-bool TraversabilityMap::isTraversable(const grid_map::Polygon& polygon, const bool& computeUntraversablePolygon, double& traversability,
-                                      grid_map::Polygon& untraversablePolygon) {
+bool TraversabilityMap::isTraversable(const grid_map::Polygon& polygon, double& traversability, UntraversableCells* untraversableCells) {
   unsigned int nCells = 0;
   traversability = 0.0;
   bool pathIsTraversable = true;
-  std::vector<grid_map::Position> untraversablePositions;
   // Iterate through polygon and check for traversability.
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
   for (grid_map::PolygonIterator polygonIterator(traversabilityMap_, polygon); !polygonIterator.isPastEnd(); ++polygonIterator) {
@@ -602,20 +1436,14 @@ bool TraversabilityMap::isTraversable(const grid_map::Polygon& polygon, const bo
 
     if (!currentPositionIsTraversale) {
       pathIsTraversable = false;
-      if (computeUntraversablePolygon) {
-        grid_map::Position positionUntraversableCell;
-        traversabilityMap_.getPosition(*polygonIterator, positionUntraversableCell);
-        untraversablePositions.push_back(positionUntraversableCell);
+      if (untraversableCells != nullptr) {
+        untraversableCells->add(*polygonIterator);
       } else {
         return false;
       }
     } else {
       nCells++;
-      if (!traversabilityMap_.isValid(*polygonIterator, traversabilityType_)) {
-        traversability += traversabilityDefault_;
-      } else {
-        traversability += traversabilityMap_.at(traversabilityType_, *polygonIterator);
-      }
+      traversability += getCellTraversability(*polygonIterator);
     }
   }
   scopedLockForTraversabilityMap.unlock();
@@ -631,50 +1459,41 @@ bool TraversabilityMap::isTraversable(const grid_map::Polygon& polygon, const bo
     }
   }
 
-  if (computeUntraversablePolygon) {
-    if (pathIsTraversable) {
-      untraversablePolygon = grid_map::Polygon();  // empty untraversable polygon
-    } else {
-      untraversablePolygon = grid_map::Polygon::monotoneChainConvexHullOfPoints(untraversablePositions);
-    }
-    untraversablePolygon.setFrameId(getMapFrameId());
-    untraversablePolygon.setTimestamp(ros::Time::now().toNSec());
-  }
-
   return pathIsTraversable;
 }
 
 bool TraversabilityMap::isTraversable(const grid_map::Position& center, const double& radiusMax, double& traversability,
                                       const double& radiusMin) {
-  const bool computeUntraversablePolygon = false;
-  grid_map::Polygon untraversablePolygon;
-  return isTraversable(center, radiusMax, computeUntraversablePolygon, traversability, untraversablePolygon, radiusMin);
+  return isTraversable(center, radiusMax, traversability, nullptr, radiusMin);
 }
 
-bool TraversabilityMap::isTraversable(const grid_map::Position& center, const double& radiusMax, const bool& computeUntraversablePolygon,
-                                      double& traversability, grid_map::Polygon& untraversablePolygon, const double& radiusMin) {
+bool TraversabilityMap::isTraversable(const grid_map::Position& center, const double& radiusMax, double& traversability,
+                                      UntraversableCells* untraversableCells, const double& radiusMin) {
   bool circleIsTraversable = true;
-  std::vector<grid_map::Position> untraversablePositions;
-  grid_map::Position positionUntraversableCell;
-  untraversablePolygon = grid_map::Polygon();  // empty untraversable polygon
   // Handle cases of footprints outside of map.
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  maxFootprintRadius_ = std::max(maxFootprintRadius_, radiusMax);
   if (!traversabilityMap_.isInside(center)) {
     traversability = traversabilityDefault_;
     circleIsTraversable = traversabilityDefault_ != 0.0;
-    if (computeUntraversablePolygon && !circleIsTraversable) {
-      untraversablePolygon = grid_map::Polygon::fromCircle(center, radiusMax);
+    if (untraversableCells != nullptr && !circleIsTraversable) {
+      untraversableCells->add(grid_map::Polygon::fromCircle(center, radiusMax));
     }
   } else {
     // Footprints inside map.
     // Get index of center position.
     grid_map::Index indexCenter;
     traversabilityMap_.getIndex(center, indexCenter);
-    if (traversabilityMap_.isValid(indexCenter, "traversability_footprint")) {
-      traversability = traversabilityMap_.at("traversability_footprint", indexCenter);
+    const float cachedTraversability = getFootprintCache("traversability_footprint", indexCenter);
+    if (std::isfinite(cachedTraversability)) {
+      traversability = cachedTraversability;
       circleIsTraversable = traversability != 0.0;
-      if (computeUntraversablePolygon && !circleIsTraversable) {
-        untraversablePolygon = grid_map::Polygon::fromCircle(center, radiusMax);
+      if (untraversableCells != nullptr && !circleIsTraversable) {
+        // The cached value does not tell which cells are untraversable, check the footprint cells.
+        for (grid_map::CircleIterator iterator(traversabilityMap_, center, radiusMin == 0.0 ? radiusMax : radiusMin); !iterator.isPastEnd();
+             ++iterator) {
+          if (!isTraversableForFilters(*iterator)) untraversableCells->add(*iterator);
+        }
       }
     } else {
       // Non valid (non finite traversability)
@@ -692,234 +1511,661 @@ bool TraversabilityMap::isTraversable(const grid_map::Position& center, const do
           maxUntraversableRadius = std::max(maxUntraversableRadius, untraversableRadius);
 
           if (radiusMin == 0.0) {
-            traversabilityMap_.at("traversability_footprint", indexCenter) = 0.0;
+            setFootprintCache("traversability_footprint", indexCenter, 0.0);
             circleIsTraversable = false;
-            traversabilityMap_.getPosition(*iterator, positionUntraversableCell);
-            untraversablePositions.push_back(positionUntraversableCell);
+            if (untraversableCells != nullptr) untraversableCells->add(*iterator);
           } else {
             if (untraversableRadius <= radiusMin) {
-              traversabilityMap_.at("traversability_footprint", indexCenter) = 0.0;
+              setFootprintCache("traversability_footprint", indexCenter, 0.0);
               circleIsTraversable = false;
-              traversabilityMap_.getPosition(*iterator, positionUntraversableCell);
-              untraversablePositions.push_back(positionUntraversableCell);
+              if (untraversableCells != nullptr) untraversableCells->add(*iterator);
             } else if (circleIsTraversable) {  // if circleIsTraversable is not changed by any previous loop
               auto factor = ((untraversableRadius - radiusMin) / (radiusMax - radiusMin) + 1.0) / 2.0;
               traversability *= factor / nCells;
-              traversabilityMap_.at("traversability_footprint", indexCenter) = static_cast<float>(traversability);
+              setFootprintCache("traversability_footprint", indexCenter, static_cast<float>(traversability));
               circleIsTraversable = true;
               traversableRadiusBiggerMinRadius = true;
             }
           }
 
-          if (!computeUntraversablePolygon) {
+          if (untraversableCells == nullptr) {
             // Do not keep on checking, one cell is already non-traversable.
             return false;
           }
         } else {
           nCells++;
-          if (!traversabilityMap_.isValid(*iterator, traversabilityType_)) {
-            traversability += traversabilityDefault_;
-          } else {
-            traversability += traversabilityMap_.at(traversabilityType_, *iterator);
-          }
+          traversability += getCellTraversability(*iterator);
         }
       }
 
-      if (computeUntraversablePolygon && !circleIsTraversable) {
-        untraversablePolygon = grid_map::Polygon::monotoneChainConvexHullOfPoints(untraversablePositions);
-      }
-
       if (circleIsTraversable) {
         traversability /= nCells;
-        traversabilityMap_.at("traversability_footprint", indexCenter) = static_cast<float>(traversability);
+        setFootprintCache("traversability_footprint", indexCenter, static_cast<float>(traversability));
       }
     }
   }
   scopedLockForTraversabilityMap.unlock();
 
-  if (computeUntraversablePolygon) {
-    untraversablePolygon.setFrameId(getMapFrameId());
-    untraversablePolygon.setTimestamp(ros::Time::now().toNSec());
+  return circleIsTraversable;
+}
+
+void TraversabilityMap::checkAllCells(BinaryMatrix& isUntraversable, grid_map::Matrix& cellTraversability) {
+  // The checks only write the dense footprint caches of the checked cell.
+  FilterChecks filterChecks = getFilterChecks();
+  const grid_map::Size size = traversabilityMap_.getSize();
+  isUntraversable.resize(size(0), size(1));
+  cellTraversability.resize(size(0), size(1));
+  filters::ThreadPool::getInstance().parallelFor(0, size(1), 8, [&](const int columnBegin, const int columnEnd) {
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        const grid_map::Index index(i, j);
+        isUntraversable(i, j) = !filterChecks.check(index);
+        cellTraversability(i, j) = static_cast<float>(getCellTraversability(index));
+      }
+    }
+  });
+}
+
+double TraversabilityMap::getPolygonTraversability(const grid_map::Polygon& polygon, const BinaryMatrix& isUntraversable,
+                                                   const grid_map::Matrix& cellTraversability) const {
+  unsigned int nCells = 0;
+  double traversability = 0.0;
+  for (grid_map::PolygonIterator iterator(traversabilityMap_, polygon); !iterator.isPastEnd(); ++iterator) {
+    const grid_map::Index& index = *iterator;
+    if (isUntraversable(index(0), index(1))) return 0.0;
+    nCells++;
+    traversability += cellTraversability(index(0), index(1));
   }
+  // Footprints outside of the map.
+  if (nCells == 0) return traversabilityDefault_;
+  return traversability / nCells;
+}
 
-  return circleIsTraversable;
+double TraversabilityMap::getCircleTraversability(const grid_map::Position& center, const double radiusMax, const double radiusMin,
+                                                  const BinaryMatrix& isUntraversable, const grid_map::Matrix& cellTraversability) const {
+  // Same as isTraversable, the cells from the center outwards until the first untraversable one.
+  int nCells = 0;
+  double traversability = 0.0;
+  for (grid_map::SpiralIterator iterator(traversabilityMap_, center, radiusMax); !iterator.isPastEnd(); ++iterator) {
+    const grid_map::Index& index = *iterator;
+    if (isUntraversable(index(0), index(1))) {
+      const double untraversableRadius = iterator.getCurrentRadius();
+      if (radiusMin == 0.0 || untraversableRadius <= radiusMin) return 0.0;
+      const double factor = ((untraversableRadius - radiusMin) / (radiusMax - radiusMin) + 1.0) / 2.0;
+      return traversability * factor / nCells;
+    }
+    nCells++;
+    traversability += cellTraversability(index(0), index(1));
+  }
+  return traversability / nCells;
 }
 
-bool TraversabilityMap::checkInclination(const grid_map::Position& start, const grid_map::Position& end) {
+bool TraversabilityMap::computeClearance() {
+  if (!traversabilityMapInitialized_) return false;
+
+  // Initialize timer.
+  ros::WallTime start = ros::WallTime::now();
+
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  if (end == start) {
-    if (traversabilityMap_.atPosition(robotSlopeType_, start) == 0.0) return false;
-  } else {
-    grid_map::Index startIndex, endIndex;
-    traversabilityMap_.getIndex(start, startIndex);
-    traversabilityMap_.getIndex(end, endIndex);
-    for (grid_map::LineIterator lineIterator(traversabilityMap_, startIndex, endIndex); !lineIterator.isPastEnd(); ++lineIterator) {
-      if (!traversabilityMap_.isValid(*lineIterator, robotSlopeType_)) continue;
-      if (traversabilityMap_.at(robotSlopeType_, *lineIterator) == 0.0) return false;
+  for (int attempt = 1;; ++attempt) {
+    // The cells are checked on a snapshot of the layers read by the checks, the dense footprint caches and the
+    // overlay, without the lock unless the map or the overlay changed during the previous attempts.
+    const bool isLocked = attempt >= maxClearanceAttempts;
+    ensureFootprintLayers();
+    const uint64_t generation = mapGeneration_;
+    const uint64_t overlayVersion = overlay_.getVersion();
+    const bool useSparseFootprintCaches = footprintCaches_.isSparse();
+    std::vector<std::string> footprintLayers{"step_footprint", "slope_footprint"};
+    std::vector<std::string> layers{"elevation", stepType_, slopeType_};
+    if (filterCheckParameters_.checkForRoughness) {
+      footprintLayers.push_back("roughness_footprint");
+      layers.push_back(roughnessType_);
     }
+    if (!useSparseFootprintCaches) layers.insert(layers.end(), footprintLayers.begin(), footprintLayers.end());
+    grid_map::GridMap snapshot;
+    snapshot.setGeometry(traversabilityMap_.getLength(), traversabilityMap_.getResolution(), traversabilityMap_.getPosition());
+    for (const auto& layer : layers) snapshot.add(layer, traversabilityMap_[layer]);
+    const MapOverlay overlay = overlay_;
+    std::map<std::string, SparseCellCache> sparseFootprintCaches;
+    if (useSparseFootprintCaches) sparseFootprintCaches = footprintCaches_.getSparseCaches();
+    if (!isLocked) scopedLockForTraversabilityMap.unlock();
+
+    // The checks only write the dense footprint caches of the checked cell, the sparse caches are only read.
+    FilterChecks filterChecks(filterCheckParameters_, snapshot, overlay);
+    if (useSparseFootprintCaches) filterChecks.setSparseFootprintCaches(sparseFootprintCaches, true);
+    const grid_map::Size size = snapshot.getSize();
+    BinaryMatrix isUntraversable(size(0), size(1));
+    filters::ThreadPool::getInstance().parallelFor(0, size(1), 8, [&](const int columnBegin, const int columnEnd) {
+      for (int j = columnBegin; j < columnEnd; ++j) {
+        for (int i = 0; i < size(0); ++i) isUntraversable(i, j) = !filterChecks.check(grid_map::Index(i, j));
+      }
+    });
+    grid_map::Matrix clearance;
+    computeDistanceTransform(isUntraversable, size.cast<float>().matrix().norm(), clearance);
+
+    if (!isLocked) scopedLockForTraversabilityMap.lock();
+    if (!traversabilityMapInitialized_) return false;
+    if (mapGeneration_ != generation || overlay_.getVersion() != overlayVersion) continue;
+    traversabilityMap_.add(clearanceType_, static_cast<float>(traversabilityMap_.getResolution()) * clearance);
+    clearanceExactDistance_ = std::numeric_limits<double>::infinity();
+    // Keep the cached filter results, cells cached by queries meanwhile agree with them.
+    if (!useSparseFootprintCaches && !footprintCaches_.isSparse()) {
+      for (const auto& layer : footprintLayers) {
+        if (!traversabilityMap_.exists(layer)) continue;
+        grid_map::Matrix& data = traversabilityMap_[layer];
+        data = (data.array() == data.array()).select(data, snapshot[layer]);
+      }
+    }
+    break;
   }
+  scopedLockForTraversabilityMap.unlock();
+
+  ROS_DEBUG("Clearance has been computed in %f s.", (ros::WallTime::now() - start).toSec());
   return true;
 }
 
-bool TraversabilityMap::updateFilter() {
-  // Reconfigure filter chain.
-  filter_chain_.clear();
-  if (!filter_chain_.configure("traversability_map_filters", nodeHandle_)) {
-    ROS_ERROR("Could not configure the filter chain!");
+void TraversabilityMap::warmFootprintCaches(const std::vector<grid_map::Position>& corridor) { cacheWarming_.request(corridor); }
+
+bool TraversabilityMap::prepareCacheWarming(grid_map::GridMap& geometry, uint64_t& generation) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (!traversabilityMapInitialized_) return false;
+  generation = mapGeneration_;
+  const double resolution = traversabilityMap_.getResolution();
+  // The configuration space of polygonal footprints for all headings, which the first check would compute.
+  if (clearancePreCheck_ && !footprintPoints_.empty() && !isRiskVariantActive_) {
+    ensureClearance(footprintCircumscribedRadius_ + M_SQRT2 * resolution);
+  }
+  geometry.setGeometry(traversabilityMap_.getLength(), resolution, traversabilityMap_.getPosition());
+  geometry.setStartIndex(traversabilityMap_.getStartIndex());
+  return true;
+}
+
+bool TraversabilityMap::warmCells(const std::vector<grid_map::Index>& cells, const uint64_t generation) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (mapGeneration_ != generation) return false;
+  updateOverlay();
+  ensureFootprintLayers();
+  const double footprintRadius = warmedFootprintRadius_ > 0.0 ? warmedFootprintRadius_ : circularFootprintRadius_;
+  grid_map::Position position;
+  double traversability;
+  for (const auto& index : cells) {
+    checkFilters(index);
+    if (footprintRadius > 0.0) {
+      traversabilityMap_.getPosition(index, position);
+      isTraversable(position, footprintRadius + circularFootprintOffset, traversability, footprintRadius);
+    }
+  }
+  return true;
+}
+
+bool TraversabilityMap::ensureClearance(const double distance) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  memoryBudget_.touch(clearanceType_);
+  if (traversabilityMap_.exists(clearanceType_) && distance <= clearanceExactDistance_) return true;
+  scopedLockForTraversabilityMap.unlock();
+  return computeClearance();
+}
+
+void TraversabilityMap::updateClearance(const Eigen::AlignedBox2d& bounds, const double distance) {
+  // Clearances up to the distance within the inner window only depend on cells within the outer window.
+  const grid_map::Position margin = grid_map::Position::Constant(distance);
+  grid_map::Index outerStart, innerStart;
+  grid_map::Size outerSize, innerSize;
+  if (!getIndexRange(traversabilityMap_, Eigen::AlignedBox2d(bounds.min() - 2.0 * margin, bounds.max() + 2.0 * margin), outerStart,
+                     outerSize) ||
+      !getIndexRange(traversabilityMap_, Eigen::AlignedBox2d(bounds.min() - margin, bounds.max() + margin), innerStart, innerSize)) {
+    return;
+  }
+  ensureFootprintLayers();
+  BinaryMatrix isUntraversable(outerSize(0), outerSize(1));
+  for (int i = 0; i < outerSize(0); ++i) {
+    for (int j = 0; j < outerSize(1); ++j) {
+      isUntraversable(i, j) = !isTraversableForFilters(outerStart + grid_map::Index(i, j));
+    }
+  }
+  grid_map::Matrix clearance;
+  computeDistanceTransform(isUntraversable, outerSize.cast<float>().matrix().norm(), clearance);
+  const grid_map::Index offset = innerStart - outerStart;
+  traversabilityMap_[clearanceType_].block(innerStart(0), innerStart(1), innerSize(0), innerSize(1)) =
+      static_cast<float>(traversabilityMap_.getResolution()) * clearance.block(offset(0), offset(1), innerSize(0), innerSize(1));
+  // Larger clearances are only known to be larger than the distance.
+  clearanceExactDistance_ = std::min(clearanceExactDistance_, distance);
+}
+
+void TraversabilityMap::invalidateRegion(const Eigen::AlignedBox2d& bounds) {
+  if (bounds.isEmpty() || !traversabilityMapInitialized_) return;
+  const double resolution = traversabilityMap_.getResolution();
+  // Cells are affected if their center is within the bounds, add a cell for the discretization.
+  const grid_map::Position cellMargin = grid_map::Position::Constant(resolution);
+  const Eigen::AlignedBox2d changedBounds(bounds.min() - cellMargin, bounds.max() + cellMargin);
+  segmentCache_.invalidate(changedBounds);
+
+  // Cached footprints centered within reach of the changed cells.
+  const double reach = maxFootprintRadius_ + 2.0 * resolution;
+  const grid_map::Position reachMargin = grid_map::Position::Constant(reach);
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  if (getIndexRange(traversabilityMap_, Eigen::AlignedBox2d(changedBounds.min() - reachMargin, changedBounds.max() + reachMargin),
+                    startIndex, size)) {
+    std::vector<std::string> suffixes(riskVariantSuffixes.begin(), riskVariantSuffixes.end());
+    suffixes.emplace_back();
+    for (const auto& suffix : suffixes) {
+      footprintCaches_.clearBlock(traversabilityMap_, "traversability_footprint" + suffix, startIndex, size);
+    }
+  }
+  if (traversabilityMap_.exists(clearanceType_)) updateClearance(changedBounds, reach);
+  if (traversableComponents_.isValid()) {
+    updateTraversableComponents(Eigen::AlignedBox2d(changedBounds.min() - reachMargin, changedBounds.max() + reachMargin));
+  }
+  // Changed cells can open or close passages anywhere on the paths from the robot, the whole-map cost-to-go is
+  // dropped and recomputed at the next map update instead of under the lock of the query which expired the change.
+  if (traversabilityMap_.exists(costToGoType_)) traversabilityMap_.erase(costToGoType_);
+}
+
+void TraversabilityMap::invalidateRegions(const MapOverlay::ChangedBounds& changedBounds) {
+  for (const auto& bounds : changedBounds) invalidateRegion(bounds);
+}
+
+bool TraversabilityMap::setDynamicObstacles(const traversability_msgs::DynamicObstacles& msg) {
+  if (getMapFrameId() != msg.header.frame_id) {
+    ROS_ERROR("Received dynamic obstacles have frame_id = '%s', but frame_id = '%s' is expected.", msg.header.frame_id.c_str(),
+              getMapFrameId().c_str());
     return false;
   }
+  const ros::Time expiry = msg.lifetime > 0.0 ? msg.header.stamp + ros::Duration(msg.lifetime) : ros::Time(0);
+  std::vector<MapOverlay::Region> obstacles;
+  for (const auto& polygon : msg.polygons) obstacles.push_back(MapOverlay::createRegion(polygon.points, MapOverlay::State::Untraversable, expiry));
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  invalidateRegions(overlay_.setDynamicObstacles(obstacles, traversabilityMap_));
+  updateOverlay();
   return true;
 }
 
-bool TraversabilityMap::isTraversableForFilters(const grid_map::Index& indexStep) {
+bool TraversabilityMap::setOverride(const std::string& id, const geometry_msgs::PolygonStamped& polygon, const bool isKeepOut,
+                                    const double lifetime) {
+  if (getMapFrameId() != polygon.header.frame_id) {
+    ROS_ERROR("Received override has frame_id = '%s', but frame_id = '%s' is expected.", polygon.header.frame_id.c_str(),
+              getMapFrameId().c_str());
+    return false;
+  }
+  if (polygon.polygon.points.size() < 3) {
+    ROS_WARN("Traversability Estimation: override '%s' has less than three points.", id.c_str());
+    return false;
+  }
+  const MapOverlay::Region region =
+      MapOverlay::createRegion(polygon.polygon.points, isKeepOut ? MapOverlay::State::Untraversable : MapOverlay::State::Traversable,
+                               lifetime > 0.0 ? ros::Time::now() + ros::Duration(lifetime) : ros::Time(0));
   boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  bool currentPositionIsTraversale = true;
-  if (checkForSlope(indexStep)) {
-    if (checkForStep(indexStep)) {
-      if (checkForRoughness_) {
-        if (!checkForRoughness(indexStep)) {
-          currentPositionIsTraversale = false;
-        }
-      }
+  invalidateRegions(overlay_.setOverride(id, region, traversabilityMap_));
+  updateOverlay();
+  return true;
+}
+
+bool TraversabilityMap::removeOverride(const std::string& id) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  const MapOverlay::ChangedBounds changedBounds =
+      id.empty() ? overlay_.clearOverrides(traversabilityMap_) : overlay_.removeOverride(id, traversabilityMap_);
+  if (changedBounds.empty() && !id.empty()) {
+    ROS_WARN("Traversability Estimation: there is no override '%s'.", id.c_str());
+    return false;
+  }
+  invalidateRegions(changedBounds);
+  return true;
+}
+
+void TraversabilityMap::updateOverlay() { invalidateRegions(overlay_.removeExpired(ros::Time::now(), traversabilityMap_)); }
+
+bool TraversabilityMap::getNearestTraversablePose(const geometry_msgs::Pose& goal, const double& radius,
+                                                  const std::vector<geometry_msgs::Point32>& footprint,
+                                                  const std::vector<double>& headings, const double& maxDistance,
+                                                  geometry_msgs::Pose& pose) {
+  const CacheWarming::ActiveQuery activeQuery(cacheWarming_);
+  if (!traversabilityMapInitialized_) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Traversability Estimation: nearest traversable pose: Traversability map not yet initialized.");
+    return false;
+  }
+
+  // A cell is traversable for no heading if its clearance is below the inscribed radius. A polygonal footprint
+  // is traversable for any heading if the clearance exceeds the circumscribed radius, only the cells in between
+  // need a polygon check. Circular footprints are checked as in checkFootprintPath, including the mean traversability.
+  const bool isPolygonal = !footprint.empty();
+  double inscribedRadius = radius;
+  double circumscribedRadius = radius;
+  if (isPolygonal) computeFootprintRadii(footprint, inscribedRadius, circumscribedRadius);
+  // Computes a missing clearance without the lock, the second call only recomputes it if the map changed meanwhile.
+  if (!ensureClearance(circumscribedRadius)) return false;
+
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  updateOverlay();
+  ensureFootprintLayers();
+
+  const grid_map::Position goalPosition(goal.position.x, goal.position.y);
+  grid_map::Index goalIndex;
+  if (!traversabilityMap_.getIndex(goalPosition, goalIndex)) {
+    ROS_WARN("Traversability Estimation: nearest traversable pose: Goal (%f, %f) is outside of the map.", goalPosition.x(),
+             goalPosition.y());
+    return false;
+  }
+  if (!ensureClearance(circumscribedRadius)) return false;
+  std::vector<double> yaws(headings);
+  if (yaws.empty()) yaws.push_back(tf::getYaw(goal.orientation));
+
+  const grid_map::Matrix& clearance = traversabilityMap_[clearanceType_];
+  const grid_map::Size size = traversabilityMap_.getSize();
+  const double resolution = traversabilityMap_.getResolution();
+  double bestDistance = std::numeric_limits<double>::infinity();
+  grid_map::Position bestPosition;
+  double bestYaw = yaws.front();
+
+  auto checkCell = [&](const grid_map::Index& index) {
+    if (!grid_map::checkIfIndexInRange(index, size)) return;
+    grid_map::Position position;
+    traversabilityMap_.getPosition(index, position);
+    const double distance = (position - goalPosition).norm();
+    if (distance > maxDistance || distance >= bestDistance) return;
+    const float cellClearance = clearance(index(0), index(1));
+    if (cellClearance <= inscribedRadius) return;
+    if (isPolygonal && cellClearance <= circumscribedRadius) {
+      double traversability;
+      const auto yaw = std::find_if(yaws.begin(), yaws.end(), [&](const double& yaw) {
+        return isTraversable(getFootprintPolygon(footprint, position, yaw), traversability);
+      });
+      if (yaw == yaws.end()) return;
+      bestYaw = *yaw;
+    } else if (!isPolygonal) {
+      double traversability;
+      if (!isTraversable(position, radius + circularFootprintOffset, traversability, radius)) return;
+      bestYaw = yaws.front();
     } else {
-      currentPositionIsTraversale = false;
+      bestYaw = yaws.front();
     }
-  } else {
-    currentPositionIsTraversale = false;
-  }
-
-  return currentPositionIsTraversale;
-}
-
-bool TraversabilityMap::checkForStep(const grid_map::Index& indexStep) {
-  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  if (traversabilityMap_.at(stepType_, indexStep) == 0.0) {
-    if (!traversabilityMap_.isValid(indexStep, "step_footprint")) {
-      double windowRadiusStep = 2.5 * traversabilityMap_.getResolution();  // 0.075;
-
-      vector<grid_map::Index> indices;
-      grid_map::Position center;
-      traversabilityMap_.getPosition(indexStep, center);
-      double height = traversabilityMap_.at("elevation", indexStep);
-      for (grid_map::CircleIterator circleIterator(traversabilityMap_, center, windowRadiusStep); !circleIterator.isPastEnd();
-           ++circleIterator) {
-        if (traversabilityMap_.at("elevation", *circleIterator) > criticalStepHeight_ + height &&
-            traversabilityMap_.at(stepType_, *circleIterator) == 0.0)
-          indices.push_back(*circleIterator);
-      }
-      if (indices.empty()) indices.push_back(indexStep);
-      for (auto& index : indices) {
-        grid_map::Length subMapLength(2.5 * traversabilityMap_.getResolution(), 2.5 * traversabilityMap_.getResolution());
-        grid_map::Position subMapPos;
-        bool isSuccess;
-        traversabilityMap_.getPosition(index, subMapPos);
-        grid_map::Vector toCenter = center - subMapPos;
-        grid_map::GridMap subMap = traversabilityMap_.getSubmap(subMapPos, subMapLength, isSuccess);
-        if (!isSuccess) {
-          ROS_WARN("Traversability map: Check for step window could not retrieve submap.");
-          traversabilityMap_.at("step_footprint", indexStep) = 0.0;
-          return false;
-        }
-        height = traversabilityMap_.at("elevation", index);
-        for (grid_map::GridMapIterator subMapIterator(subMap); !subMapIterator.isPastEnd(); ++subMapIterator) {
-          if (subMap.at(stepType_, *subMapIterator) == 0.0 && subMap.at("elevation", *subMapIterator) < height - criticalStepHeight_) {
-            grid_map::Position pos;
-            subMap.getPosition(*subMapIterator, pos);
-            grid_map::Vector vec = pos - subMapPos;
-            if (vec.norm() < 0.025) continue;
-            if (toCenter.norm() > 0.025) {
-              if (toCenter.dot(vec) < 0.0) continue;
-            }
-            pos = subMapPos + vec;
-            while ((pos - subMapPos + vec).norm() < maxGapWidth_ && traversabilityMap_.isInside(pos + vec)) pos += vec;
-            grid_map::Index endIndex;
-            traversabilityMap_.getIndex(pos, endIndex);
-            bool gapStart = false;
-            bool gapEnd = false;
-            for (grid_map::LineIterator lineIterator(traversabilityMap_, index, endIndex); !lineIterator.isPastEnd(); ++lineIterator) {
-              if (traversabilityMap_.at("elevation", *lineIterator) > height + criticalStepHeight_) {
-                traversabilityMap_.at("step_footprint", indexStep) = 0.0;
-                return false;
-              }
-              if (traversabilityMap_.at("elevation", *lineIterator) < height - criticalStepHeight_ ||
-                  !traversabilityMap_.isValid(*lineIterator, "elevation")) {
-                gapStart = true;
-              } else if (gapStart) {
-                gapEnd = true;
-                break;
-              }
-            }
-            if (gapStart && !gapEnd) {
-              traversabilityMap_.at("step_footprint", indexStep) = 0.0;
-              return false;
-            }
-          }
-        }
-      }
-      traversabilityMap_.at("step_footprint", indexStep) = 1.0;
-    } else if (traversabilityMap_.at("step_footprint", indexStep) == 0.0) {
-      return false;
+    bestDistance = distance;
+    bestPosition = position;
+  };
+
+  // Cells of ring k are at least k cells away from the goal, stop as soon as no ring can improve the result.
+  const int maxRing = static_cast<int>(std::ceil(maxDistance / resolution)) + 1;
+  for (int ring = 0; ring <= maxRing && (ring - 1) * resolution < bestDistance; ++ring) {
+    if (ring == 0) {
+      checkCell(goalIndex);
+      continue;
+    }
+    for (int offset = -ring; offset <= ring; ++offset) {
+      checkCell(goalIndex + grid_map::Index(-ring, offset));
+      checkCell(goalIndex + grid_map::Index(ring, offset));
+    }
+    for (int offset = -ring + 1; offset < ring; ++offset) {
+      checkCell(goalIndex + grid_map::Index(offset, -ring));
+      checkCell(goalIndex + grid_map::Index(offset, ring));
     }
   }
+  scopedLockForTraversabilityMap.unlock();
+
+  if (bestDistance == std::numeric_limits<double>::infinity()) return false;
+  pose.position.x = bestPosition.x();
+  pose.position.y = bestPosition.y();
+  pose.position.z = goal.position.z;
+  pose.orientation = tf::createQuaternionMsgFromYaw(bestYaw);
   return true;
 }
 
-bool TraversabilityMap::checkForSlope(const grid_map::Index& index) {
-  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  if (traversabilityMap_.at(slopeType_, index) == 0.0) {
-    if (!traversabilityMap_.isValid(index, "slope_footprint")) {
-      double windowRadius = 3.0 * traversabilityMap_.getResolution();  // TODO: read this as a parameter?
-      double criticalLength = maxGapWidth_ / 3.0;
-      int nSlopesCritical = floor(2 * windowRadius * criticalLength / pow(traversabilityMap_.getResolution(), 2));
-
-      // Requested position (center) of circle in map.
-      grid_map::Position center;
-      traversabilityMap_.getPosition(index, center);
-      int nSlopes = 0;
-      for (grid_map::CircleIterator circleIterator(traversabilityMap_, center, windowRadius); !circleIterator.isPastEnd();
-           ++circleIterator) {
-        if (traversabilityMap_.at(slopeType_, *circleIterator) == 0.0) nSlopes++;
-        if (nSlopes > nSlopesCritical) {
-          traversabilityMap_.at("slope_footprint", index) = 0.0;
-          return false;
+unsigned int TraversabilityMap::registerMotionPrimitiveSet(const MotionPrimitiveSet& motionPrimitiveSet) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  motionPrimitiveSets_.push_back(motionPrimitiveSet);
+  if (traversabilityMapInitialized_) motionPrimitiveSets_.back().computeSweptCells(traversabilityMap_.getResolution());
+  return static_cast<unsigned int>(motionPrimitiveSets_.size() - 1);
+}
+
+bool TraversabilityMap::checkMotionPrimitives(const unsigned int motionPrimitiveSet, const std::vector<unsigned int>& primitives,
+                                              const std::vector<geometry_msgs::Pose2D>& starts, std::vector<bool>& isSafe,
+                                              std::vector<double>& traversability, std::vector<double>& cost) {
+  const CacheWarming::ActiveQuery activeQuery(cacheWarming_);
+  if (!traversabilityMapInitialized_) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Traversability Estimation: check motion primitives: Traversability map not yet initialized.");
+    return false;
+  }
+  // Computes a missing clearance without the lock, the second call only recomputes it if the map changed meanwhile.
+  if (!ensureClearance(0.0)) return false;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (motionPrimitiveSet >= motionPrimitiveSets_.size()) {
+    ROS_WARN("Traversability Estimation: check motion primitives: Motion primitive set %u is not registered.", motionPrimitiveSet);
+    return false;
+  }
+  if (primitives.size() != starts.size()) {
+    ROS_WARN("Traversability Estimation: check motion primitives: Got %zu primitives but %zu start poses.", primitives.size(), starts.size());
+    return false;
+  }
+  auto& set = motionPrimitiveSets_[motionPrimitiveSet];
+  if (set.getResolution() != traversabilityMap_.getResolution()) set.computeSweptCells(traversabilityMap_.getResolution());
+  updateOverlay();
+  if (!ensureClearance(0.0)) return false;
+
+  const grid_map::Matrix& clearance = traversabilityMap_[clearanceType_];
+  const grid_map::Size size = traversabilityMap_.getSize();
+  isSafe.assign(primitives.size(), false);
+  traversability.assign(primitives.size(), 0.0);
+  cost.assign(primitives.size(), std::numeric_limits<double>::infinity());
+
+  for (size_t i = 0; i < primitives.size(); ++i) {
+    if (primitives[i] >= set.getNumberOfPrimitives()) {
+      ROS_WARN("Traversability Estimation: check motion primitives: Motion primitive %u is not in set %u.", primitives[i],
+               motionPrimitiveSet);
+      return false;
+    }
+    grid_map::Index startIndex;
+    if (!traversabilityMap_.getIndex(grid_map::Position(starts[i].x, starts[i].y), startIndex)) {
+      // Start outside of the map, as for footprints outside of the map.
+      isSafe[i] = traversabilityDefault_ != 0.0;
+      traversability[i] = traversabilityDefault_;
+    } else {
+      // Reduction over the swept cells, cells outside of the map have the default traversability.
+      bool primitiveIsSafe = true;
+      double traversabilitySum = 0.0;
+      const auto& sweptCells = set.getSweptCells(primitives[i], set.getHeadingBin(starts[i].theta));
+      for (const auto& offset : sweptCells) {
+        const grid_map::Index index = startIndex + offset;
+        if ((index < 0).any() || (index >= size).any()) {
+          primitiveIsSafe = traversabilityDefault_ != 0.0;
+          traversabilitySum += traversabilityDefault_;
+        } else if (clearance(index(0), index(1)) <= 0.0) {
+          primitiveIsSafe = false;
+        } else {
+          traversabilitySum += getCellTraversability(index);
         }
+        if (!primitiveIsSafe) break;
       }
-      traversabilityMap_.at("slope_footprint", index) = 1.0;
-    } else if (traversabilityMap_.at("slope_footprint", index) == 0.0) {
-      return false;
+      isSafe[i] = primitiveIsSafe;
+      if (primitiveIsSafe) traversability[i] = sweptCells.empty() ? traversabilityDefault_ : traversabilitySum / sweptCells.size();
     }
+    if (isSafe[i]) cost[i] = set.getLength(primitives[i]) * (1.0 + motionPrimitiveTraversabilityWeight_ * (1.0 - traversability[i]));
   }
   return true;
 }
 
-bool TraversabilityMap::checkForRoughness(const grid_map::Index& index) {
-  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
-  if (traversabilityMap_.at(roughnessType_, index) == 0.0) {
-    if (!traversabilityMap_.isValid(index, "roughness_footprint")) {
-      double windowRadius = 3.0 * traversabilityMap_.getResolution();  // TODO: read this as a parameter?
-      double criticalLength = maxGapWidth_ / 3.0;
-      int nRoughnessCritical = floor(1.5 * windowRadius * criticalLength / pow(traversabilityMap_.getResolution(), 2));
-
-      // Requested position (center) of circle in map.
-      grid_map::Position center;
-      traversabilityMap_.getPosition(index, center);
-      int nRoughness = 0;
-      for (grid_map::CircleIterator circleIterator(traversabilityMap_, center, windowRadius); !circleIterator.isPastEnd();
-           ++circleIterator) {
-        if (traversabilityMap_.at(roughnessType_, *circleIterator) == 0.0) nRoughness++;
-        if (nRoughness > nRoughnessCritical) {
-          traversabilityMap_.at("roughness_footprint", index) = 0.0;
-          return false;
-        }
-      }
-      traversabilityMap_.at("roughness_footprint", index) = 1.0;
-    } else if (traversabilityMap_.at("roughness_footprint", index) == 0.0) {
-      return false;
+void TraversabilityMap::setRobotPosition(const grid_map::Position& position) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  robotPosition_ = position;
+  robotPositionInitialized_ = true;
+}
+
+bool TraversabilityMap::computeCostToGoFromRobot() {
+  if (!traversabilityMapInitialized_ || !ensureClearance(circularFootprintRadius_)) return false;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  grid_map::Index robotIndex;
+  if (!robotPositionInitialized_ || !traversabilityMap_.getIndex(robotPosition_, robotIndex)) {
+    ROS_WARN_THROTTLE(periodThrottledConsoleMessages, "Traversability Map: Robot is not inside the map, cost-to-go is not computed.");
+    return false;
+  }
+  if (!ensureClearance(circularFootprintRadius_)) return false;
+
+  // Initialize timer.
+  ros::WallTime start = ros::WallTime::now();
+
+  const BinaryMatrix isFree = (traversabilityMap_[clearanceType_].array() > circularFootprintRadius_).matrix();
+  const float traversabilityDefault = static_cast<float>(traversabilityDefault_);
+  const grid_map::Matrix traversability = traversabilityMap_[traversabilityType_].unaryExpr(
+      [traversabilityDefault](float value) { return std::isfinite(value) ? value : traversabilityDefault; });
+  grid_map::Matrix costToGo;
+  computeCostToGo(isFree, traversability, robotIndex, traversabilityMap_.getResolution(), costToGoTraversabilityWeight_, costToGo);
+  traversabilityMap_.add(costToGoType_, costToGo);
+  scopedLockForTraversabilityMap.unlock();
+
+  ROS_DEBUG("Cost-to-go has been computed in %f s.", (ros::WallTime::now() - start).toSec());
+  return true;
+}
+
+bool TraversabilityMap::computeTraversableComponents() {
+  if (!traversabilityMapInitialized_ || !ensureClearance(circularFootprintRadius_)) return false;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (!ensureClearance(circularFootprintRadius_)) return false;
+
+  // Initialize timer.
+  ros::WallTime start = ros::WallTime::now();
+
+  traversableComponents_.compute(traversabilityMap_, clearanceType_, circularFootprintRadius_);
+  scopedLockForTraversabilityMap.unlock();
+
+  ROS_DEBUG("Traversable components have been computed in %f s.", (ros::WallTime::now() - start).toSec());
+  return true;
+}
+
+void TraversabilityMap::updateTraversableComponents(const Eigen::AlignedBox2d& bounds) {
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  if (!getIndexRange(traversabilityMap_, bounds, startIndex, size)) return;
+  // The clearance is only updated up to the reach of the footprints, which covers the configured one.
+  if (!ensureClearance(circularFootprintRadius_)) {
+    traversableComponents_.invalidate();
+    return;
+  }
+  traversableComponents_.update(traversabilityMap_, clearanceType_, circularFootprintRadius_, startIndex, size);
+}
+
+bool TraversabilityMap::areInSameTraversableComponent(const grid_map::Position& positionA, const grid_map::Position& positionB,
+                                                      bool& isConnected) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  return traversableComponents_.areConnected(traversabilityMap_, positionA, positionB, isConnected);
+}
+
+TraversabilityMap::FootprintClearance TraversabilityMap::checkFootprintClearance(const grid_map::Position& start,
+                                                                               const grid_map::Position& end,
+                                                                               const double inscribedRadius,
+                                                                               const double circumscribedRadius) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  grid_map::Index startIndex, endIndex;
+  if (!traversabilityMap_.getIndex(start, startIndex) || !traversabilityMap_.getIndex(end, endIndex)) {
+    return FootprintClearance::Undecided;
+  }
+  // The clearance is known at cell centers. The footprint origin is up to half a cell diagonal away from the
+  // center of its cell, and a segment is up to a cell diagonal away from the centers of its line cells.
+  const grid_map::Matrix& clearance = traversabilityMap_[clearanceType_];
+  const double resolution = traversabilityMap_.getResolution();
+  const double originMargin = M_SQRT1_2 * resolution;
+  if (clearance(startIndex(0), startIndex(1)) < inscribedRadius - originMargin ||
+      clearance(endIndex(0), endIndex(1)) < inscribedRadius - originMargin) {
+    return FootprintClearance::Occupied;
+  }
+  const double requiredClearance = circumscribedRadius + ((startIndex == endIndex).all() ? originMargin : M_SQRT2 * resolution);
+  for (grid_map::LineIterator iterator(traversabilityMap_, startIndex, endIndex); !iterator.isPastEnd(); ++iterator) {
+    const grid_map::Index index(*iterator);
+    if (clearance(index(0), index(1)) <= requiredClearance) return FootprintClearance::Undecided;
+  }
+  return FootprintClearance::Free;
+}
+
+bool TraversabilityMap::getMeanTraversability(const grid_map::Polygon& polygon, double& traversability) {
+  unsigned int nCells = 0;
+  traversability = 0.0;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  for (grid_map::PolygonIterator polygonIterator(traversabilityMap_, polygon); !polygonIterator.isPastEnd(); ++polygonIterator) {
+    nCells++;
+    traversability += getCellTraversability(*polygonIterator);
+  }
+  scopedLockForTraversabilityMap.unlock();
+
+  if (nCells == 0) {
+    traversability = traversabilityDefault_;
+    return traversabilityDefault_ != 0.0;
+  }
+  traversability /= nCells;
+  return true;
+}
+
+void TraversabilityMap::computeFootprintRadii(const std::vector<geometry_msgs::Point32>& footprint, double& inscribedRadius,
+                                              double& circumscribedRadius) const {
+  grid_map::Polygon polygon;
+  for (const auto& point : footprint) {
+    polygon.addVertex(grid_map::Position(point.x, point.y));
+  }
+  const bool originIsInside = polygon.isInside(grid_map::Position::Zero());
+  inscribedRadius = originIsInside ? std::numeric_limits<double>::infinity() : 0.0;
+  circumscribedRadius = 0.0;
+  const auto& vertices = polygon.getVertices();
+  for (size_t i = 0; i < vertices.size(); i++) {
+    const grid_map::Position& vertex = vertices[i];
+    const grid_map::Position& nextVertex = vertices[(i + 1) % vertices.size()];
+    circumscribedRadius = std::max(circumscribedRadius, vertex.norm());
+    if (!originIsInside) continue;
+    // Distance of the origin to the edge.
+    const grid_map::Vector edge = nextVertex - vertex;
+    const double t = edge.squaredNorm() > 0.0 ? std::min(std::max(-vertex.dot(edge) / edge.squaredNorm(), 0.0), 1.0) : 0.0;
+    inscribedRadius = std::min(inscribedRadius, (vertex + t * edge).norm());
+  }
+}
+
+grid_map::Polygon TraversabilityMap::getFootprintPolygon(const std::vector<geometry_msgs::Point32>& footprint,
+                                                         const grid_map::Position& position, const double& yaw) const {
+  grid_map::Polygon polygon;
+  polygon.setFrameId(getMapFrameId());
+  const Eigen::Rotation2Dd rotation(yaw);
+  for (const auto& point : footprint) {
+    polygon.addVertex(position + rotation * grid_map::Position(point.x, point.y));
+  }
+  return polygon;
+}
+
+bool TraversabilityMap::checkInclination(const grid_map::Position& start, const grid_map::Position& end) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  if (end == start) {
+    if (traversabilityMap_.atPosition(robotSlopeType_, start) == 0.0) return false;
+  } else {
+    grid_map::Index startIndex, endIndex;
+    traversabilityMap_.getIndex(start, startIndex);
+    traversabilityMap_.getIndex(end, endIndex);
+    for (grid_map::LineIterator lineIterator(traversabilityMap_, startIndex, endIndex); !lineIterator.isPastEnd(); ++lineIterator) {
+      if (!traversabilityMap_.isValid(*lineIterator, robotSlopeType_)) continue;
+      if (traversabilityMap_.at(robotSlopeType_, *lineIterator) == 0.0) return false;
     }
   }
   return true;
 }
 
+bool TraversabilityMap::updateFilter() {
+  // Reconfigure filter chain.
+  filter_chain_.clear();
+  return configureFilters();
+}
+
+double TraversabilityMap::getCellTraversability(const grid_map::Index& index) const {
+  if (overlay_.getState(index) == MapOverlay::State::Traversable) return 1.0;
+  const float traversability = getLayerValue(tiledTraversability_, traversabilityType_, index);
+  return std::isfinite(traversability) ? traversability : traversabilityDefault_;
+}
+
+bool TraversabilityMap::isTraversableForFilters(const grid_map::Index& indexStep) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  return checkFilters(indexStep);
+}
+
+bool TraversabilityMap::checkFilters(const grid_map::Index& index) { return getFilterChecks().check(index); }
+
+FilterChecks TraversabilityMap::getFilterChecks() {
+  FilterChecks filterChecks(filterCheckParameters_, traversabilityMap_, overlay_);
+  if (tiledLayersValid_) filterChecks.setTiledLayers(tiledStep_, tiledElevation_);
+  if (footprintCaches_.isSparse()) filterChecks.setSparseFootprintCaches(footprintCaches_.getSparseCaches(), false);
+  return filterChecks;
+}
+
 void TraversabilityMap::publishFootprintPolygon(const grid_map::Polygon& polygon, double zPosition) {
   if (footprintPublisher_.getNumSubscribers() < 1) return;
   geometry_msgs::PolygonStamped polygonMsg;
@@ -930,6 +2176,16 @@ void TraversabilityMap::publishFootprintPolygon(const grid_map::Polygon& polygon
   footprintPublisher_.publish(polygonMsg);
 }
 
+void TraversabilityMap::publishUntraversablePolygon(double zPosition) {
+  if (untraversablePolygonPublisher_.getNumSubscribers() < 1 || untraversableCells_.empty()) return;
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
+  grid_map::Polygon untraversablePolygon = untraversableCells_.getConvexHull(traversabilityMap_);
+  scopedLockForTraversabilityMap.unlock();
+  untraversablePolygon.setFrameId(getMapFrameId());
+  untraversablePolygon.setTimestamp(ros::Time::now().toNSec());
+  publishUntraversablePolygon(untraversablePolygon, zPosition);
+}
+
 void TraversabilityMap::publishUntraversablePolygon(const grid_map::Polygon& untraversablePolygon, double zPosition) {
   if (untraversablePolygonPublisher_.getNumSubscribers() < 1 || untraversablePolygon.nVertices() == 0) {
     return;
@@ -947,7 +2203,10 @@ std::string TraversabilityMap::getMapFrameId() const { return mapFrameId_; }
 double TraversabilityMap::getDefaultTraversabilityUnknownRegions() const { return traversabilityDefault_; }
 
 void TraversabilityMap::setDefaultTraversabilityUnknownRegions(const double& defaultTraversability) {
+  boost::recursive_mutex::scoped_lock scopedLockForTraversabilityMap(traversabilityMapMutex_);
   traversabilityDefault_ = boundTraversabilityValue(defaultTraversability);
+  // Cached segments depend on the traversability of unknown regions.
+  segmentCache_.clear();
 }
 
 void TraversabilityMap::restoreDefaultTraversabilityUnknownRegionsReadAtInit() {
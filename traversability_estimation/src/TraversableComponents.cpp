@@ -0,0 +1,49 @@
+/*
+ * TraversableComponents.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/TraversableComponents.hpp"
+
+// STD
+#include <cmath>
+
+namespace traversability_estimation {
+
+TraversableComponents::TraversableComponents(const std::string& layer) : layer_(layer), isValid_(false) {}
+
+void TraversableComponents::compute(grid_map::GridMap& map, const std::string& clearanceLayer, const double radius) {
+  components_.compute((map[clearanceLayer].array() > radius).matrix());
+  setLayer(map);
+  isValid_ = true;
+}
+
+void TraversableComponents::update(grid_map::GridMap& map, const std::string& clearanceLayer, const double radius,
+                                   const grid_map::Index& startIndex, const grid_map::Size& size) {
+  components_.update((map[clearanceLayer].array() > radius).matrix(), startIndex, size);
+  setLayer(map);
+}
+
+bool TraversableComponents::areConnected(const grid_map::GridMap& map, const grid_map::Position& positionA,
+                                         const grid_map::Position& positionB, bool& isConnected) const {
+  if (!isValid_) return false;
+  grid_map::Index indexA, indexB;
+  if (!map.getIndex(positionA, indexA) || !map.getIndex(positionB, indexB)) {
+    isConnected = false;
+    return true;
+  }
+  const int label = components_.getLabel(indexA);
+  isConnected = label != ConnectedComponents::noLabel && label == components_.getLabel(indexB);
+  return true;
+}
+
+void TraversableComponents::setLayer(grid_map::GridMap& map) const {
+  map.add(layer_, components_.getLabels().unaryExpr([](const int label) {
+    return label == ConnectedComponents::noLabel ? NAN : static_cast<float>(label);
+  }));
+}
+
+}  // namespace traversability_estimation
@@ -0,0 +1,90 @@
+/*
+ * UntraversableCells.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/UntraversableCells.hpp"
+#include "traversability_estimation/ContourExtraction.hpp"
+
+namespace traversability_estimation {
+
+void UntraversableCells::reset(const grid_map::Size& size) {
+  if ((size != size_).any()) {
+    size_ = size;
+    isAdded_.assign(static_cast<size_t>(size.prod()), false);
+  } else {
+    for (const auto linearIndex : linearIndices_) isAdded_[linearIndex] = false;
+  }
+  linearIndices_.clear();
+  polygons_.clear();
+  minIndex_ = size_;
+  maxIndex_.setConstant(-1);
+}
+
+void UntraversableCells::add(const grid_map::Index& index) {
+  const size_t linearIndex = grid_map::getLinearIndexFromIndex(index, size_);
+  if (isAdded_[linearIndex]) return;
+  isAdded_[linearIndex] = true;
+  linearIndices_.push_back(linearIndex);
+  minIndex_ = minIndex_.min(index);
+  maxIndex_ = maxIndex_.max(index);
+}
+
+void UntraversableCells::add(const grid_map::Polygon& polygon) { polygons_.push_back(polygon); }
+
+bool UntraversableCells::empty() const { return linearIndices_.empty() && polygons_.empty(); }
+
+grid_map::Polygon UntraversableCells::getConvexHull(const grid_map::GridMap& map) const {
+  if (empty()) return grid_map::Polygon();
+  std::vector<grid_map::Position> positions;
+  positions.reserve(linearIndices_.size());
+  for (const auto linearIndex : linearIndices_) {
+    grid_map::Position position;
+    map.getPosition(grid_map::getIndexFromLinearIndex(linearIndex, size_), position);
+    positions.push_back(position);
+  }
+  for (const auto& polygon : polygons_) {
+    positions.insert(positions.end(), polygon.getVertices().begin(), polygon.getVertices().end());
+  }
+  return grid_map::Polygon::monotoneChainConvexHullOfPoints(positions);
+}
+
+std::vector<grid_map::Polygon> UntraversableCells::getComponents(const grid_map::GridMap& map) const {
+  std::vector<grid_map::Polygon> components(polygons_);
+  if (linearIndices_.empty()) return components;
+
+  // Trace the regions within the bounding box of the cells.
+  const grid_map::Size boxSize = maxIndex_ - minIndex_ + 1;
+  BinaryMatrix mask = BinaryMatrix::Constant(boxSize(0), boxSize(1), false);
+  for (const auto linearIndex : linearIndices_) {
+    const grid_map::Index index = grid_map::getIndexFromLinearIndex(linearIndex, size_) - minIndex_;
+    mask(index(0), index(1)) = true;
+  }
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+
+  grid_map::Position origin;
+  map.getPosition(minIndex_, origin);
+  const double resolution = map.getResolution();
+  for (const auto& contour : contours) {
+    // Outer boundaries are clockwise (negative area), holes are skipped.
+    double doubleArea = 0.0;
+    for (size_t i = 0; i < contour.size(); ++i) {
+      const Eigen::Vector2d& vertex = contour[i];
+      const Eigen::Vector2d& nextVertex = contour[(i + 1) % contour.size()];
+      doubleArea += vertex.x() * nextVertex.y() - nextVertex.x() * vertex.y();
+    }
+    if (doubleArea >= 0.0) continue;
+    grid_map::Polygon polygon;
+    for (const auto& vertex : simplifyContour(contour, 0.0)) {
+      polygon.addVertex(origin - resolution * vertex);
+    }
+    components.push_back(polygon);
+  }
+  return components;
+}
+
+}  // namespace traversability_estimation
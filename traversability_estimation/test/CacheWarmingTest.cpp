@@ -0,0 +1,109 @@
+/*
+ * CacheWarmingTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/CacheWarming.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+grid_map::GridMap createGeometry() {
+  grid_map::GridMap geometry;
+  geometry.setGeometry(grid_map::Length(2.0, 2.0), 0.1);
+  return geometry;
+}
+
+}  // namespace
+
+TEST(CacheWarming, CorridorCells) {
+  const grid_map::GridMap geometry = createGeometry();
+  const std::vector<grid_map::Position> corridor{grid_map::Position(-0.5, 0.0), grid_map::Position(0.5, 0.0)};
+  const double radius = 0.15;
+  const std::vector<grid_map::Index> cells = CacheWarming::getCorridorCells(geometry, corridor, radius);
+
+  // Each cell within the radius of the segment is listed once.
+  std::set<std::pair<int, int>> uniqueCells;
+  for (const auto& index : cells) uniqueCells.emplace(index(0), index(1));
+  EXPECT_EQ(cells.size(), uniqueCells.size());
+  grid_map::Position position;
+  for (int i = 0; i < geometry.getSize()(0); ++i) {
+    for (int j = 0; j < geometry.getSize()(1); ++j) {
+      geometry.getPosition(grid_map::Index(i, j), position);
+      // Distance to the segment of the corridor.
+      const grid_map::Position closest(std::min(std::max(position.x(), -0.5), 0.5), 0.0);
+      const double distance = (position - closest).norm();
+      if (distance < radius - 0.01) {
+        EXPECT_EQ(1u, uniqueCells.count(std::make_pair(i, j))) << position.transpose();
+      } else if (distance > radius + 0.01) {
+        EXPECT_EQ(0u, uniqueCells.count(std::make_pair(i, j))) << position.transpose();
+      }
+    }
+  }
+
+  // The cells at the start come first.
+  geometry.getPosition(cells.front(), position);
+  EXPECT_LT((position - corridor.front()).norm(), radius);
+  geometry.getPosition(cells.back(), position);
+  EXPECT_LT((position - corridor.back()).norm(), radius);
+  EXPECT_TRUE(CacheWarming::getCorridorCells(geometry, std::vector<grid_map::Position>(), radius).empty());
+}
+
+TEST(CacheWarming, WarmsRequestedCorridor) {
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t nWarmedCells = 0;
+  CacheWarming cacheWarming;
+  cacheWarming.setParameters(true, 0.3, 0);
+  cacheWarming.start(
+      [](grid_map::GridMap& geometry, uint64_t& generation) {
+        geometry = createGeometry();
+        generation = 1;
+        return true;
+      },
+      [&](const std::vector<grid_map::Index>& cells, const uint64_t generation) {
+        EXPECT_EQ(1u, generation);
+        EXPECT_LE(cells.size(), 64u);
+        std::lock_guard<std::mutex> lock(mutex);
+        nWarmedCells += cells.size();
+        condition.notify_all();
+        return true;
+      });
+  const std::vector<grid_map::Position> corridor{grid_map::Position(0.0, 0.0)};
+  const size_t nCells = CacheWarming::getCorridorCells(createGeometry(), corridor, 0.3).size();
+  ASSERT_GT(nCells, 0u);
+  cacheWarming.request(corridor);
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait_for(lock, std::chrono::seconds(5), [&]() { return nWarmedCells == nCells; });
+  lock.unlock();
+  cacheWarming.stop();
+  EXPECT_EQ(nCells, nWarmedCells);
+}
+
+TEST(CacheWarming, Disabled) {
+  CacheWarming cacheWarming;
+  cacheWarming.start([](grid_map::GridMap&, uint64_t&) { return true; },
+                     [](const std::vector<grid_map::Index>&, uint64_t) {
+                       ADD_FAILURE() << "warmed cells while disabled";
+                       return true;
+                     });
+  cacheWarming.request(std::vector<grid_map::Position>{grid_map::Position(0.0, 0.0)});
+  cacheWarming.stop();
+}
@@ -0,0 +1,163 @@
+/*
+ * ConnectedComponentsTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/ConnectedComponents.hpp"
+
+// Traversability estimation filters
+#include <filters/ThreadPool.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Labels the components of the free cells in 8-connectivity with a flood fill.
+Eigen::MatrixXi labelByFloodFill(const BinaryMatrix& isFree) {
+  Eigen::MatrixXi labels = Eigen::MatrixXi::Constant(isFree.rows(), isFree.cols(), ConnectedComponents::noLabel);
+  int nLabels = 0;
+  std::vector<Eigen::Array2i> stack;
+  for (int col = 0; col < isFree.cols(); ++col) {
+    for (int row = 0; row < isFree.rows(); ++row) {
+      if (!isFree(row, col) || labels(row, col) != ConnectedComponents::noLabel) continue;
+      labels(row, col) = nLabels;
+      stack.emplace_back(row, col);
+      while (!stack.empty()) {
+        const Eigen::Array2i cell = stack.back();
+        stack.pop_back();
+        for (int rowOffset = -1; rowOffset <= 1; ++rowOffset) {
+          for (int colOffset = -1; colOffset <= 1; ++colOffset) {
+            const Eigen::Array2i neighbor = cell + Eigen::Array2i(rowOffset, colOffset);
+            if ((neighbor < 0).any() || neighbor(0) >= isFree.rows() || neighbor(1) >= isFree.cols()) continue;
+            if (!isFree(neighbor(0), neighbor(1)) || labels(neighbor(0), neighbor(1)) != ConnectedComponents::noLabel) continue;
+            labels(neighbor(0), neighbor(1)) = nLabels;
+            stack.push_back(neighbor);
+          }
+        }
+      }
+      ++nLabels;
+    }
+  }
+  return labels;
+}
+
+//! Checks that two labelings describe the same components, i.e. are equal up to a renaming of the labels.
+void expectSameComponents(const Eigen::MatrixXi& expected, const Eigen::MatrixXi& labels) {
+  ASSERT_EQ(expected.rows(), labels.rows());
+  ASSERT_EQ(expected.cols(), labels.cols());
+  std::map<int, int> expectedToLabel, labelToExpected;
+  for (int i = 0; i < expected.size(); ++i) {
+    if (expected(i) == ConnectedComponents::noLabel) {
+      EXPECT_EQ(ConnectedComponents::noLabel, labels(i)) << "cell " << i;
+      continue;
+    }
+    ASSERT_NE(ConnectedComponents::noLabel, labels(i)) << "cell " << i;
+    const auto forward = expectedToLabel.emplace(expected(i), labels(i));
+    const auto backward = labelToExpected.emplace(labels(i), expected(i));
+    EXPECT_EQ(forward.first->second, labels(i)) << "cell " << i;
+    EXPECT_EQ(backward.first->second, expected(i)) << "cell " << i;
+  }
+}
+
+BinaryMatrix createMask(const int rows, const int cols, const double freeProbability, std::mt19937& generator) {
+  std::bernoulli_distribution isFreeDistribution(freeProbability);
+  BinaryMatrix isFree(rows, cols);
+  for (int i = 0; i < isFree.size(); ++i) isFree(i) = isFreeDistribution(generator);
+  return isFree;
+}
+
+}  // namespace
+
+TEST(ConnectedComponents, MatchesFloodFill) {
+  // Several strips of columns are labeled in parallel and merged.
+  filters::ThreadPool::getInstance().configure(3, std::vector<int>(), 0, 0);
+  std::mt19937 generator(42);
+  for (const double freeProbability : {0.3, 0.55, 0.9}) {
+    const BinaryMatrix isFree = createMask(41, 67, freeProbability, generator);
+    ConnectedComponents components;
+    components.compute(isFree);
+    expectSameComponents(labelByFloodFill(isFree), components.getLabels());
+  }
+}
+
+TEST(ConnectedComponents, DiagonalCellsAreConnected) {
+  BinaryMatrix isFree = BinaryMatrix::Constant(3, 3, false);
+  isFree(0, 0) = true;
+  isFree(1, 1) = true;
+  isFree(2, 0) = true;
+  ConnectedComponents components;
+  components.compute(isFree);
+  EXPECT_NE(ConnectedComponents::noLabel, components.getLabel(Eigen::Array2i(0, 0)));
+  EXPECT_EQ(components.getLabel(Eigen::Array2i(0, 0)), components.getLabel(Eigen::Array2i(1, 1)));
+  EXPECT_EQ(components.getLabel(Eigen::Array2i(0, 0)), components.getLabel(Eigen::Array2i(2, 0)));
+  EXPECT_EQ(ConnectedComponents::noLabel, components.getLabel(Eigen::Array2i(0, 1)));
+  EXPECT_EQ(ConnectedComponents::noLabel, components.getLabel(Eigen::Array2i(-1, 0)));
+  EXPECT_EQ(ConnectedComponents::noLabel, components.getLabel(Eigen::Array2i(0, 3)));
+}
+
+TEST(ConnectedComponents, UpdateMatchesRecomputation) {
+  filters::ThreadPool::getInstance().configure(3, std::vector<int>(), 0, 0);
+  std::mt19937 generator(7);
+  BinaryMatrix isFree = createMask(53, 71, 0.6, generator);
+  ConnectedComponents components;
+  components.compute(isFree);
+
+  std::uniform_int_distribution<int> rowDistribution(0, 52), colDistribution(0, 70), sizeDistribution(1, 12);
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    const Eigen::Array2i start(rowDistribution(generator), colDistribution(generator));
+    const Eigen::Array2i size = Eigen::Array2i(sizeDistribution(generator), sizeDistribution(generator))
+                                    .min(Eigen::Array2i(53, 71) - start);
+    const BinaryMatrix region = createMask(size(0), size(1), iteration % 2 == 0 ? 0.2 : 0.9, generator);
+    const Eigen::MatrixXi previousLabels = components.getLabels();
+    isFree.block(start(0), start(1), size(0), size(1)) = region;
+    components.update(isFree, start, size);
+    const Eigen::MatrixXi expected = labelByFloodFill(isFree);
+    expectSameComponents(expected, components.getLabels());
+
+    // Components which do not touch the region or its border keep their labels.
+    std::set<int> touchingComponents;
+    for (int col = std::max(start(1) - 1, 0); col < std::min(start(1) + size(1) + 1, 71); ++col) {
+      for (int row = std::max(start(0) - 1, 0); row < std::min(start(0) + size(0) + 1, 53); ++row) {
+        if (expected(row, col) != ConnectedComponents::noLabel) touchingComponents.insert(expected(row, col));
+      }
+    }
+    for (int i = 0; i < expected.size(); ++i) {
+      if (expected(i) == ConnectedComponents::noLabel || touchingComponents.count(expected(i)) > 0) continue;
+      EXPECT_EQ(previousLabels(i), components.getLabels()(i)) << "cell " << i << ", iteration " << iteration;
+    }
+  }
+}
+
+TEST(ConnectedComponents, UpdateSplitsAndMergesComponents) {
+  // A free corridor of 3 rows.
+  BinaryMatrix isFree = BinaryMatrix::Constant(5, 40, false);
+  isFree.block(1, 0, 3, 40).setConstant(true);
+  ConnectedComponents components;
+  components.compute(isFree);
+  EXPECT_EQ(components.getLabel(Eigen::Array2i(2, 0)), components.getLabel(Eigen::Array2i(2, 39)));
+
+  // Blocking the corridor splits it.
+  isFree.block(1, 20, 3, 1).setConstant(false);
+  components.update(isFree, Eigen::Array2i(1, 20), Eigen::Array2i(3, 1));
+  EXPECT_NE(components.getLabel(Eigen::Array2i(2, 0)), components.getLabel(Eigen::Array2i(2, 39)));
+  EXPECT_EQ(ConnectedComponents::noLabel, components.getLabel(Eigen::Array2i(2, 20)));
+
+  // Opening a single cell merges the parts again.
+  isFree(3, 20) = true;
+  components.update(isFree, Eigen::Array2i(3, 20), Eigen::Array2i(1, 1));
+  EXPECT_EQ(components.getLabel(Eigen::Array2i(2, 0)), components.getLabel(Eigen::Array2i(2, 39)));
+  expectSameComponents(labelByFloodFill(isFree), components.getLabels());
+}
@@ -0,0 +1,143 @@
+/*
+ * ContourExtractionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/ContourExtraction.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Signed area of a closed contour in (row, column) coordinates.
+double computeSignedArea(const Contour& contour) {
+  double area = 0.0;
+  for (size_t i = 0; i < contour.size(); ++i) {
+    const Eigen::Vector2d& a = contour[i];
+    const Eigen::Vector2d& b = contour[(i + 1) % contour.size()];
+    area += a.x() * b.y() - b.x() * a.y();
+  }
+  return 0.5 * area;
+}
+
+//! Value of a cell of the mask, cells outside are unset.
+bool isSet(const BinaryMatrix& mask, const int row, const int col) {
+  return row >= 0 && row < mask.rows() && col >= 0 && col < mask.cols() && mask(row, col);
+}
+
+//! Checks that every vertex lies halfway between a set and an unset cell.
+void expectVerticesOnBoundary(const BinaryMatrix& mask, const std::vector<Contour>& contours) {
+  for (const auto& contour : contours) {
+    for (const auto& vertex : contour) {
+      const bool isRowHalf = std::abs(vertex.x() - std::floor(vertex.x()) - 0.5) < 1e-9;
+      const bool isColHalf = std::abs(vertex.y() - std::floor(vertex.y()) - 0.5) < 1e-9;
+      ASSERT_NE(isRowHalf, isColHalf) << "vertex (" << vertex.x() << ", " << vertex.y() << ")";
+      const int row = static_cast<int>(std::floor(vertex.x()));
+      const int col = static_cast<int>(std::floor(vertex.y()));
+      if (isRowHalf) {
+        EXPECT_NE(isSet(mask, row, col), isSet(mask, row + 1, col)) << "vertex (" << vertex.x() << ", " << vertex.y() << ")";
+      } else {
+        EXPECT_NE(isSet(mask, row, col), isSet(mask, row, col + 1)) << "vertex (" << vertex.x() << ", " << vertex.y() << ")";
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ContourExtraction, EmptyMask) {
+  std::vector<Contour> contours;
+  extractContours(BinaryMatrix::Constant(4, 5, false), contours);
+  EXPECT_TRUE(contours.empty());
+}
+
+TEST(ContourExtraction, SingleCell) {
+  BinaryMatrix mask = BinaryMatrix::Constant(5, 5, false);
+  mask(2, 3) = true;
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+  ASSERT_EQ(1u, contours.size());
+  ASSERT_EQ(4u, contours[0].size());
+  for (const auto& vertex : contours[0]) EXPECT_NEAR(0.5, (vertex - Eigen::Vector2d(2.0, 3.0)).norm(), 1e-9);
+  expectVerticesOnBoundary(mask, contours);
+}
+
+TEST(ContourExtraction, CellsAtTheBorder) {
+  // The contours are closed around cells on the border of the mask.
+  const BinaryMatrix mask = BinaryMatrix::Constant(3, 4, true);
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+  ASSERT_EQ(1u, contours.size());
+  expectVerticesOnBoundary(mask, contours);
+}
+
+TEST(ContourExtraction, DiagonalCellsAreConnected) {
+  BinaryMatrix mask = BinaryMatrix::Constant(4, 4, false);
+  mask(1, 1) = true;
+  mask(2, 2) = true;
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+  ASSERT_EQ(1u, contours.size());
+  EXPECT_EQ(8u, contours[0].size());
+  expectVerticesOnBoundary(mask, contours);
+}
+
+TEST(ContourExtraction, HoleHasOppositeOrientation) {
+  BinaryMatrix mask = BinaryMatrix::Constant(7, 7, false);
+  mask.block(1, 1, 5, 5).setConstant(true);
+  mask.block(3, 3, 1, 1).setConstant(false);
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+  ASSERT_EQ(2u, contours.size());
+  expectVerticesOnBoundary(mask, contours);
+  const double firstArea = computeSignedArea(contours[0]);
+  const double secondArea = computeSignedArea(contours[1]);
+  EXPECT_LT(firstArea * secondArea, 0.0);
+  // The outer boundary encloses the larger area.
+  const Contour& outer = std::abs(firstArea) > std::abs(secondArea) ? contours[0] : contours[1];
+  const Contour& hole = std::abs(firstArea) > std::abs(secondArea) ? contours[1] : contours[0];
+  EXPECT_GT(std::abs(computeSignedArea(outer)), 16.0);
+  EXPECT_NEAR(0.5, std::abs(computeSignedArea(hole)), 1e-9);
+}
+
+TEST(ContourExtraction, SeparateRegions) {
+  BinaryMatrix mask = BinaryMatrix::Constant(6, 6, false);
+  mask.block(0, 0, 2, 2).setConstant(true);
+  mask.block(4, 3, 2, 3).setConstant(true);
+  std::vector<Contour> contours;
+  extractContours(mask, contours);
+  EXPECT_EQ(2u, contours.size());
+  expectVerticesOnBoundary(mask, contours);
+}
+
+TEST(ContourExtraction, SimplifyRemovesCollinearVertices) {
+  Contour square;
+  for (int i = 0; i < 4; ++i) square.emplace_back(i, 0.0);
+  for (int i = 0; i < 4; ++i) square.emplace_back(4.0, i);
+  for (int i = 4; i > 0; --i) square.emplace_back(i, 4.0);
+  for (int i = 4; i > 0; --i) square.emplace_back(0.0, i);
+  const Contour simplified = simplifyContour(square, 1e-6);
+  ASSERT_EQ(4u, simplified.size());
+  for (const auto& vertex : simplified) {
+    EXPECT_TRUE((vertex.x() == 0.0 || vertex.x() == 4.0) && (vertex.y() == 0.0 || vertex.y() == 4.0));
+  }
+}
+
+TEST(ContourExtraction, SimplifyKeepsVerticesBeyondTolerance) {
+  const Contour contour{Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(2.0, 0.3), Eigen::Vector2d(4.0, 0.0), Eigen::Vector2d(4.0, 4.0),
+                        Eigen::Vector2d(0.0, 4.0)};
+  EXPECT_EQ(5u, simplifyContour(contour, 0.2).size());
+  EXPECT_EQ(4u, simplifyContour(contour, 0.5).size());
+  const Contour triangle{Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.0), Eigen::Vector2d(0.0, 1.0)};
+  EXPECT_EQ(3u, simplifyContour(triangle, 10.0).size());
+}
@@ -0,0 +1,123 @@
+/*
+ * CostToGoTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/CostToGo.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Cost-to-go with a Dijkstra on a binary heap, with the same edges and costs as computeCostToGo().
+Eigen::MatrixXd computeCostToGoDijkstra(const BinaryMatrix& isFree, const Eigen::MatrixXf& traversability, const Eigen::Array2i& start,
+                                        const double resolution, const double traversabilityWeight) {
+  const int rows = static_cast<int>(isFree.rows());
+  const int cols = static_cast<int>(isFree.cols());
+  Eigen::MatrixXd cost = Eigen::MatrixXd::Constant(rows, cols, std::numeric_limits<double>::infinity());
+  using Entry = std::pair<double, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  cost(start(0), start(1)) = 0.0;
+  queue.emplace(0.0, start(0) + start(1) * rows);
+  while (!queue.empty()) {
+    const Entry entry = queue.top();
+    queue.pop();
+    const int row = entry.second % rows;
+    const int col = entry.second / rows;
+    if (entry.first > cost(row, col)) continue;
+    for (int rowOffset = -1; rowOffset <= 1; ++rowOffset) {
+      for (int colOffset = -1; colOffset <= 1; ++colOffset) {
+        const int neighborRow = row + rowOffset;
+        const int neighborCol = col + colOffset;
+        if ((rowOffset == 0 && colOffset == 0) || neighborRow < 0 || neighborRow >= rows || neighborCol < 0 || neighborCol >= cols) continue;
+        if (!isFree(neighborRow, neighborCol)) continue;
+        if (rowOffset != 0 && colOffset != 0 && (!isFree(neighborRow, col) || !isFree(row, neighborCol))) continue;
+        const double meanTraversability = 0.5 * (traversability(row, col) + traversability(neighborRow, neighborCol));
+        const double distance = std::hypot(rowOffset, colOffset) * resolution;
+        const double neighborCost = entry.first + distance * (1.0 + traversabilityWeight * (1.0 - meanTraversability));
+        if (neighborCost < cost(neighborRow, neighborCol)) {
+          cost(neighborRow, neighborCol) = neighborCost;
+          queue.emplace(neighborCost, neighborRow + neighborCol * rows);
+        }
+      }
+    }
+  }
+  return cost;
+}
+
+}  // namespace
+
+TEST(CostToGo, MatchesDijkstra) {
+  std::mt19937 generator(42);
+  std::bernoulli_distribution isFreeDistribution(0.8);
+  std::uniform_real_distribution<float> traversabilityDistribution(0.0f, 1.0f);
+  BinaryMatrix isFree(37, 29);
+  Eigen::MatrixXf traversability(37, 29);
+  for (int i = 0; i < isFree.size(); ++i) {
+    isFree(i) = isFreeDistribution(generator);
+    traversability(i) = traversabilityDistribution(generator);
+  }
+  const Eigen::Array2i start(18, 14);
+  isFree(start(0), start(1)) = true;
+
+  for (const double traversabilityWeight : {0.0, 1.0, 7.5}) {
+    Eigen::MatrixXf cost;
+    computeCostToGo(isFree, traversability, start, 0.05, traversabilityWeight, cost);
+    const Eigen::MatrixXd expected = computeCostToGoDijkstra(isFree, traversability, start, 0.05, traversabilityWeight);
+    ASSERT_EQ(expected.rows(), cost.rows());
+    ASSERT_EQ(expected.cols(), cost.cols());
+    for (int i = 0; i < expected.size(); ++i) {
+      if (std::isinf(expected(i))) {
+        EXPECT_TRUE(std::isnan(cost(i))) << "cell " << i << ", weight " << traversabilityWeight;
+      } else {
+        EXPECT_NEAR(expected(i), cost(i), 1e-4) << "cell " << i << ", weight " << traversabilityWeight;
+      }
+    }
+  }
+}
+
+TEST(CostToGo, DoesNotCutCorners) {
+  // The diagonal from (0, 0) to (1, 1) passes between two untraversable cells.
+  BinaryMatrix isFree = BinaryMatrix::Constant(2, 2, true);
+  isFree(0, 1) = false;
+  isFree(1, 0) = false;
+  const Eigen::MatrixXf traversability = Eigen::MatrixXf::Ones(2, 2);
+  Eigen::MatrixXf cost;
+  computeCostToGo(isFree, traversability, Eigen::Array2i(0, 0), 1.0, 0.0, cost);
+  EXPECT_FLOAT_EQ(0.0f, cost(0, 0));
+  EXPECT_TRUE(std::isnan(cost(1, 1)));
+  EXPECT_TRUE(std::isnan(cost(0, 1)));
+}
+
+TEST(CostToGo, StraightLine) {
+  const BinaryMatrix isFree = BinaryMatrix::Constant(1, 6, true);
+  const Eigen::MatrixXf traversability = Eigen::MatrixXf::Constant(1, 6, 0.5f);
+  Eigen::MatrixXf cost;
+  computeCostToGo(isFree, traversability, Eigen::Array2i(0, 0), 0.1, 2.0, cost);
+  for (int col = 0; col < 6; ++col) EXPECT_NEAR(col * 0.1 * 2.0, cost(0, col), 1e-6);
+}
+
+TEST(CostToGo, StartOutside) {
+  const BinaryMatrix isFree = BinaryMatrix::Constant(3, 3, true);
+  const Eigen::MatrixXf traversability = Eigen::MatrixXf::Ones(3, 3);
+  Eigen::MatrixXf cost;
+  computeCostToGo(isFree, traversability, Eigen::Array2i(3, 0), 0.1, 1.0, cost);
+  ASSERT_EQ(3, cost.rows());
+  ASSERT_EQ(3, cost.cols());
+  EXPECT_TRUE(cost.array().isNaN().all());
+}
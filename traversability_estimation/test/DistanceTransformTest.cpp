@@ -0,0 +1,87 @@
+/*
+ * DistanceTransformTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/DistanceTransform.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Distance of each cell to the closest seed by comparing all pairs of cells.
+Eigen::MatrixXf computeDistanceBruteForce(const BinaryMatrix& isSeed, const float maxDistance) {
+  Eigen::MatrixXf distance = Eigen::MatrixXf::Constant(isSeed.rows(), isSeed.cols(), maxDistance);
+  for (int row = 0; row < isSeed.rows(); ++row) {
+    for (int col = 0; col < isSeed.cols(); ++col) {
+      for (int seedRow = 0; seedRow < isSeed.rows(); ++seedRow) {
+        for (int seedCol = 0; seedCol < isSeed.cols(); ++seedCol) {
+          if (!isSeed(seedRow, seedCol)) continue;
+          const float cellDistance = std::hypot(static_cast<float>(row - seedRow), static_cast<float>(col - seedCol));
+          distance(row, col) = std::min(distance(row, col), cellDistance);
+        }
+      }
+    }
+  }
+  return distance;
+}
+
+}  // namespace
+
+TEST(DistanceTransform, MatchesBruteForce) {
+  std::mt19937 generator(42);
+  std::bernoulli_distribution isSeedDistribution(0.05);
+  BinaryMatrix isSeed(23, 31);
+  for (int i = 0; i < isSeed.size(); ++i) isSeed(i) = isSeedDistribution(generator);
+  isSeed(0, 0) = true;
+
+  const float maxDistance = std::numeric_limits<float>::infinity();
+  Eigen::MatrixXf distance;
+  computeDistanceTransform(isSeed, maxDistance, distance);
+  const Eigen::MatrixXf expected = computeDistanceBruteForce(isSeed, maxDistance);
+  ASSERT_EQ(expected.rows(), distance.rows());
+  ASSERT_EQ(expected.cols(), distance.cols());
+  for (int i = 0; i < expected.size(); ++i) EXPECT_NEAR(expected(i), distance(i), 1e-4) << "cell " << i;
+}
+
+TEST(DistanceTransform, SingleSeed) {
+  BinaryMatrix isSeed = BinaryMatrix::Constant(5, 7, false);
+  isSeed(2, 3) = true;
+  Eigen::MatrixXf distance;
+  computeDistanceTransform(isSeed, 100.0f, distance);
+  EXPECT_FLOAT_EQ(0.0f, distance(2, 3));
+  EXPECT_FLOAT_EQ(1.0f, distance(1, 3));
+  EXPECT_FLOAT_EQ(3.0f, distance(2, 0));
+  EXPECT_FLOAT_EQ(std::sqrt(2.0f), distance(3, 4));
+  EXPECT_FLOAT_EQ(std::hypot(2.0f, 3.0f), distance(0, 0));
+}
+
+TEST(DistanceTransform, LimitedByMaxDistance) {
+  BinaryMatrix isSeed = BinaryMatrix::Constant(1, 10, false);
+  isSeed(0, 0) = true;
+  Eigen::MatrixXf distance;
+  computeDistanceTransform(isSeed, 4.5f, distance);
+  EXPECT_FLOAT_EQ(4.0f, distance(0, 4));
+  EXPECT_FLOAT_EQ(4.5f, distance(0, 5));
+  EXPECT_FLOAT_EQ(4.5f, distance(0, 9));
+}
+
+TEST(DistanceTransform, NoSeeds) {
+  const BinaryMatrix isSeed = BinaryMatrix::Constant(4, 3, false);
+  Eigen::MatrixXf distance;
+  computeDistanceTransform(isSeed, 2.0f, distance);
+  ASSERT_EQ(4, distance.rows());
+  ASSERT_EQ(3, distance.cols());
+  EXPECT_TRUE((distance.array() == 2.0f).all());
+}
@@ -0,0 +1,94 @@
+/*
+ * FootprintCachesTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/FootprintCaches.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+#include <map>
+#include <string>
+
+using namespace traversability_estimation;
+
+namespace {
+
+grid_map::GridMap createMap() {
+  grid_map::GridMap map({"elevation"});
+  map.setGeometry(grid_map::Length(1.0, 1.0), 0.1);
+  return map;
+}
+
+}  // namespace
+
+TEST(FootprintCaches, SelectsTheStorageFromTheDensity) {
+  grid_map::GridMap map = createMap();
+  FootprintCaches footprintCaches;
+  footprintCaches.setBackend(FootprintCaches::Backend::Auto, 0.05);
+  footprintCaches.reset(map, false, {"traversability_footprint"});
+  EXPECT_TRUE(map.exists("traversability_footprint"));
+  EXPECT_DOUBLE_EQ(0.0, footprintCaches.getDensity(map));
+  EXPECT_TRUE(footprintCaches.shouldUseSparse(map));
+
+  // 10 of the 100 cells are queried.
+  map["traversability_footprint"].col(0).setConstant(1.0);
+  EXPECT_DOUBLE_EQ(0.1, footprintCaches.getDensity(map));
+  EXPECT_FALSE(footprintCaches.shouldUseSparse(map));
+
+  footprintCaches.setBackend(FootprintCaches::Backend::Sparse, 0.05);
+  EXPECT_TRUE(footprintCaches.shouldUseSparse(map));
+  footprintCaches.reset(map, true, {"traversability_footprint"});
+  EXPECT_TRUE(footprintCaches.isSparse());
+  EXPECT_FALSE(map.exists("traversability_footprint"));
+  EXPECT_FALSE(footprintCaches.shouldUseDense(map));
+}
+
+TEST(FootprintCaches, MovesSparseCachesIntoLayers) {
+  grid_map::GridMap map = createMap();
+  FootprintCaches footprintCaches;
+  footprintCaches.reset(map, true, {});
+  footprintCaches.ensure(map, "step_footprint");
+  EXPECT_FALSE(map.exists("step_footprint"));
+  const int rows = map.getSize()(0);
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 5; ++i) footprintCaches.getSparseCaches()["step_footprint"].set(static_cast<uint32_t>(i + j * rows), 1.0);
+  }
+  EXPECT_DOUBLE_EQ(0.15, footprintCaches.getDensity(map));
+  EXPECT_TRUE(footprintCaches.shouldUseDense(map));
+  std::map<std::string, size_t> usage;
+  footprintCaches.addMemoryUsage(usage);
+  EXPECT_GT(usage["step_footprint"], 0u);
+
+  footprintCaches.useDense(map);
+  EXPECT_FALSE(footprintCaches.isSparse());
+  EXPECT_TRUE(footprintCaches.getSparseCaches().empty());
+  ASSERT_TRUE(map.exists("step_footprint"));
+  EXPECT_FLOAT_EQ(1.0, map.at("step_footprint", grid_map::Index(4, 2)));
+  EXPECT_TRUE(std::isnan(map.at("step_footprint", grid_map::Index(5, 2))));
+  EXPECT_TRUE(std::isnan(map.at("step_footprint", grid_map::Index(0, 3))));
+  EXPECT_DOUBLE_EQ(0.15, footprintCaches.getDensity(map));
+}
+
+TEST(FootprintCaches, ClearsBlocks) {
+  for (const bool isSparse : {false, true}) {
+    grid_map::GridMap map = createMap();
+    FootprintCaches footprintCaches;
+    footprintCaches.reset(map, isSparse, {"traversability_footprint"});
+    if (isSparse) {
+      for (uint32_t key = 0; key < 100; ++key) footprintCaches.getSparseCaches()["traversability_footprint"].set(key, 1.0);
+    } else {
+      map["traversability_footprint"].setConstant(1.0);
+    }
+    footprintCaches.clearBlock(map, "traversability_footprint", grid_map::Index(2, 3), grid_map::Size(4, 5));
+    EXPECT_DOUBLE_EQ(0.8, footprintCaches.getDensity(map)) << "sparse: " << isSparse;
+    footprintCaches.clear(map, "traversability_footprint");
+    EXPECT_DOUBLE_EQ(0.0, footprintCaches.getDensity(map)) << "sparse: " << isSparse;
+  }
+}
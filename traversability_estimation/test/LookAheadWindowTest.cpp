@@ -0,0 +1,101 @@
+/*
+ * LookAheadWindowTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/LookAheadWindow.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Checks if a point with margin is within the window.
+bool isCovered(const grid_map::Position& center, const grid_map::Length& length, const grid_map::Position& point, const double margin) {
+  return ((point - center).cwiseAbs().array() + margin <= 0.5 * length.array() + 1e-9).all();
+}
+
+}  // namespace
+
+TEST(LookAheadWindow, PreservesTheArea) {
+  LookAheadWindow window;
+  window.setParameters(25.0, 2.0, 0.5, 2.0);
+  grid_map::Position center;
+  grid_map::Length length;
+  for (const Eigen::Vector2d& velocity : {Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.0), Eigen::Vector2d(0.5, -0.5),
+                                         Eigen::Vector2d(0.0, 10.0)}) {
+    window.reset();
+    window.update(grid_map::Position(1.0, 2.0), velocity, {}, 0.0, center, length);
+    EXPECT_NEAR(25.0, length.prod(), 1e-9) << velocity.transpose();
+    EXPECT_GE(length.minCoeff(), 2.0 - 1e-9) << velocity.transpose();
+  }
+
+  // Aligned to the cells, the window loses less than a cell per side.
+  window.reset();
+  window.update(grid_map::Position(1.0, 2.0), Eigen::Vector2d(1.0, 0.3), {}, 0.1, center, length);
+  EXPECT_LE(length.prod(), 25.0);
+  EXPECT_GT(length.prod(), 25.0 - 0.1 * length.sum());
+}
+
+TEST(LookAheadWindow, BiasedTowardsTheHeading) {
+  LookAheadWindow window;
+  window.setParameters(25.0, 2.0, 0.5, 1.0);
+  const grid_map::Position robotPosition(1.0, 2.0);
+  grid_map::Position center;
+  grid_map::Length length;
+
+  // Standing still, the window is centered on the robot.
+  window.update(robotPosition, Eigen::Vector2d::Zero(), {}, 0.0, center, length);
+  EXPECT_NEAR(0.0, (center - robotPosition).norm(), 1e-9);
+  EXPECT_NEAR(length(0), length(1), 1e-9);
+
+  // Driving along x, the window starts at the margin behind the robot and covers the predicted position.
+  window.reset();
+  window.update(robotPosition, Eigen::Vector2d(1.5, 0.0), {}, 0.0, center, length);
+  EXPECT_GT(center.x(), robotPosition.x());
+  EXPECT_NEAR(robotPosition.x() - 0.5, center.x() - 0.5 * length.x(), 1e-9);
+  EXPECT_NEAR(robotPosition.y(), center.y(), 1e-9);
+  EXPECT_TRUE(isCovered(center, length, robotPosition + Eigen::Vector2d(3.0, 0.0), 0.5));
+
+  // Along a planned path in the negative y direction.
+  window.reset();
+  std::vector<grid_map::Position> path;
+  for (int i = 0; i <= 10; i++) path.emplace_back(robotPosition.x(), robotPosition.y() - 0.3 * i);
+  window.update(robotPosition, Eigen::Vector2d::Zero(), path, 0.0, center, length);
+  EXPECT_LT(center.y(), robotPosition.y());
+  EXPECT_NEAR(robotPosition.y() + 0.5, center.y() + 0.5 * length.y(), 1e-9);
+  EXPECT_TRUE(isCovered(center, length, robotPosition, 0.5));
+}
+
+TEST(LookAheadWindow, ReusesThePreviousWindow) {
+  LookAheadWindow window;
+  window.setParameters(25.0, 2.0, 0.5, 1.0);
+  grid_map::Position center, previousCenter;
+  grid_map::Length length, previousLength;
+  window.update(grid_map::Position(0.0, 0.0), Eigen::Vector2d(1.0, 0.0), {}, 0.1, previousCenter, previousLength);
+
+  // A small step forward is still covered.
+  window.update(grid_map::Position(0.2, 0.0), Eigen::Vector2d(1.0, 0.0), {}, 0.1, center, length);
+  EXPECT_TRUE(previousCenter.isApprox(center));
+  EXPECT_TRUE((previousLength == length).all());
+
+  // After a reset, the same step places the window anew, i.e. shifted with the robot.
+  window.reset();
+  window.update(grid_map::Position(0.2, 0.0), Eigen::Vector2d(1.0, 0.0), {}, 0.1, center, length);
+  EXPECT_NEAR(previousCenter.x() + 0.2, center.x(), 1e-6);
+
+  // The window is kept while it covers the look-ahead, which leaves it far ahead.
+  window.update(grid_map::Position(4.0, 0.0), Eigen::Vector2d(1.0, 0.0), {}, 0.1, center, length);
+  EXPECT_NEAR(previousCenter.x() + 0.2, center.x(), 1e-6);
+  window.update(grid_map::Position(8.0, 0.0), Eigen::Vector2d(1.0, 0.0), {}, 0.1, center, length);
+  EXPECT_NEAR(previousCenter.x() + 8.0, center.x(), 1e-6);
+  EXPECT_TRUE(isCovered(center, length, grid_map::Position(10.0, 0.0), 0.5));
+}
@@ -0,0 +1,144 @@
+/*
+ * MapOverlayTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MapOverlay.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Map of 2 x 1 m with a resolution of 0.1 m, i.e. 20 x 10 cells, centered at (1, -1).
+grid_map::GridMap createMap() {
+  grid_map::GridMap map({"traversability"});
+  map.setGeometry(grid_map::Length(2.0, 1.0), 0.1, grid_map::Position(1.0, -1.0));
+  return map;
+}
+
+}  // namespace
+
+TEST(MapOverlay, IndexRangeOfWholeMap) {
+  const grid_map::GridMap map = createMap();
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  const Eigen::AlignedBox2d bounds(Eigen::Vector2d(-5.0, -5.0), Eigen::Vector2d(5.0, 5.0));
+  ASSERT_TRUE(getIndexRange(map, bounds, startIndex, size));
+  EXPECT_EQ(0, startIndex(0));
+  EXPECT_EQ(0, startIndex(1));
+  EXPECT_EQ(20, size(0));
+  EXPECT_EQ(10, size(1));
+}
+
+TEST(MapOverlay, IndexRangeContainsTheCellCentersWithinBounds) {
+  const grid_map::GridMap map = createMap();
+  const Eigen::AlignedBox2d bounds(Eigen::Vector2d(0.43, -1.27), Eigen::Vector2d(0.81, -1.02));
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  ASSERT_TRUE(getIndexRange(map, bounds, startIndex, size));
+  for (int row = 0; row < map.getSize()(0); ++row) {
+    for (int col = 0; col < map.getSize()(1); ++col) {
+      const grid_map::Index index(row, col);
+      grid_map::Position position;
+      map.getPosition(index, position);
+      const bool isInRange = (index >= startIndex).all() && (index < startIndex + size).all();
+      EXPECT_EQ(bounds.contains(position), isInRange) << "cell (" << row << ", " << col << ")";
+    }
+  }
+}
+
+TEST(MapOverlay, IndexRangeIsClippedToTheMap) {
+  const grid_map::GridMap map = createMap();
+  // The largest x and y values are at index (0, 0).
+  const Eigen::AlignedBox2d bounds(Eigen::Vector2d(1.74, -0.76), Eigen::Vector2d(3.0, 0.0));
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  ASSERT_TRUE(getIndexRange(map, bounds, startIndex, size));
+  EXPECT_EQ(0, startIndex(0));
+  EXPECT_EQ(0, startIndex(1));
+  EXPECT_EQ(3, size(0));
+  EXPECT_EQ(3, size(1));
+}
+
+TEST(MapOverlay, EmptyIndexRange) {
+  const grid_map::GridMap map = createMap();
+  grid_map::Index startIndex;
+  grid_map::Size size;
+  EXPECT_FALSE(getIndexRange(map, Eigen::AlignedBox2d(), startIndex, size));
+  // Between the centers of two neighboring cells.
+  EXPECT_FALSE(getIndexRange(map, Eigen::AlignedBox2d(Eigen::Vector2d(0.51, -1.0), Eigen::Vector2d(0.54, -0.9)), startIndex, size));
+  // Outside of the map.
+  EXPECT_FALSE(getIndexRange(map, Eigen::AlignedBox2d(Eigen::Vector2d(2.5, -1.0), Eigen::Vector2d(3.0, -0.9)), startIndex, size));
+  EXPECT_FALSE(getIndexRange(map, Eigen::AlignedBox2d(Eigen::Vector2d(0.5, -3.0), Eigen::Vector2d(0.6, -2.0)), startIndex, size));
+}
+
+TEST(MapOverlay, VersionChangesWithTheRegions) {
+  const grid_map::GridMap map = createMap();
+  MapOverlay overlay;
+  overlay.setGeometry(map);
+  std::vector<geometry_msgs::Point32> points(3);
+  points[0].x = 0.5;
+  points[1].x = 0.8;
+  points[2].y = -1.2;
+  const MapOverlay::Region region = MapOverlay::createRegion(points, MapOverlay::State::Untraversable, ros::Time(0));
+  ASSERT_EQ(3u, region.polygon.getVertices().size());
+
+  uint64_t version = overlay.getVersion();
+  EXPECT_FALSE(overlay.setOverride("keep_out", region, map).empty());
+  EXPECT_GT(overlay.getVersion(), version);
+  version = overlay.getVersion();
+  EXPECT_TRUE(overlay.removeOverride("unknown", map).empty());
+  EXPECT_TRUE(overlay.removeExpired(ros::Time(100.0), map).empty());
+  EXPECT_TRUE(overlay.setOverride("keep_out", region, map).empty());
+  EXPECT_EQ(version, overlay.getVersion());
+  EXPECT_FALSE(overlay.removeOverride("keep_out", map).empty());
+  EXPECT_GT(overlay.getVersion(), version);
+
+  // Copies, e.g. in session snapshots, keep their version.
+  const MapOverlay copy = overlay;
+  version = overlay.getVersion();
+  overlay.setDynamicObstacles({region}, map);
+  EXPECT_GT(overlay.getVersion(), version);
+  EXPECT_EQ(version, copy.getVersion());
+}
+
+TEST(MapOverlay, ChangedBoundsPerRegion) {
+  const grid_map::GridMap map = createMap();
+  MapOverlay overlay;
+  overlay.setGeometry(map);
+  auto createSquare = [](const double x, const double y) {
+    std::vector<geometry_msgs::Point32> points(4);
+    for (size_t i = 0; i < points.size(); ++i) {
+      points[i].x = static_cast<float>(x + (i == 1 || i == 2 ? 0.2 : 0.0));
+      points[i].y = static_cast<float>(y + (i >= 2 ? 0.2 : 0.0));
+    }
+    return MapOverlay::createRegion(points, MapOverlay::State::Untraversable, ros::Time(0));
+  };
+  const MapOverlay::Region left = createSquare(0.1, -1.1);
+  const MapOverlay::Region right = createSquare(1.7, -1.1);
+
+  // Distant obstacles change separate bounds.
+  MapOverlay::ChangedBounds changedBounds = overlay.setDynamicObstacles({left, right}, map);
+  ASSERT_EQ(2u, changedBounds.size());
+  EXPECT_TRUE(changedBounds[0].isApprox(getBounds(left.polygon)));
+  EXPECT_TRUE(changedBounds[1].isApprox(getBounds(right.polygon)));
+
+  // Only the moved obstacle changes, its old and new bounds overlap and are merged.
+  const MapOverlay::Region movedRight = createSquare(1.6, -1.1);
+  const uint64_t version = overlay.getVersion();
+  changedBounds = overlay.setDynamicObstacles({left, movedRight}, map);
+  ASSERT_EQ(1u, changedBounds.size());
+  EXPECT_TRUE(changedBounds[0].isApprox(getBounds(right.polygon).extend(getBounds(movedRight.polygon))));
+  EXPECT_GT(overlay.getVersion(), version);
+  EXPECT_TRUE(overlay.setDynamicObstacles({left, movedRight}, map).empty());
+  EXPECT_EQ(version + 1, overlay.getVersion());
+
+  changedBounds = overlay.setDynamicObstacles({}, map);
+  EXPECT_EQ(2u, changedBounds.size());
+}
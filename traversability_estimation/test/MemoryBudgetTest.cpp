@@ -0,0 +1,62 @@
+/*
+ * MemoryBudgetTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/MemoryBudget.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+std::map<std::string, size_t> createUsage() {
+  return std::map<std::string, size_t>{{"elevation", 400}, {"clearance", 400}, {"traversability_footprint", 400}, {"tiled_layers", 300}};
+}
+
+}  // namespace
+
+TEST(MemoryBudget, EvictsLeastRecentlyUsedLayers) {
+  MemoryBudget memoryBudget;
+  memoryBudget.setBudget(1000);
+  for (const std::string layer : {"clearance", "traversability_footprint", "tiled_layers"}) memoryBudget.setEvictable(layer);
+  memoryBudget.touch("traversability_footprint");
+  memoryBudget.touch("clearance");
+
+  // The tiled layers were never used, the footprint cache is used less recently than the clearance.
+  EXPECT_EQ(std::vector<std::string>({"tiled_layers", "traversability_footprint"}), memoryBudget.getLayersToEvict(createUsage()));
+  memoryBudget.touch("tiled_layers");
+  memoryBudget.touch("traversability_footprint");
+  EXPECT_EQ(std::vector<std::string>({"clearance", "tiled_layers"}), memoryBudget.getLayersToEvict(createUsage()));
+}
+
+TEST(MemoryBudget, KeepsRequiredLayers) {
+  MemoryBudget memoryBudget;
+  memoryBudget.setBudget(100);
+  memoryBudget.setEvictable("clearance");
+  std::map<std::string, size_t> usage = createUsage();
+  std::vector<std::string> evictedLayers;
+  EXPECT_FALSE(memoryBudget.enforce(usage, [&](const std::string& layer) { evictedLayers.push_back(layer); }));
+  EXPECT_EQ(std::vector<std::string>({"clearance"}), evictedLayers);
+  EXPECT_EQ(0u, usage.count("clearance"));
+  EXPECT_EQ(1100u, MemoryBudget::getTotal(usage));
+}
+
+TEST(MemoryBudget, NoLimit) {
+  MemoryBudget memoryBudget;
+  memoryBudget.setEvictable("clearance");
+  std::map<std::string, size_t> usage = createUsage();
+  EXPECT_TRUE(memoryBudget.getLayersToEvict(usage).empty());
+  EXPECT_TRUE(memoryBudget.enforce(usage, [](const std::string& layer) { FAIL() << "evicted " << layer; }));
+  EXPECT_EQ(4u, usage.size());
+}
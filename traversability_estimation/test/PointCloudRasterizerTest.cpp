@@ -0,0 +1,140 @@
+/*
+ * PointCloudRasterizerTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/PointCloudRasterizer.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Point cloud with the float fields x, y and z.
+sensor_msgs::PointCloud2 createCloud(const std::vector<Eigen::Vector3f>& points) {
+  sensor_msgs::PointCloud2 cloud;
+  const std::vector<std::string> coordinates{"x", "y", "z"};
+  for (size_t k = 0; k < coordinates.size(); ++k) {
+    sensor_msgs::PointField field;
+    field.name = coordinates[k];
+    field.offset = static_cast<uint32_t>(k * sizeof(float));
+    field.datatype = sensor_msgs::PointField::FLOAT32;
+    field.count = 1;
+    cloud.fields.push_back(field);
+  }
+  cloud.height = 1;
+  cloud.width = static_cast<uint32_t>(points.size());
+  cloud.point_step = 3 * sizeof(float);
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.data.resize(cloud.row_step);
+  for (size_t i = 0; i < points.size(); ++i) std::memcpy(&cloud.data[i * cloud.point_step], points[i].data(), cloud.point_step);
+  return cloud;
+}
+
+//! Sets a 1x1 m map with 0.1 m cells around the origin.
+void configure(PointCloudRasterizer& rasterizer, const PointCloudRasterizer::Reduction reduction, const double temporalWeight) {
+  rasterizer.setGeometry(grid_map::Length(1.0, 1.0), 0.1, "odom");
+  rasterizer.setReduction(reduction);
+  rasterizer.setTemporalWeight(temporalWeight);
+}
+
+float getValue(const grid_map::GridMap& map, const std::string& layer, const grid_map::Position& position) {
+  grid_map::Index index;
+  EXPECT_TRUE(map.getIndex(position, index));
+  return map.at(layer, index);
+}
+
+}  // namespace
+
+TEST(PointCloudRasterizer, BinsPointsIntoCells) {
+  PointCloudRasterizer rasterizer;
+  configure(rasterizer, PointCloudRasterizer::Reduction::Max, 1.0);
+  grid_map::GridMap map;
+  double zPosition;
+  EXPECT_FALSE(rasterizer.getMap({}, map, zPosition));
+
+  // Two points in one cell, one in another, one outside of the map and one invalid point.
+  const sensor_msgs::PointCloud2 cloud = createCloud({Eigen::Vector3f(0.02, 0.02, 0.3), Eigen::Vector3f(0.08, 0.01, 0.1),
+                                                      Eigen::Vector3f(-0.25, 0.35, 0.5), Eigen::Vector3f(3.0, 0.0, 1.0),
+                                                      Eigen::Vector3f(NAN, 0.0, 2.0)});
+  ASSERT_TRUE(rasterizer.addPointCloud(cloud, Eigen::Affine3f::Identity()));
+  ASSERT_TRUE(rasterizer.getMap({"horizontal_variance_x"}, map, zPosition));
+
+  EXPECT_FLOAT_EQ(0.3, getValue(map, "elevation", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.3, getValue(map, "upper_bound", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.1, getValue(map, "lower_bound", grid_map::Position(0.05, 0.05)));
+  EXPECT_NEAR(0.01, getValue(map, "variance", grid_map::Position(0.05, 0.05)), 1e-6);
+  EXPECT_FLOAT_EQ(0.5, getValue(map, "elevation", grid_map::Position(-0.25, 0.35)));
+  EXPECT_FLOAT_EQ(0.0, getValue(map, "horizontal_variance_x", grid_map::Position(-0.25, 0.35)));
+
+  // Only the two cells with points are set.
+  int nCells = 0;
+  const grid_map::Matrix& elevation = map["elevation"];
+  for (int i = 0; i < elevation.size(); ++i) nCells += std::isfinite(elevation(i)) ? 1 : 0;
+  EXPECT_EQ(2, nCells);
+}
+
+TEST(PointCloudRasterizer, TransformsPoints) {
+  PointCloudRasterizer rasterizer;
+  configure(rasterizer, PointCloudRasterizer::Reduction::Max, 1.0);
+  const Eigen::Affine3f transform(Eigen::Translation3f(0.2, -0.1, 1.0));
+  ASSERT_TRUE(rasterizer.addPointCloud(createCloud({Eigen::Vector3f(0.05, 0.05, 0.0)}), transform));
+  grid_map::GridMap map;
+  double zPosition;
+  ASSERT_TRUE(rasterizer.getMap({}, map, zPosition));
+  EXPECT_FLOAT_EQ(1.0, getValue(map, "elevation", grid_map::Position(0.25, -0.05)));
+}
+
+TEST(PointCloudRasterizer, MeanReduction) {
+  PointCloudRasterizer rasterizer;
+  configure(rasterizer, PointCloudRasterizer::Reduction::Mean, 1.0);
+  ASSERT_TRUE(rasterizer.addPointCloud(
+      createCloud({Eigen::Vector3f(0.02, 0.02, 0.3), Eigen::Vector3f(0.08, 0.01, 0.1), Eigen::Vector3f(0.05, 0.05, 0.2)}),
+      Eigen::Affine3f::Identity()));
+  grid_map::GridMap map;
+  double zPosition;
+  ASSERT_TRUE(rasterizer.getMap({}, map, zPosition));
+  EXPECT_FLOAT_EQ(0.2, getValue(map, "elevation", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.3, getValue(map, "upper_bound", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.1, getValue(map, "lower_bound", grid_map::Position(0.05, 0.05)));
+}
+
+TEST(PointCloudRasterizer, MergesCloudsOverTime) {
+  PointCloudRasterizer rasterizer;
+  configure(rasterizer, PointCloudRasterizer::Reduction::Max, 0.25);
+  ASSERT_TRUE(rasterizer.addPointCloud(createCloud({Eigen::Vector3f(0.05, 0.05, 1.0), Eigen::Vector3f(0.35, 0.05, 1.0)}),
+                                       Eigen::Affine3f::Identity()));
+  ASSERT_TRUE(rasterizer.addPointCloud(createCloud({Eigen::Vector3f(0.05, 0.05, 0.2)}), Eigen::Affine3f::Identity()));
+  grid_map::GridMap map;
+  double zPosition;
+  ASSERT_TRUE(rasterizer.getMap({}, map, zPosition));
+
+  // The new height moves the elevation by the weight, the bounds cover the points and the elevation.
+  EXPECT_FLOAT_EQ(0.8, getValue(map, "elevation", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.8, getValue(map, "upper_bound", grid_map::Position(0.05, 0.05)));
+  EXPECT_FLOAT_EQ(0.2, getValue(map, "lower_bound", grid_map::Position(0.05, 0.05)));
+  // Cells without new points keep their height.
+  EXPECT_FLOAT_EQ(1.0, getValue(map, "elevation", grid_map::Position(0.35, 0.05)));
+}
+
+TEST(PointCloudRasterizer, RejectsCloudsWithoutCoordinates) {
+  PointCloudRasterizer rasterizer;
+  configure(rasterizer, PointCloudRasterizer::Reduction::Max, 1.0);
+  sensor_msgs::PointCloud2 cloud = createCloud({Eigen::Vector3f(0.05, 0.05, 1.0)});
+  cloud.fields.pop_back();
+  EXPECT_FALSE(rasterizer.addPointCloud(cloud, Eigen::Affine3f::Identity()));
+  grid_map::GridMap map;
+  double zPosition;
+  EXPECT_FALSE(rasterizer.getMap({}, map, zPosition));
+}
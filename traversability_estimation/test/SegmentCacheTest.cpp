@@ -0,0 +1,145 @@
+/*
+ * SegmentCacheTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/SegmentCache.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+
+using namespace traversability_estimation;
+
+namespace {
+
+geometry_msgs::Pose createPose(const double x, const double y, const double yaw) {
+  geometry_msgs::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.z = std::sin(0.5 * yaw);
+  pose.orientation.w = std::cos(0.5 * yaw);
+  return pose;
+}
+
+SegmentCache::Segment createSegment(const double traversability, const Eigen::Vector2d& min, const Eigen::Vector2d& max) {
+  SegmentCache::Segment segment;
+  segment.isSafe = true;
+  segment.traversability = traversability;
+  segment.area = 0.0;
+  segment.bounds = Eigen::AlignedBox2d(min, max);
+  return segment;
+}
+
+}  // namespace
+
+TEST(SegmentCache, InsertAndGet) {
+  SegmentCache cache;
+  const auto key = cache.getKey(1, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), true);
+  SegmentCache::Segment segment;
+  EXPECT_FALSE(cache.get(key, segment));
+  cache.insert(key, createSegment(0.7, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5)));
+  ASSERT_TRUE(cache.get(key, segment));
+  EXPECT_TRUE(segment.isSafe);
+  EXPECT_DOUBLE_EQ(0.7, segment.traversability);
+
+  // Other footprints and reversed segments are different entries.
+  EXPECT_FALSE(cache.get(cache.getKey(2, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), true), segment));
+  EXPECT_FALSE(cache.get(cache.getKey(1, createPose(1.0, 0.0, 0.0), createPose(0.0, 0.0, 0.0), true), segment));
+}
+
+TEST(SegmentCache, Quantization) {
+  SegmentCache cache;
+  cache.setResolution(0.01, 0.001);
+  cache.insert(cache.getKey(1, createPose(0.0, 0.0, 0.3), createPose(1.0, 0.0, 0.3), true),
+               createSegment(0.5, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5)));
+  SegmentCache::Segment segment;
+  EXPECT_TRUE(cache.get(cache.getKey(1, createPose(0.001, -0.002, 0.3), createPose(1.003, 0.0, 0.3), true), segment));
+  EXPECT_FALSE(cache.get(cache.getKey(1, createPose(0.02, 0.0, 0.3), createPose(1.0, 0.0, 0.3), true), segment));
+  EXPECT_FALSE(cache.get(cache.getKey(1, createPose(0.0, 0.0, 0.4), createPose(1.0, 0.0, 0.3), true), segment));
+
+  // Both signs of a quaternion describe the same orientation.
+  geometry_msgs::Pose negatedStart = createPose(0.0, 0.0, 0.3);
+  negatedStart.orientation.z = -negatedStart.orientation.z;
+  negatedStart.orientation.w = -negatedStart.orientation.w;
+  EXPECT_TRUE(cache.get(cache.getKey(1, negatedStart, createPose(1.0, 0.0, 0.3), true), segment));
+
+  // Without the orientation, only the positions identify the segment.
+  const auto keyWithoutOrientation = cache.getKey(1, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), false);
+  cache.insert(keyWithoutOrientation, createSegment(0.5, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5)));
+  EXPECT_TRUE(cache.get(cache.getKey(1, createPose(0.0, 0.0, 1.0), createPose(1.0, 0.0, -2.0), false), segment));
+}
+
+TEST(SegmentCache, GenerationsAndSnapshots) {
+  SegmentCache cache;
+  const geometry_msgs::Pose start = createPose(0.0, 0.0, 0.0);
+  const geometry_msgs::Pose end = createPose(1.0, 0.0, 0.0);
+  cache.setGeneration(1);
+  cache.insert(cache.getKey(1, start, end, true), createSegment(0.1, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5)));
+  cache.setGeneration(1, 5);
+  cache.insert(cache.getKey(1, start, end, true), createSegment(0.2, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5)));
+  cache.setGeneration(2);
+  SegmentCache::Segment segment;
+  EXPECT_FALSE(cache.get(cache.getKey(1, start, end, true), segment));
+
+  // Entries of other states are kept while a new state is used.
+  cache.setGeneration(1, 5);
+  ASSERT_TRUE(cache.get(cache.getKey(1, start, end, true), segment));
+  EXPECT_DOUBLE_EQ(0.2, segment.traversability);
+  cache.setGeneration(1);
+  ASSERT_TRUE(cache.get(cache.getKey(1, start, end, true), segment));
+  EXPECT_DOUBLE_EQ(0.1, segment.traversability);
+
+  cache.remove(1, 5);
+  cache.setGeneration(1, 5);
+  EXPECT_FALSE(cache.get(cache.getKey(1, start, end, true), segment));
+  cache.setGeneration(1);
+  EXPECT_TRUE(cache.get(cache.getKey(1, start, end, true), segment));
+}
+
+TEST(SegmentCache, Invalidate) {
+  SegmentCache cache;
+  const auto nearKey = cache.getKey(1, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), true);
+  const auto farKey = cache.getKey(1, createPose(5.0, 0.0, 0.0), createPose(6.0, 0.0, 0.0), true);
+  cache.insert(nearKey, createSegment(0.5, Eigen::Vector2d(-0.2, -0.2), Eigen::Vector2d(1.2, 0.2)));
+  cache.insert(farKey, createSegment(0.5, Eigen::Vector2d(4.8, -0.2), Eigen::Vector2d(6.2, 0.2)));
+  cache.setGeneration(0, 3);
+  const auto snapshotKey = cache.getKey(1, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), true);
+  cache.insert(snapshotKey, createSegment(0.5, Eigen::Vector2d(-0.2, -0.2), Eigen::Vector2d(1.2, 0.2)));
+
+  // Only the entries of the current state are invalidated.
+  cache.setGeneration(0);
+  cache.invalidate(Eigen::AlignedBox2d(Eigen::Vector2d(0.5, 0.0), Eigen::Vector2d(0.6, 0.1)));
+  SegmentCache::Segment segment;
+  EXPECT_FALSE(cache.get(nearKey, segment));
+  EXPECT_TRUE(cache.get(farKey, segment));
+  EXPECT_TRUE(cache.get(snapshotKey, segment));
+}
+
+TEST(SegmentCache, MaxSize) {
+  SegmentCache cache;
+  cache.setMaxSize(2);
+  const auto firstKey = cache.getKey(1, createPose(0.0, 0.0, 0.0), createPose(1.0, 0.0, 0.0), true);
+  const auto secondKey = cache.getKey(1, createPose(1.0, 0.0, 0.0), createPose(2.0, 0.0, 0.0), true);
+  const auto thirdKey = cache.getKey(1, createPose(2.0, 0.0, 0.0), createPose(3.0, 0.0, 0.0), true);
+  const auto segment = createSegment(0.5, Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.5));
+  cache.insert(firstKey, segment);
+  cache.insert(secondKey, segment);
+  SegmentCache::Segment result;
+  EXPECT_TRUE(cache.get(firstKey, result));
+
+  // A full cache is cleared.
+  cache.insert(thirdKey, segment);
+  EXPECT_FALSE(cache.get(firstKey, result));
+  EXPECT_TRUE(cache.get(thirdKey, result));
+
+  // A size of 0 disables the cache.
+  cache.setMaxSize(0);
+  cache.insert(firstKey, segment);
+  EXPECT_FALSE(cache.get(firstKey, result));
+}
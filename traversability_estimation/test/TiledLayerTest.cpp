@@ -0,0 +1,41 @@
+/*
+ * TiledLayerTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/TiledLayer.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+using namespace traversability_estimation;
+
+TEST(TiledLayer, CopiesTheLayer) {
+  for (const auto& size : {grid_map::Size(1, 1), grid_map::Size(8, 8), grid_map::Size(37, 5), grid_map::Size(5, 70), grid_map::Size(65, 130)}) {
+    grid_map::Matrix matrix(size(0), size(1));
+    for (int j = 0; j < size(1); ++j) {
+      for (int i = 0; i < size(0); ++i) matrix(i, j) = static_cast<float>(i + 1000 * j);
+    }
+    TiledLayer tiledLayer;
+    tiledLayer.fromMatrix(matrix);
+    ASSERT_FALSE(tiledLayer.empty());
+    for (int j = 0; j < size(1); ++j) {
+      for (int i = 0; i < size(0); ++i) ASSERT_EQ(matrix(i, j), tiledLayer.at(grid_map::Index(i, j))) << size.transpose();
+    }
+  }
+}
+
+TEST(TiledLayer, MemoryOfNonSquareLayers) {
+  // A long layer only allocates the blocks of 32x32 cells which cover it.
+  grid_map::Matrix matrix = grid_map::Matrix::Zero(40, 1000);
+  TiledLayer tiledLayer;
+  tiledLayer.fromMatrix(matrix);
+  EXPECT_EQ(64u * 1024u * sizeof(float), tiledLayer.getMemorySize());
+
+  tiledLayer.clear();
+  EXPECT_TRUE(tiledLayer.empty());
+  EXPECT_EQ(0u, tiledLayer.getMemorySize());
+}
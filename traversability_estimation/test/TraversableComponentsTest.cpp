@@ -0,0 +1,76 @@
+/*
+ * TraversableComponentsTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "traversability_estimation/TraversableComponents.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <cmath>
+
+using namespace traversability_estimation;
+
+namespace {
+
+//! Map of 10x10 cells with a wall of low clearance along the column 5.
+grid_map::GridMap createMap() {
+  grid_map::GridMap map({"clearance"});
+  map.setGeometry(grid_map::Length(1.0, 1.0), 0.1);
+  map["clearance"].setConstant(1.0);
+  map["clearance"].col(5).setConstant(0.1);
+  return map;
+}
+
+}  // namespace
+
+TEST(TraversableComponents, LabelsTheMap) {
+  grid_map::GridMap map = createMap();
+  TraversableComponents traversableComponents("traversable_component");
+  bool isConnected = true;
+  EXPECT_FALSE(traversableComponents.isValid());
+  EXPECT_FALSE(traversableComponents.areConnected(map, grid_map::Position(0.0, 0.0), grid_map::Position(0.0, 0.0), isConnected));
+
+  traversableComponents.compute(map, "clearance", 0.3);
+  ASSERT_TRUE(traversableComponents.isValid());
+  ASSERT_TRUE(map.exists("traversable_component"));
+  EXPECT_TRUE(std::isnan(map.at("traversable_component", grid_map::Index(2, 5))));
+  EXPECT_FALSE(std::isnan(map.at("traversable_component", grid_map::Index(2, 4))));
+
+  // The wall separates the columns on both sides.
+  grid_map::Position positionA, positionB, positionC;
+  map.getPosition(grid_map::Index(1, 1), positionA);
+  map.getPosition(grid_map::Index(8, 3), positionB);
+  map.getPosition(grid_map::Index(1, 8), positionC);
+  ASSERT_TRUE(traversableComponents.areConnected(map, positionA, positionB, isConnected));
+  EXPECT_TRUE(isConnected);
+  ASSERT_TRUE(traversableComponents.areConnected(map, positionA, positionC, isConnected));
+  EXPECT_FALSE(isConnected);
+  ASSERT_TRUE(traversableComponents.areConnected(map, positionA, grid_map::Position(10.0, 0.0), isConnected));
+  EXPECT_FALSE(isConnected);
+
+  traversableComponents.invalidate();
+  EXPECT_FALSE(traversableComponents.areConnected(map, positionA, positionB, isConnected));
+}
+
+TEST(TraversableComponents, UpdatesChangedCells) {
+  grid_map::GridMap map = createMap();
+  TraversableComponents traversableComponents("traversable_component");
+  traversableComponents.compute(map, "clearance", 0.3);
+  grid_map::Position positionA, positionB;
+  map.getPosition(grid_map::Index(1, 1), positionA);
+  map.getPosition(grid_map::Index(1, 8), positionB);
+
+  // A gap in the wall joins both sides.
+  map["clearance"](4, 5) = 1.0;
+  traversableComponents.update(map, "clearance", 0.3, grid_map::Index(3, 4), grid_map::Size(3, 3));
+  bool isConnected = false;
+  ASSERT_TRUE(traversableComponents.areConnected(map, positionA, positionB, isConnected));
+  EXPECT_TRUE(isConnected);
+  EXPECT_FALSE(std::isnan(map.at("traversable_component", grid_map::Index(4, 5))));
+}
@@ -0,0 +1,140 @@
+/*
+ * CircleKernel.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef CIRCLEKERNEL_HPP
+#define CIRCLEKERNEL_HPP
+
+#include <grid_map_core/grid_map_core.hpp>
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+
+namespace filters {
+
+//! Largest window radius (in cells) with a specialized kernel.
+constexpr int maxCircleKernelRadius = 8;
+
+/*!
+ * Circular window with a radius of up to Radius cells, i.e. the cells whose centers are within the radius
+ * of the center cell, as visited by the grid_map::CircleIterator. The window is visited as a fully unrolled
+ * square stencil on a layer padded with Radius cells, such that neither the window shape nor the map border
+ * need a branch: cells outside of the circle are passed as not inside, cells outside of the map are NAN.
+ * Cells exactly on the circle are inside, whereas the iterator visits them depending on the rounding of
+ * their positions.
+ */
+template<int Radius>
+class CircleKernel
+{
+ public:
+  static constexpr int radius = Radius;
+  static constexpr int width = 2 * Radius + 1;
+
+  /*!
+   * Constructor.
+   * @param radiusInCells the radius of the window in cells, in [Radius, Radius + 1).
+   */
+  explicit CircleKernel(const double radiusInCells)
+  {
+    for (int i = 0; i < width * width; ++i) {
+      const int row = i % width - Radius;
+      const int column = i / width - Radius;
+      isInside_[i] = row * row + column * column <= radiusInCells * radiusInCells;
+    }
+  }
+
+  /*!
+   * Visits the window around a cell.
+   * @param padded the layer, padded such that the window is within it (e.g. with Radius cells on each side).
+   * @param row the row of the center cell in the padded layer.
+   * @param column the column of the center cell in the padded layer.
+   * @param function called with (bool isInside, float value) for each cell of the square around the window.
+   */
+  template<typename Function>
+  void apply(const grid_map::Matrix& padded, const int row, const int column, Function&& function) const
+  {
+    apply(&padded(row - Radius, column - Radius), padded.rows(), function,
+          std::make_integer_sequence<int, width * width>());
+  }
+
+  /*!
+   * Visits the offsets of the cells within the circle, e.g. to sweep a whole layer offset by offset.
+   * @param function called with (int rowOffset, int columnOffset) for each cell within the circle.
+   */
+  template<typename Function>
+  void forEachOffset(Function&& function) const
+  {
+    for (int i = 0; i < width * width; ++i) {
+      if (isInside_[i]) function(i % width - Radius, i / width - Radius);
+    }
+  }
+
+ private:
+  template<typename Function, int... Offsets>
+  void apply(const float* window, const Eigen::Index stride, Function& function,
+             std::integer_sequence<int, Offsets...>) const
+  {
+    using Expand = int[];
+    (void) Expand{0, (function(isInside_[Offsets], window[(Offsets / width) * stride + Offsets % width]), 0)...};
+  }
+
+  //! If the cells of the square stencil are within the circle, column-major.
+  std::array<bool, width * width> isInside_;
+};
+
+template<int Radius>
+constexpr int CircleKernel<Radius>::radius;
+
+template<int Radius>
+constexpr int CircleKernel<Radius>::width;
+
+/*!
+ * Calls a visitor with the specialized kernel for a window radius.
+ * @param radiusInCells the radius of the window in cells.
+ * @param visitor called with the kernel, e.g. a generic lambda.
+ * @return true if a specialized kernel exists, false if the caller needs to fall back to a circle iterator.
+ */
+template<typename Visitor>
+bool visitCircleKernel(const double radiusInCells, Visitor&& visitor)
+{
+  if (!(radiusInCells >= 0.0)) return false;
+  switch (static_cast<int>(std::floor(radiusInCells))) {
+    case 0: visitor(CircleKernel<0>(radiusInCells)); return true;
+    case 1: visitor(CircleKernel<1>(radiusInCells)); return true;
+    case 2: visitor(CircleKernel<2>(radiusInCells)); return true;
+    case 3: visitor(CircleKernel<3>(radiusInCells)); return true;
+    case 4: visitor(CircleKernel<4>(radiusInCells)); return true;
+    case 5: visitor(CircleKernel<5>(radiusInCells)); return true;
+    case 6: visitor(CircleKernel<6>(radiusInCells)); return true;
+    case 7: visitor(CircleKernel<7>(radiusInCells)); return true;
+    case 8: visitor(CircleKernel<8>(radiusInCells)); return true;
+    default: return false;
+  }
+}
+
+/*!
+ * Copies a layer in map index order (i.e. unwrapping the circular buffer) and pads it with NAN.
+ * @param map the grid map.
+ * @param layer the layer to copy.
+ * @param padding the number of cells added on each side.
+ * @param padded the padded layer, cell (i, j) of the map is at (i + padding, j + padding).
+ */
+void getPaddedLayer(const grid_map::GridMap& map, const std::string& layer, const int padding, grid_map::Matrix& padded);
+
+/*!
+ * Sets a layer from data in map index order, wrapping it into the circular buffer.
+ * @param data the data, with the size of the map.
+ * @param layer the layer to set (must exist).
+ * @param map the grid map.
+ */
+void setLayerInMapIndexOrder(const grid_map::Matrix& data, const std::string& layer, grid_map::GridMap& map);
+
+} /* namespace */
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * FilterPipeline.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef FILTERPIPELINE_HPP
+#define FILTERPIPELINE_HPP
+
+#include <filters/filter_base.h>
+
+#include <tuple>
+#include <utility>
+
+namespace filters {
+
+/*!
+ * Pipeline of filters composed at compile time, as an alternative to a filter chain loaded with pluginlib.
+ * The stages are members of the pipeline and are run in place on a single map through their non-virtual
+ * compute() method, such that neither the plugins are loaded nor the map is copied between the stages.
+ */
+template<typename T, typename... Stages>
+class FilterPipeline
+{
+ public:
+  //! Number of stages.
+  static constexpr size_t size = sizeof...(Stages);
+
+  /*!
+   * Configures the stages.
+   * @param config the configurations (name, type and params) of the stages, in the order of the stages.
+   * @return true if successful.
+   */
+  bool configure(XmlRpc::XmlRpcValue& config)
+  {
+    if (config.getType() != XmlRpc::XmlRpcValue::TypeArray || config.size() != static_cast<int>(size)) {
+      ROS_ERROR("The filter pipeline needs a configuration for each of its %zu stages.", size);
+      return false;
+    }
+    return configure(config, std::index_sequence_for<Stages...>());
+  }
+
+  /*!
+   * Runs the stages on a copy of the input map.
+   * @param mapIn the input map.
+   * @param mapOut the output map, mapIn processed by all stages.
+   * @return true if successful, false if a stage failed.
+   */
+  bool update(const T& mapIn, T& mapOut)
+  {
+    mapOut = mapIn;
+    return update(mapOut);
+  }
+
+  /*!
+   * Runs the stages in place.
+   * @param map the map to process.
+   * @return true if successful, false if a stage failed.
+   */
+  bool update(T& map)
+  {
+    return compute(map, std::index_sequence_for<Stages...>());
+  }
+
+ private:
+  template<size_t... Indices>
+  bool configure(XmlRpc::XmlRpcValue& config, std::index_sequence<Indices...>)
+  {
+    // The configure() of the stages hides the configuration from the parameters.
+    bool isSuccess = true;
+    using Expand = int[];
+    (void) Expand{0, (isSuccess = isSuccess && std::get<Indices>(stages_).FilterBase<T>::configure(config[static_cast<int>(Indices)]), 0)...};
+    return isSuccess;
+  }
+
+  template<size_t... Indices>
+  bool compute(T& map, std::index_sequence<Indices...>)
+  {
+    bool isSuccess = true;
+    using Expand = int[];
+    (void) Expand{0, (isSuccess = isSuccess && std::get<Indices>(stages_).compute(map), 0)...};
+    return isSuccess;
+  }
+
+  //! Stages, run in order.
+  std::tuple<Stages...> stages_;
+};
+
+template<typename T, typename... Stages>
+constexpr size_t FilterPipeline<T, Stages...>::size;
+
+} /* namespace */
+
+#endif
@@ -42,11 +42,20 @@ class RoughnessFilter : public FilterBase<T>
    * saves it as additional grid map layer.
    * The roughness traversability is set between 0.0 and 1.0, where a value of 1.0 means fully
    * traversable and 0.0 means not traversable. NAN indicates unknown values (terrain).
+   * If enabled, the pessimistic and optimistic roughness traversability are computed from the
+   * elevation bounds in the same pass and saved with the suffixes "_pessimistic" and "_optimistic".
    * @param mapIn grid map containing elevation map and surface normals.
    * @param mapOut grid map containing mapIn and roughness traversability values.
    */
   virtual bool update(const T& mapIn, T& mapOut);
 
+  /*!
+   * Computes the roughness traversability in place, i.e. as update() without copying the map.
+   * Used by the statically composed filter pipeline.
+   * @param mapOut grid map containing elevation map and surface normals, the roughness traversability layer is added.
+   */
+  bool compute(T& mapOut);
+
  private:
 
   //! Maximum allowed roughness.
@@ -55,6 +64,9 @@ class RoughnessFilter : public FilterBase<T>
   //! Radius of submap for roughness estimation.
   double estimationRadius_;
 
+  //! Compute the pessimistic and optimistic variants from the elevation bounds.
+  bool computeBoundVariants_;
+
   //! Roughness map type.
   std::string type_;
 };
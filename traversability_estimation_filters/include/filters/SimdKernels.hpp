@@ -0,0 +1,90 @@
+/*
+ * SimdKernels.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef SIMDKERNELS_HPP
+#define SIMDKERNELS_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace filters {
+
+//! Instruction set variant of the kernels.
+enum class SimdVariant { Scalar, Avx2, Avx512 };
+
+/*!
+ * Element-wise kernels of the traversability filters. Each kernel exists as a scalar reference and, on x86,
+ * as AVX2 and AVX-512 variants written with intrinsics. The variant is selected once from the instruction
+ * sets of the CPU, thread-safe on the first use. The variants agree up to rounding.
+ */
+struct SimdKernels
+{
+  //! Variant of the kernels.
+  SimdVariant variant;
+
+  /*!
+   * Computes the slope traversability from the z component of the surface normals.
+   * @param normalZ the z components of the surface normals.
+   * @param traversability the slope traversability, NAN where the normal is NAN.
+   * @param n the number of cells.
+   * @param criticalValue the critical slope [rad].
+   */
+  void (*slopeTraversability)(const float* normalZ, float* traversability, size_t n, float criticalValue);
+
+  /*!
+   * Updates running minima and maxima, ignoring NAN values.
+   * @param values the values.
+   * @param minimum the minima, initialized with infinity.
+   * @param maximum the maxima, initialized with -infinity.
+   * @param n the number of values.
+   */
+  void (*updateMinMax)(const float* values, float* minimum, float* maximum, size_t n);
+
+  /*!
+   * Updates running maxima and counts of values above a threshold, ignoring NAN values.
+   * @param values the values.
+   * @param threshold the threshold.
+   * @param maximum the maxima, initialized with -infinity.
+   * @param count the counts.
+   * @param n the number of values.
+   */
+  void (*updateMaxAndCount)(const float* values, float threshold, float* maximum, int* count, size_t n);
+
+  /*!
+   * Adds weighted values to running sums, NAN values make the sum NAN.
+   * @param values the values.
+   * @param weight the weight.
+   * @param sum the sums.
+   * @param n the number of values.
+   */
+  void (*addWeighted)(const float* values, float weight, float* sum, size_t n);
+};
+
+/*!
+ * Gets the kernels, selecting the best variant supported by the CPU on the first call.
+ * @return the kernels.
+ */
+const SimdKernels& getSimdKernels();
+
+/*!
+ * Forces a variant of the kernels, e.g. for testing. Call before the filters are updated.
+ * @param name the variant, one of "auto", "scalar", "avx2" and "avx512".
+ * @return true if successful, false if the variant is unknown or not supported by the CPU.
+ */
+bool setSimdVariant(const std::string& name);
+
+/*!
+ * Gets the name of a variant.
+ * @param variant the variant.
+ * @return the name.
+ */
+std::string getSimdVariantName(SimdVariant variant);
+
+} /* namespace */
+
+#endif
@@ -49,6 +49,13 @@ class SlopeFilter : public FilterBase<T>
    */
   virtual bool update(const T& mapIn, T& mapOut);
 
+  /*!
+   * Computes the slope traversability in place, i.e. as update() without copying the map.
+   * Used by the statically composed filter pipeline.
+   * @param mapOut grid map containing elevation map and surface normals, the slope traversability layer is added.
+   */
+  bool compute(T& mapOut);
+
  private:
 
   //! Maximum allowed slope.
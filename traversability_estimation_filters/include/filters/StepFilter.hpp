@@ -43,11 +43,20 @@ class StepFilter : public FilterBase<T>
    * saves it as additional grid map layer.
    * The step traversability is set between 0.0 and 1.0, where a value of 1.0 means fully
    * traversable and 0.0 means not traversable. NAN indicates unknown values (terrain).
+   * If enabled, the pessimistic and optimistic step traversability are computed from the elevation
+   * bounds in the same pass and saved with the suffixes "_pessimistic" and "_optimistic".
    * @param mapIn grid map containing elevation map and surface normals.
    * @param mapOut grid map containing mapIn and step traversability values.
    */
   virtual bool update(const T& mapIn, T& mapOut);
 
+  /*!
+   * Computes the step traversability in place, i.e. as update() without copying the map.
+   * Used by the statically composed filter pipeline.
+   * @param mapOut grid map containing elevation map and surface normals, the step traversability layer is added.
+   */
+  bool compute(T& mapOut);
+
  private:
 
   //! Maximum allowed step.
@@ -59,6 +68,9 @@ class StepFilter : public FilterBase<T>
   //! Critical number of cells greater than maximums allowed step.
   int nCellCritical_;
 
+  //! Compute the pessimistic and optimistic variants from the elevation bounds.
+  bool computeBoundVariants_;
+
   //! Step map type.
   std::string type_;
 };
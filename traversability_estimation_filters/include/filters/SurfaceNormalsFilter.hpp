@@ -0,0 +1,77 @@
+/*
+ * SurfaceNormalsFilter.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef SURFACENORMALSFILTER_HPP
+#define SURFACENORMALSFILTER_HPP
+
+#include <filters/filter_base.h>
+
+#include <Eigen/Core>
+
+#include <string>
+
+namespace filters {
+
+/*!
+ * Surface Normals Filter class to compute the surface normals of an elevation map from the cells within
+ * a radius, with the parameters of the grid map normal vectors filter (area method).
+ */
+template<typename T>
+class SurfaceNormalsFilter : public FilterBase<T>
+{
+
+ public:
+  /*!
+   * Constructor
+   */
+  SurfaceNormalsFilter();
+
+  /*!
+   * Destructor.
+   */
+  virtual ~SurfaceNormalsFilter();
+
+  /*!
+   * Configures the filter from parameters on the Parameter Server
+   */
+  virtual bool configure();
+
+  /*!
+   * Computes the surface normals of the input layer and saves their components as additional grid map
+   * layers (with the suffixes "x", "y" and "z"). The normal of a cell is the direction of least variance
+   * of the cells within the radius, pointing towards the positive axis. NAN indicates unknown values.
+   * @param mapIn grid map containing the input layer.
+   * @param mapOut grid map containing mapIn and the surface normals.
+   */
+  virtual bool update(const T& mapIn, T& mapOut);
+
+  /*!
+   * Computes the surface normals in place, i.e. as update() without copying the map.
+   * Used by the statically composed filter pipeline.
+   * @param mapOut grid map containing the input layer, the surface normal layers are added.
+   */
+  bool compute(T& mapOut);
+
+ private:
+
+  //! Input layer, e.g. the elevation.
+  std::string inputLayer_;
+
+  //! Prefix of the output layers.
+  std::string outputLayersPrefix_;
+
+  //! Radius of the cells taken into account.
+  double radius_;
+
+  //! Axis the normals point towards.
+  Eigen::Vector3d normalVectorPositiveAxis_;
+};
+
+} /* namespace */
+
+#endif
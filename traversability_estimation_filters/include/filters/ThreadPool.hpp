@@ -0,0 +1,158 @@
+/*
+ * ThreadPool.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace filters {
+
+/*!
+ * Configures the scheduling of the calling thread.
+ * @param cpus the CPUs the thread is allowed to run on, any CPU if empty.
+ * @param priority the SCHED_FIFO priority of the thread, default scheduling if 0.
+ * @param nice the nice value of the thread, applies to default scheduling only.
+ * @return true if successful, false if a setting was rejected (e.g. missing privileges).
+ */
+bool configureCurrentThread(const std::vector<int>& cpus, int priority, int nice);
+
+/*!
+ * Work-stealing thread pool shared by all computations of the node. Each worker has its own task queue,
+ * takes its newest task first and steals the oldest tasks of the other workers when it runs out of work.
+ * Threads which start a parallel loop run its unclaimed chunks themselves and block until the chunks
+ * claimed by other threads are done. Since these chunks are running, nested loops neither deadlock nor
+ * start more threads than configured.
+ */
+class ThreadPool
+{
+ public:
+  //! Metrics of the pool.
+  struct Metrics
+  {
+    //! Number of worker threads.
+    size_t nThreads;
+    //! Number of tasks waiting in the queues.
+    size_t queueDepth;
+    //! Number of tasks taken from the queue of another worker.
+    size_t nSteals;
+    //! Number of tasks run.
+    size_t nTasks;
+  };
+
+  /*!
+   * Gets the pool of the node.
+   * @return the pool.
+   */
+  static ThreadPool& getInstance();
+
+  /*!
+   * Destructor, runs the pending tasks and stops the workers.
+   */
+  ~ThreadPool();
+
+  /*!
+   * (Re)starts the workers. Call before the pool is used, pending tasks are run first.
+   * @param nThreads the number of worker threads, the callers of parallel loops also take part.
+   * @param cpus the CPUs the workers are allowed to run on, any CPU if empty.
+   * @param priority the SCHED_FIFO priority of the workers, default scheduling if 0.
+   * @param nice the nice value of the workers.
+   */
+  void configure(unsigned int nThreads, const std::vector<int>& cpus, int priority, int nice);
+
+  /*!
+   * Submits a task to run asynchronously.
+   * @param task the task.
+   */
+  void submit(std::function<void()> task);
+
+  /*!
+   * Runs a loop in parallel, split into chunks of at least grainSize iterations, and returns when all
+   * chunks are done. May be nested. The caller only runs chunks of this loop.
+   * @param begin the first iteration.
+   * @param end the iteration after the last one.
+   * @param grainSize the minimal number of iterations of a chunk.
+   * @param function called with (chunkBegin, chunkEnd) for each chunk.
+   */
+  void parallelFor(int begin, int end, int grainSize, const std::function<void(int, int)>& function);
+
+  /*!
+   * Gets the metrics of the pool.
+   * @return the metrics.
+   */
+  Metrics getMetrics() const;
+
+ private:
+  //! Worker thread with its task queue.
+  struct Worker
+  {
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::thread thread;
+  };
+
+  ThreadPool();
+
+  /*!
+   * Starts the workers.
+   * @param nThreads the number of worker threads.
+   * @param cpus the CPUs the workers are allowed to run on, any CPU if empty.
+   * @param priority the SCHED_FIFO priority of the workers, default scheduling if 0.
+   * @param nice the nice value of the workers.
+   */
+  void start(unsigned int nThreads, const std::vector<int>& cpus, int priority, int nice);
+
+  /*!
+   * Runs the pending tasks and stops the workers.
+   */
+  void stop();
+
+  /*!
+   * Runs one pending task, preferring the queue of the worker, then the shared queue, then the queues
+   * of the other workers.
+   * @param workerIndex the index of the calling worker, or -1 if the caller is not a worker.
+   * @return true if a task was run.
+   */
+  bool runPendingTask(int workerIndex);
+
+  /*!
+   * Main loop of a worker.
+   * @param workerIndex the index of the worker.
+   */
+  void run(int workerIndex);
+
+  //! Workers.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  //! Tasks submitted by threads which are not workers.
+  std::deque<std::function<void()>> sharedTasks_;
+  std::mutex sharedTasksMutex_;
+
+  //! Wakes up idle workers.
+  std::condition_variable condition_;
+  std::mutex conditionMutex_;
+
+  //! Serializes (re)configurations.
+  std::mutex configurationMutex_;
+
+  std::atomic<bool> isStopping_;
+  std::atomic<size_t> nPendingTasks_;
+  std::atomic<size_t> nSteals_;
+  std::atomic<size_t> nTasks_;
+};
+
+} /* namespace */
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * WeightedSumFilter.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#ifndef WEIGHTEDSUMFILTER_HPP
+#define WEIGHTEDSUMFILTER_HPP
+
+#include <filters/filter_base.h>
+
+#include <string>
+#include <vector>
+
+namespace filters {
+
+/*!
+ * Weighted Sum Filter class to combine traversability layers, e.g. the slope, step and roughness
+ * traversability into the traversability.
+ */
+template<typename T>
+class WeightedSumFilter : public FilterBase<T>
+{
+
+ public:
+  /*!
+   * Constructor
+   */
+  WeightedSumFilter();
+
+  /*!
+   * Destructor.
+   */
+  virtual ~WeightedSumFilter();
+
+  /*!
+   * Configures the filter from parameters on the Parameter Server
+   */
+  virtual bool configure();
+
+  /*!
+   * Computes the weighted sum of the input layers and saves it as additional grid map layer.
+   * NAN in any input layer results in NAN. If enabled, the sums of the pessimistic and optimistic
+   * variants of the input layers (suffixes "_pessimistic" and "_optimistic", the nominal layer where
+   * a variant does not exist) are saved with the same suffixes.
+   * @param mapIn grid map containing the input layers.
+   * @param mapOut grid map containing mapIn and the weighted sum.
+   */
+  virtual bool update(const T& mapIn, T& mapOut);
+
+  /*!
+   * Computes the weighted sum in place, i.e. as update() without copying the map.
+   * Used by the statically composed filter pipeline.
+   * @param mapOut grid map containing the input layers, the output layer is added.
+   */
+  bool compute(T& mapOut);
+
+ private:
+
+  //! Input layers.
+  std::vector<std::string> layers_;
+
+  //! Weights of the input layers.
+  std::vector<double> weights_;
+
+  //! Compute the sums of the pessimistic and optimistic variants.
+  bool computeBoundVariants_;
+
+  //! Output layer.
+  std::string outputLayer_;
+};
+
+} /* namespace */
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * CircleKernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/CircleKernel.hpp"
+
+namespace filters {
+
+void getPaddedLayer(const grid_map::GridMap& map, const std::string& layer, const int padding, grid_map::Matrix& padded)
+{
+  const grid_map::Size size = map.getSize();
+  const grid_map::Index startIndex = map.getStartIndex();
+  const grid_map::Matrix& data = map[layer];
+  padded.setConstant(size(0) + 2 * padding, size(1) + 2 * padding, NAN);
+  // The buffer holds up to two blocks per dimension, in front of and behind the start index.
+  const grid_map::Size firstSize = size - startIndex;
+  padded.block(padding, padding, firstSize(0), firstSize(1)) =
+      data.block(startIndex(0), startIndex(1), firstSize(0), firstSize(1));
+  padded.block(padding + firstSize(0), padding, startIndex(0), firstSize(1)) =
+      data.block(0, startIndex(1), startIndex(0), firstSize(1));
+  padded.block(padding, padding + firstSize(1), firstSize(0), startIndex(1)) =
+      data.block(startIndex(0), 0, firstSize(0), startIndex(1));
+  padded.block(padding + firstSize(0), padding + firstSize(1), startIndex(0), startIndex(1)) =
+      data.block(0, 0, startIndex(0), startIndex(1));
+}
+
+void setLayerInMapIndexOrder(const grid_map::Matrix& data, const std::string& layer, grid_map::GridMap& map)
+{
+  const grid_map::Size size = map.getSize();
+  const grid_map::Index startIndex = map.getStartIndex();
+  grid_map::Matrix& buffer = map[layer];
+  const grid_map::Size firstSize = size - startIndex;
+  buffer.block(startIndex(0), startIndex(1), firstSize(0), firstSize(1)) = data.block(0, 0, firstSize(0), firstSize(1));
+  buffer.block(0, startIndex(1), startIndex(0), firstSize(1)) = data.block(firstSize(0), 0, startIndex(0), firstSize(1));
+  buffer.block(startIndex(0), 0, firstSize(0), startIndex(1)) = data.block(0, firstSize(1), firstSize(0), startIndex(1));
+  buffer.block(0, 0, startIndex(0), startIndex(1)) = data.block(firstSize(0), firstSize(1), startIndex(0), startIndex(1));
+}
+
+} /* namespace */
@@ -8,6 +8,8 @@
 
 #include "filters/RoughnessFilter.hpp"
 #include <pluginlib/class_list_macros.h>
+#include <algorithm>
+#include <cmath>
 
 // Grid Map
 #include <grid_map_ros/grid_map_ros.hpp>
@@ -21,6 +23,7 @@ template<typename T>
 RoughnessFilter<T>::RoughnessFilter()
     : criticalValue_(0.3),
       estimationRadius_(0.3),
+      computeBoundVariants_(false),
       type_("traversability_roughness")
 {
 
@@ -66,17 +69,41 @@ bool RoughnessFilter<T>::configure()
 
   ROS_DEBUG("Roughness map type = %s", type_.c_str());
 
+  // Optional, computes the pessimistic and optimistic roughness traversability from the elevation bounds.
+  FilterBase<T>::getParam(std::string("compute_bound_variants"), computeBoundVariants_);
+
   return true;
 }
 
 template<typename T>
 bool RoughnessFilter<T>::update(const T& mapIn, T& mapOut)
 {
-  // Add new layer to the elevation map.
   mapOut = mapIn;
+  return compute(mapOut);
+}
+
+template<typename T>
+bool RoughnessFilter<T>::compute(T& mapOut)
+{
+  // Add new layer to the elevation map.
   mapOut.add(type_);
   double roughnessMax = 0.0;
 
+  // The roughness bounds from the elevation bounds are gathered in the same window traversal.
+  const bool computeBounds = computeBoundVariants_ && mapOut.exists("upper_bound") && mapOut.exists("lower_bound");
+  if (computeBoundVariants_ && !computeBounds) {
+    ROS_WARN_ONCE("Roughness filter: The map has no elevation bounds, the pessimistic and optimistic variants are not computed.");
+  }
+  const std::string typePessimistic = type_ + "_pessimistic";
+  const std::string typeOptimistic = type_ + "_optimistic";
+  if (computeBounds) {
+    mapOut.add(typePessimistic);
+    mapOut.add(typeOptimistic);
+  }
+  const auto toTraversability = [this](const double roughness) {
+    return roughness < criticalValue_ ? 1.0 - roughness / criticalValue_ : 0.0;
+  };
+
   for (GridMapIterator iterator(mapOut);
       !iterator.isPastEnd(); ++iterator) {
 
@@ -86,6 +113,7 @@ bool RoughnessFilter<T>::update(const T& mapIn, T& mapOut)
     // Prepare data computation.
     const int maxNumberOfCells = ceil(pow(2*estimationRadius_/mapOut.getResolution(),2));
     MatrixXd points(3, maxNumberOfCells);
+    MatrixXd bounds(2, computeBounds ? maxNumberOfCells : 0);
 
     // Requested position (center) of circle in map.
     Position center;
@@ -99,6 +127,13 @@ bool RoughnessFilter<T>::update(const T& mapIn, T& mapOut)
       Vector3d point;
       mapOut.getPosition3("elevation", *submapIterator, point);
       points.col(nPoints) = point;
+      if (computeBounds) {
+        // Unknown bounds do not widen the range of the point.
+        const double upper = mapOut.at("upper_bound", *submapIterator);
+        const double lower = mapOut.at("lower_bound", *submapIterator);
+        bounds(0, nPoints) = std::isfinite(lower) ? std::min(lower, point.z()) : point.z();
+        bounds(1, nPoints) = std::isfinite(upper) ? std::max(upper, point.z()) : point.z();
+      }
       nPoints++;
     }
 
@@ -109,18 +144,24 @@ bool RoughnessFilter<T>::update(const T& mapIn, T& mapOut)
     double normalY = mapOut.at("surface_normal_y", *iterator);
     double normalZ = mapOut.at("surface_normal_z", *iterator);
     double planeParameter = mean.x()*normalX + mean.y()*normalY + mean.z()*normalZ;
-    double sum = 0.0;
+    double sum = 0.0, sumPessimistic = 0.0, sumOptimistic = 0.0;
     for (int i = 0; i < nPoints; i++) {
       double dist = normalX*points(0,i) + normalY*points(1,i) + normalZ*points(2,i) - planeParameter;
       sum += pow(dist,2);
+      if (computeBounds) {
+        // Range of the distance to the plane if the height of the point is anywhere within its bounds.
+        const double distLower = dist + normalZ * (bounds(0, i) - points(2, i));
+        const double distUpper = dist + normalZ * (bounds(1, i) - points(2, i));
+        sumPessimistic += pow(std::max(std::abs(distLower), std::abs(distUpper)), 2);
+        if (distLower * distUpper > 0.0) sumOptimistic += pow(std::min(std::abs(distLower), std::abs(distUpper)), 2);
+      }
     }
     double roughness = sqrt(sum / (nPoints -1));
 
-    if (roughness < criticalValue_) {
-      mapOut.at(type_, *iterator) = 1.0 - roughness / criticalValue_;
-    }
-    else {
-      mapOut.at(type_, *iterator) = 0.0;
+    mapOut.at(type_, *iterator) = toTraversability(roughness);
+    if (computeBounds) {
+      mapOut.at(typePessimistic, *iterator) = toTraversability(sqrt(sumPessimistic / (nPoints - 1)));
+      mapOut.at(typeOptimistic, *iterator) = toTraversability(sqrt(sumOptimistic / (nPoints - 1)));
     }
 
     if (roughness > roughnessMax) roughnessMax = roughness;
@@ -131,6 +172,8 @@ bool RoughnessFilter<T>::update(const T& mapIn, T& mapOut)
   return true;
 }
 
+template class RoughnessFilter<grid_map::GridMap>;
+
 } /* namespace */
 
 PLUGINLIB_EXPORT_CLASS(filters::RoughnessFilter<grid_map::GridMap>, filters::FilterBase<grid_map::GridMap>)
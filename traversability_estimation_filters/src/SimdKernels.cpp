@@ -0,0 +1,295 @@
+/*
+ * SimdKernels.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/SimdKernels.hpp"
+#include <ros/console.h>
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRAVERSABILITY_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+// The translation unit is compiled with -fno-math-errno (see CMakeLists.txt), such that the square root of the scalar
+// kernels is an instruction instead of a call into the math library.
+
+namespace filters {
+
+namespace {
+
+//! Coefficients of the arc cosine approximation, Abramowitz and Stegun 4.4.46 (absolute error below 2e-8).
+constexpr float acosCoefficients[8] = {-0.0012624911f, 0.0066700901f, -0.0170881256f, 0.0308918810f,
+                                       -0.0501743046f, 0.0889789874f, -0.2145988016f, 1.5707963050f};
+
+inline float computeAcos(const float x)
+{
+  const float a = std::fabs(x);
+  float polynomial = acosCoefficients[0];
+  for (int k = 1; k < 8; ++k) polynomial = polynomial * a + acosCoefficients[k];
+  const float result = std::sqrt(1.0f - a) * polynomial;
+  return x < 0.0f ? static_cast<float>(M_PI) - result : result;
+}
+
+inline float computeSlopeTraversability(const float normalZ, const float criticalValue)
+{
+  const float slope = computeAcos(normalZ);
+  const float value = slope < criticalValue ? 1.0f - slope / criticalValue : 0.0f;
+  return normalZ == normalZ ? value : NAN;
+}
+
+// Scalar reference kernels, also used for the remainders of the vector kernels. Comparisons with NAN are
+// false, such that NAN values are ignored by the minima, maxima and counts.
+
+void slopeTraversabilityScalar(const float* normalZ, float* traversability, const size_t n, const float criticalValue)
+{
+  for (size_t i = 0; i < n; ++i) traversability[i] = computeSlopeTraversability(normalZ[i], criticalValue);
+}
+
+void updateMinMaxScalar(const float* values, float* minimum, float* maximum, const size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    minimum[i] = values[i] < minimum[i] ? values[i] : minimum[i];
+    maximum[i] = values[i] > maximum[i] ? values[i] : maximum[i];
+  }
+}
+
+void updateMaxAndCountScalar(const float* values, const float threshold, float* maximum, int* count, const size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    maximum[i] = values[i] > maximum[i] ? values[i] : maximum[i];
+    count[i] += values[i] > threshold ? 1 : 0;
+  }
+}
+
+void addWeightedScalar(const float* values, const float weight, float* sum, const size_t n)
+{
+  for (size_t i = 0; i < n; ++i) sum[i] += weight * values[i];
+}
+
+const SimdKernels scalarKernels{SimdVariant::Scalar, slopeTraversabilityScalar, updateMinMaxScalar, updateMaxAndCountScalar,
+                                addWeightedScalar};
+
+#ifdef TRAVERSABILITY_SIMD_DISPATCH
+
+// Vector kernels. min(a, b) and max(a, b) return b if a comparison with NAN is false, which matches the scalar
+// kernels with the values as first operand.
+
+__attribute__((target("avx2,fma"))) void slopeTraversabilityAvx2(const float* normalZ, float* traversability, const size_t n,
+                                                                 const float criticalValue)
+{
+  const __m256 signMask = _mm256_set1_ps(-0.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 pi = _mm256_set1_ps(static_cast<float>(M_PI));
+  const __m256 critical = _mm256_set1_ps(criticalValue);
+  const __m256 nan = _mm256_set1_ps(NAN);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 x = _mm256_loadu_ps(normalZ + i);
+    const __m256 a = _mm256_andnot_ps(signMask, x);
+    __m256 polynomial = _mm256_set1_ps(acosCoefficients[0]);
+    for (int k = 1; k < 8; ++k) polynomial = _mm256_fmadd_ps(polynomial, a, _mm256_set1_ps(acosCoefficients[k]));
+    const __m256 result = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(one, a)), polynomial);
+    const __m256 slope = _mm256_blendv_ps(result, _mm256_sub_ps(pi, result), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+    const __m256 value =
+        _mm256_and_ps(_mm256_sub_ps(one, _mm256_div_ps(slope, critical)), _mm256_cmp_ps(slope, critical, _CMP_LT_OQ));
+    _mm256_storeu_ps(traversability + i, _mm256_blendv_ps(value, nan, _mm256_cmp_ps(x, x, _CMP_UNORD_Q)));
+  }
+  slopeTraversabilityScalar(normalZ + i, traversability + i, n - i, criticalValue);
+}
+
+__attribute__((target("avx2,fma"))) void updateMinMaxAvx2(const float* values, float* minimum, float* maximum, const size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 value = _mm256_loadu_ps(values + i);
+    _mm256_storeu_ps(minimum + i, _mm256_min_ps(value, _mm256_loadu_ps(minimum + i)));
+    _mm256_storeu_ps(maximum + i, _mm256_max_ps(value, _mm256_loadu_ps(maximum + i)));
+  }
+  updateMinMaxScalar(values + i, minimum + i, maximum + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) void updateMaxAndCountAvx2(const float* values, const float threshold, float* maximum, int* count,
+                                                               const size_t n)
+{
+  const __m256 thresholds = _mm256_set1_ps(threshold);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 value = _mm256_loadu_ps(values + i);
+    _mm256_storeu_ps(maximum + i, _mm256_max_ps(value, _mm256_loadu_ps(maximum + i)));
+    // The mask of a true comparison is -1.
+    const __m256i isAbove = _mm256_castps_si256(_mm256_cmp_ps(value, thresholds, _CMP_GT_OQ));
+    __m256i* counts = reinterpret_cast<__m256i*>(count + i);
+    _mm256_storeu_si256(counts, _mm256_sub_epi32(_mm256_loadu_si256(counts), isAbove));
+  }
+  updateMaxAndCountScalar(values + i, threshold, maximum + i, count + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) void addWeightedAvx2(const float* values, const float weight, float* sum, const size_t n)
+{
+  const __m256 weights = _mm256_set1_ps(weight);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(sum + i, _mm256_fmadd_ps(weights, _mm256_loadu_ps(values + i), _mm256_loadu_ps(sum + i)));
+  }
+  addWeightedScalar(values + i, weight, sum + i, n - i);
+}
+
+#define TRAVERSABILITY_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+
+TRAVERSABILITY_AVX512 void slopeTraversabilityAvx512(const float* normalZ, float* traversability, const size_t n, const float criticalValue)
+{
+  const __m512 one = _mm512_set1_ps(1.0f);
+  const __m512 pi = _mm512_set1_ps(static_cast<float>(M_PI));
+  const __m512 critical = _mm512_set1_ps(criticalValue);
+  const __m512 nan = _mm512_set1_ps(NAN);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 x = _mm512_loadu_ps(normalZ + i);
+    const __m512 a = _mm512_abs_ps(x);
+    __m512 polynomial = _mm512_set1_ps(acosCoefficients[0]);
+    for (int k = 1; k < 8; ++k) polynomial = _mm512_fmadd_ps(polynomial, a, _mm512_set1_ps(acosCoefficients[k]));
+    const __m512 result = _mm512_mul_ps(_mm512_sqrt_ps(_mm512_sub_ps(one, a)), polynomial);
+    const __m512 slope = _mm512_mask_sub_ps(result, _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ), pi, result);
+    const __m512 value = _mm512_maskz_sub_ps(_mm512_cmp_ps_mask(slope, critical, _CMP_LT_OQ), one, _mm512_div_ps(slope, critical));
+    _mm512_storeu_ps(traversability + i, _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), value, nan));
+  }
+  slopeTraversabilityScalar(normalZ + i, traversability + i, n - i, criticalValue);
+}
+
+TRAVERSABILITY_AVX512 void updateMinMaxAvx512(const float* values, float* minimum, float* maximum, const size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 value = _mm512_loadu_ps(values + i);
+    _mm512_storeu_ps(minimum + i, _mm512_min_ps(value, _mm512_loadu_ps(minimum + i)));
+    _mm512_storeu_ps(maximum + i, _mm512_max_ps(value, _mm512_loadu_ps(maximum + i)));
+  }
+  updateMinMaxScalar(values + i, minimum + i, maximum + i, n - i);
+}
+
+TRAVERSABILITY_AVX512 void updateMaxAndCountAvx512(const float* values, const float threshold, float* maximum, int* count, const size_t n)
+{
+  const __m512 thresholds = _mm512_set1_ps(threshold);
+  const __m512i ones = _mm512_set1_epi32(1);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 value = _mm512_loadu_ps(values + i);
+    _mm512_storeu_ps(maximum + i, _mm512_max_ps(value, _mm512_loadu_ps(maximum + i)));
+    const __m512i counts = _mm512_loadu_si512(count + i);
+    _mm512_storeu_si512(count + i, _mm512_mask_add_epi32(counts, _mm512_cmp_ps_mask(value, thresholds, _CMP_GT_OQ), counts, ones));
+  }
+  updateMaxAndCountScalar(values + i, threshold, maximum + i, count + i, n - i);
+}
+
+TRAVERSABILITY_AVX512 void addWeightedAvx512(const float* values, const float weight, float* sum, const size_t n)
+{
+  const __m512 weights = _mm512_set1_ps(weight);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(sum + i, _mm512_fmadd_ps(weights, _mm512_loadu_ps(values + i), _mm512_loadu_ps(sum + i)));
+  }
+  addWeightedScalar(values + i, weight, sum + i, n - i);
+}
+
+const SimdKernels avx2Kernels{SimdVariant::Avx2, slopeTraversabilityAvx2, updateMinMaxAvx2, updateMaxAndCountAvx2, addWeightedAvx2};
+const SimdKernels avx512Kernels{SimdVariant::Avx512, slopeTraversabilityAvx512, updateMinMaxAvx512, updateMaxAndCountAvx512,
+                                addWeightedAvx512};
+#endif
+
+bool isSupported(const SimdVariant variant)
+{
+#ifdef TRAVERSABILITY_SIMD_DISPATCH
+  __builtin_cpu_init();
+  switch (variant) {
+    case SimdVariant::Scalar:
+      return true;
+    case SimdVariant::Avx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case SimdVariant::Avx512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw") &&
+             __builtin_cpu_supports("avx512vl");
+  }
+  return false;
+#else
+  return variant == SimdVariant::Scalar;
+#endif
+}
+
+const SimdKernels& getKernels(const SimdVariant variant)
+{
+#ifdef TRAVERSABILITY_SIMD_DISPATCH
+  if (variant == SimdVariant::Avx512) return avx512Kernels;
+  if (variant == SimdVariant::Avx2) return avx2Kernels;
+#endif
+  return scalarKernels;
+}
+
+const SimdKernels* getBestKernels()
+{
+  // Initialized once, also if several threads use the kernels first.
+  static const SimdKernels* const bestKernels = [] {
+    const SimdVariant variant = isSupported(SimdVariant::Avx512) ? SimdVariant::Avx512
+                                : isSupported(SimdVariant::Avx2) ? SimdVariant::Avx2
+                                                                 : SimdVariant::Scalar;
+    ROS_INFO("Traversability filters use the %s kernels.", getSimdVariantName(variant).c_str());
+    return &getKernels(variant);
+  }();
+  return bestKernels;
+}
+
+//! Selected kernels, the best ones on the first use if not forced.
+std::atomic<const SimdKernels*> selectedKernels{nullptr};
+
+} /* namespace */
+
+const SimdKernels& getSimdKernels()
+{
+  const SimdKernels* kernels = selectedKernels.load(std::memory_order_acquire);
+  if (kernels != nullptr) return *kernels;
+  // A variant forced in the meantime is kept.
+  kernels = nullptr;
+  selectedKernels.compare_exchange_strong(kernels, getBestKernels(), std::memory_order_acq_rel);
+  return *selectedKernels.load(std::memory_order_acquire);
+}
+
+bool setSimdVariant(const std::string& name)
+{
+  if (name == "auto") {
+    selectedKernels.store(getBestKernels(), std::memory_order_release);
+    return true;
+  }
+  for (const SimdVariant variant : {SimdVariant::Scalar, SimdVariant::Avx2, SimdVariant::Avx512}) {
+    if (name != getSimdVariantName(variant)) continue;
+    if (!isSupported(variant)) {
+      ROS_ERROR("Traversability filters: The %s kernels are not supported by this CPU.", name.c_str());
+      return false;
+    }
+    selectedKernels.store(&getKernels(variant), std::memory_order_release);
+    ROS_INFO("Traversability filters use the %s kernels (forced).", name.c_str());
+    return true;
+  }
+  ROS_ERROR("Traversability filters: Unknown kernel variant '%s'.", name.c_str());
+  return false;
+}
+
+std::string getSimdVariantName(const SimdVariant variant)
+{
+  switch (variant) {
+    case SimdVariant::Scalar:
+      return "scalar";
+    case SimdVariant::Avx2:
+      return "avx2";
+    case SimdVariant::Avx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+} /* namespace */
@@ -7,6 +7,8 @@
  */
 
 #include "filters/SlopeFilter.hpp"
+#include "filters/SimdKernels.hpp"
+#include "filters/ThreadPool.hpp"
 #include <pluginlib/class_list_macros.h>
 
 // Grid Map
@@ -58,36 +60,35 @@ bool SlopeFilter<T>::configure()
 template<typename T>
 bool SlopeFilter<T>::update(const T& mapIn, T& mapOut)
 {
-  // Add new layer to the elevation map.
   mapOut = mapIn;
-  mapOut.add(type_);
-
-  double slope, slopeMax = 0.0;
-
-  for (GridMapIterator iterator(mapOut);
-      !iterator.isPastEnd(); ++iterator) {
-
-    // Check if there is a surface normal (empty cell).
-    if (!mapOut.isValid(*iterator, "surface_normal_z")) continue;
+  return compute(mapOut);
+}
 
-    // Compute slope from surface normal z
-    slope = acos(mapOut.at("surface_normal_z", *iterator));
+template<typename T>
+bool SlopeFilter<T>::compute(T& mapOut)
+{
+  // Add new layer to the elevation map.
+  mapOut.add(type_);
 
-    if (slope < criticalValue_) {
-      mapOut.at(type_, *iterator) = 1.0 - slope / criticalValue_;
-    }
-    else {
-      mapOut.at(type_, *iterator) = 0.0;
-    }
+  // Compute slope from surface normal z, element-wise on the buffers.
+  const Matrix& normalZ = mapOut["surface_normal_z"];
+  Matrix& slopeTraversability = mapOut[type_];
+  const SimdKernels& simdKernels = getSimdKernels();
+  ThreadPool::getInstance().parallelFor(0, normalZ.size(), 16384, [&](const int begin, const int end) {
+    simdKernels.slopeTraversability(normalZ.data() + begin, slopeTraversability.data() + begin, end - begin, criticalValue_);
+  });
 
-    if (slope > slopeMax) slopeMax = slope;
-  }
+  // The slope decreases with the surface normal z.
+  double slopeMax = 0.0;
+  if (normalZ.size() > 0) slopeMax = acos(normalZ.array().isNaN().select(1.0f, normalZ.array()).minCoeff());
 
   ROS_DEBUG("slope max = %f", slopeMax);
 
   return true;
 }
 
+template class SlopeFilter<grid_map::GridMap>;
+
 } /* namespace */
 
 PLUGINLIB_EXPORT_CLASS(filters::SlopeFilter<grid_map::GridMap>, filters::FilterBase<grid_map::GridMap>)
@@ -7,8 +7,16 @@
  */
 
 #include "filters/StepFilter.hpp"
+#include "filters/CircleKernel.hpp"
+#include "filters/SimdKernels.hpp"
+#include "filters/ThreadPool.hpp"
 #include <pluginlib/class_list_macros.h>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Grid Map
 #include <grid_map_ros/grid_map_ros.hpp>
@@ -23,6 +31,7 @@ StepFilter<T>::StepFilter()
       firstWindowRadius_(0.08),
       secondWindowRadius_(0.08),
       nCellCritical_(5),
+      computeBoundVariants_(false),
       type_("traversability_step")
 {
 
@@ -95,25 +104,124 @@ bool StepFilter<T>::configure()
 
   ROS_DEBUG("Step map type = %s.", type_.c_str());
 
+  // Optional, computes the pessimistic and optimistic step traversability from the elevation bounds.
+  FilterBase<T>::getParam(std::string("compute_bound_variants"), computeBoundVariants_);
+
   return true;
 }
 
 template<typename T>
 bool StepFilter<T>::update(const T& mapIn, T& mapOut)
 {
-  // Add new layers to the elevation map.
   mapOut = mapIn;
+  return compute(mapOut);
+}
+
+template<typename T>
+bool StepFilter<T>::compute(T& mapOut)
+{
+  // Add new layers to the elevation map.
   mapOut.add(type_);
   mapOut.add("step_height");
 
-  double height, step;
+  // The step heights from the elevation bounds are gathered in the same window traversals.
+  const bool computeBounds = computeBoundVariants_ && mapOut.exists("upper_bound") && mapOut.exists("lower_bound");
+  if (computeBoundVariants_ && !computeBounds) {
+    ROS_WARN_ONCE("Step filter: The map has no elevation bounds, the pessimistic and optimistic variants are not computed.");
+  }
+  std::vector<std::pair<std::string, std::string>> stepLayers{{"step_height", type_}};
+  if (computeBounds) {
+    stepLayers.emplace_back("step_height_pessimistic", type_ + "_pessimistic");
+    stepLayers.emplace_back("step_height_optimistic", type_ + "_optimistic");
+  }
+  for (const auto& stepLayer : stepLayers) {
+    mapOut.add(stepLayer.first);
+    mapOut.add(stepLayer.second);
+  }
+
+  // The bounds of the step are clamped around the nominal step for cells with partially unknown bounds.
+  const auto setStepHeights = [](const float stepHeight, const float upperMax, const float upperMin, const float lowerMax,
+                                 const float lowerMin, float& stepHeightPessimistic, float& stepHeightOptimistic) {
+    stepHeightPessimistic = std::isfinite(upperMax - lowerMin) ? std::max(upperMax - lowerMin, stepHeight) : stepHeight;
+    stepHeightOptimistic = std::isfinite(lowerMax - upperMin) ? std::min(std::max(lowerMax - upperMin, 0.0f), stepHeight) : stepHeight;
+  };
+  const auto computeStepTraversability = [this](const double stepMax, const int nCells) {
+    const double step = std::min(stepMax, (double) nCells / (double) nCellCritical_ * stepMax);
+    return step < criticalValue_ ? 1.0 - step / criticalValue_ : 0.0;
+  };
+
+  double height;
+  const Size size = mapOut.getSize();
+
+  // First iteration through the elevation map, sweeping the columns with the specialized kernel for
+  // small windows. Cells outside of the map are NAN, which the SIMD kernels ignore.
+  const SimdKernels& simdKernels = getSimdKernels();
+  const int columnsPerTask = 16;
+  const bool firstIterationIsSpecialized = visitCircleKernel(
+      firstWindowRadius_ / mapOut.getResolution(), [&](const auto& kernel) {
+        const int radius = std::decay_t<decltype(kernel)>::radius;
+        Matrix elevation, upperBound, lowerBound, stepHeight, stepHeightPessimistic, stepHeightOptimistic;
+        getPaddedLayer(mapOut, "elevation", radius, elevation);
+        stepHeight.setConstant(size(0), size(1), NAN);
+        if (computeBounds) {
+          getPaddedLayer(mapOut, "upper_bound", radius, upperBound);
+          getPaddedLayer(mapOut, "lower_bound", radius, lowerBound);
+          // Cells without elevation are skipped for the bounds too, as in the generic iteration.
+          const Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> hasElevation = elevation.array().isFinite();
+          upperBound = hasElevation.select(upperBound.array(), NAN).matrix();
+          lowerBound = hasElevation.select(lowerBound.array(), NAN).matrix();
+          stepHeightPessimistic.setConstant(size(0), size(1), NAN);
+          stepHeightOptimistic.setConstant(size(0), size(1), NAN);
+        }
+        ThreadPool::getInstance().parallelFor(0, size(1), columnsPerTask, [&](const int columnBegin, const int columnEnd) {
+          std::vector<float> heightMin(size(0)), heightMax(size(0));
+          std::vector<float> upperMin, upperMax, lowerMin, lowerMax;
+          if (computeBounds) {
+            upperMin.resize(size(0));
+            upperMax.resize(size(0));
+            lowerMin.resize(size(0));
+            lowerMax.resize(size(0));
+          }
+          for (int j = columnBegin; j < columnEnd; ++j) {
+            for (auto* minimum : {&heightMin, &upperMin, &lowerMin}) {
+              std::fill(minimum->begin(), minimum->end(), std::numeric_limits<float>::infinity());
+            }
+            for (auto* maximum : {&heightMax, &upperMax, &lowerMax}) {
+              std::fill(maximum->begin(), maximum->end(), -std::numeric_limits<float>::infinity());
+            }
+            kernel.forEachOffset([&](const int rowOffset, const int columnOffset) {
+              const int row = radius + rowOffset;
+              const int column = j + radius + columnOffset;
+              simdKernels.updateMinMax(&elevation(row, column), heightMin.data(), heightMax.data(), size(0));
+              if (!computeBounds) return;
+              simdKernels.updateMinMax(&upperBound(row, column), upperMin.data(), upperMax.data(), size(0));
+              simdKernels.updateMinMax(&lowerBound(row, column), lowerMin.data(), lowerMax.data(), size(0));
+            });
+            for (int i = 0; i < size(0); ++i) {
+              if (!std::isfinite(elevation(i + radius, j + radius))) continue;
+              stepHeight(i, j) = heightMax[i] - heightMin[i];
+              if (computeBounds) {
+                setStepHeights(stepHeight(i, j), upperMax[i], upperMin[i], lowerMax[i], lowerMin[i], stepHeightPessimistic(i, j),
+                               stepHeightOptimistic(i, j));
+              }
+            }
+          }
+        });
+        setLayerInMapIndexOrder(stepHeight, "step_height", mapOut);
+        if (computeBounds) {
+          setLayerInMapIndexOrder(stepHeightPessimistic, "step_height_pessimistic", mapOut);
+          setLayerInMapIndexOrder(stepHeightOptimistic, "step_height_optimistic", mapOut);
+        }
+      });
 
   // First iteration through the elevation map.
-  for (GridMapIterator iterator(mapOut); !iterator.isPastEnd(); ++iterator) {
+  for (GridMapIterator iterator(mapOut); !firstIterationIsSpecialized && !iterator.isPastEnd(); ++iterator) {
     if (!mapOut.isValid(*iterator, "elevation"))
       continue;
     height = mapOut.at("elevation", *iterator);
     double heightMax, heightMin;
+    float upperMax = -std::numeric_limits<float>::infinity(), upperMin = std::numeric_limits<float>::infinity();
+    float lowerMax = -std::numeric_limits<float>::infinity(), lowerMin = std::numeric_limits<float>::infinity();
 
     // Requested position (center) of circle in map.
     Eigen::Vector2d center;
@@ -125,6 +233,18 @@ bool StepFilter<T>::update(const T& mapIn, T& mapOut)
         !submapIterator.isPastEnd(); ++submapIterator) {
       if (!mapOut.isValid(*submapIterator, "elevation"))
         continue;
+      if (computeBounds) {
+        const float upper = mapOut.at("upper_bound", *submapIterator);
+        const float lower = mapOut.at("lower_bound", *submapIterator);
+        if (std::isfinite(upper)) {
+          upperMax = std::max(upperMax, upper);
+          upperMin = std::min(upperMin, upper);
+        }
+        if (std::isfinite(lower)) {
+          lowerMax = std::max(lowerMax, lower);
+          lowerMin = std::min(lowerMin, lower);
+        }
+      }
       height = mapOut.at("elevation", *submapIterator);
       // Init heightMax and heightMin
       if (!init) {
@@ -139,14 +259,56 @@ bool StepFilter<T>::update(const T& mapIn, T& mapOut)
         heightMin = height;
     }
 
-    if (init)
+    if (init) {
       mapOut.at("step_height", *iterator) = heightMax - heightMin;
+      if (computeBounds) {
+        setStepHeights(heightMax - heightMin, upperMax, upperMin, lowerMax, lowerMin, mapOut.at("step_height_pessimistic", *iterator),
+                       mapOut.at("step_height_optimistic", *iterator));
+      }
+    }
   }
 
+  // Second iteration through the elevation map, sweeping the columns with the specialized kernel for
+  // small windows.
+  const int nStepLayers = stepLayers.size();
+  const bool secondIterationIsSpecialized = visitCircleKernel(
+      secondWindowRadius_ / mapOut.getResolution(), [&](const auto& kernel) {
+        const int radius = std::decay_t<decltype(kernel)>::radius;
+        std::vector<Matrix> stepHeights(nStepLayers), stepTraversabilities(nStepLayers);
+        for (int k = 0; k < nStepLayers; ++k) {
+          getPaddedLayer(mapOut, stepLayers[k].first, radius, stepHeights[k]);
+          stepTraversabilities[k].setConstant(size(0), size(1), NAN);
+        }
+        ThreadPool::getInstance().parallelFor(0, size(1), columnsPerTask, [&](const int columnBegin, const int columnEnd) {
+          std::vector<std::vector<float>> stepMax(nStepLayers, std::vector<float>(size(0)));
+          std::vector<std::vector<int>> nCells(nStepLayers, std::vector<int>(size(0)));
+          for (int j = columnBegin; j < columnEnd; ++j) {
+            for (int k = 0; k < nStepLayers; ++k) {
+              std::fill(stepMax[k].begin(), stepMax[k].end(), -std::numeric_limits<float>::infinity());
+              std::fill(nCells[k].begin(), nCells[k].end(), 0);
+            }
+            kernel.forEachOffset([&](const int rowOffset, const int columnOffset) {
+              for (int k = 0; k < nStepLayers; ++k) {
+                simdKernels.updateMaxAndCount(&stepHeights[k](radius + rowOffset, j + radius + columnOffset), criticalValue_,
+                                              stepMax[k].data(), nCells[k].data(), size(0));
+              }
+            });
+            for (int k = 0; k < nStepLayers; ++k) {
+              for (int i = 0; i < size(0); ++i) {
+                // No valid cell in the window.
+                if (stepMax[k][i] == -std::numeric_limits<float>::infinity()) continue;
+                stepTraversabilities[k](i, j) = computeStepTraversability(std::max(static_cast<double>(stepMax[k][i]), 0.0), nCells[k][i]);
+              }
+            }
+          }
+        });
+        for (int k = 0; k < nStepLayers; ++k) setLayerInMapIndexOrder(stepTraversabilities[k], stepLayers[k].second, mapOut);
+      });
+
   // Second iteration through the elevation map.
-  for (GridMapIterator iterator(mapOut); !iterator.isPastEnd(); ++iterator) {
-    int nCells = 0;
-    double stepMax = 0.0;
+  for (GridMapIterator iterator(mapOut); !secondIterationIsSpecialized && !iterator.isPastEnd(); ++iterator) {
+    std::vector<int> nCells(nStepLayers, 0);
+    std::vector<double> stepMax(nStepLayers, 0.0);
     bool isValid = false;
 
     // Requested position (center) of circle in map.
@@ -159,28 +321,28 @@ bool StepFilter<T>::update(const T& mapIn, T& mapOut)
       if (!mapOut.isValid(*submapIterator, "step_height"))
         continue;
       isValid = true;
-      if (mapOut.at("step_height", *submapIterator) > stepMax) {
-        stepMax = mapOut.at("step_height", *submapIterator);
+      for (int k = 0; k < nStepLayers; ++k) {
+        const double stepHeight = mapOut.at(stepLayers[k].first, *submapIterator);
+        if (stepHeight > stepMax[k])
+          stepMax[k] = stepHeight;
+        if (stepHeight > criticalValue_)
+          nCells[k]++;
       }
-      if (mapOut.at("step_height", *submapIterator) > criticalValue_)
-        nCells++;
     }
 
     if (isValid) {
-      step = std::min(stepMax,
-                      (double) nCells / (double) nCellCritical_ * stepMax);
-      if (step < criticalValue_) {
-        mapOut.at(type_, *iterator) = 1.0 - step / criticalValue_;
-      } else {
-        mapOut.at(type_, *iterator) = 0.0;
+      for (int k = 0; k < nStepLayers; ++k) {
+        mapOut.at(stepLayers[k].second, *iterator) = computeStepTraversability(stepMax[k], nCells[k]);
       }
     }
   }
-  // Remove unnecessary layer.
-  mapOut.erase("step_height");
+  // Remove unnecessary layers.
+  for (const auto& stepLayer : stepLayers) mapOut.erase(stepLayer.first);
   return true;
 }
 
+template class StepFilter<grid_map::GridMap>;
+
 } /* namespace */
 
 PLUGINLIB_EXPORT_CLASS(filters::StepFilter<grid_map::GridMap>, filters::FilterBase<grid_map::GridMap>)
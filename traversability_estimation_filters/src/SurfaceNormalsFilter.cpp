@@ -0,0 +1,158 @@
+/*
+ * SurfaceNormalsFilter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/SurfaceNormalsFilter.hpp"
+#include "filters/CircleKernel.hpp"
+#include "filters/ThreadPool.hpp"
+#include <pluginlib/class_list_macros.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Grid Map
+#include <grid_map_ros/grid_map_ros.hpp>
+
+#include <Eigen/Eigenvalues>
+
+using namespace grid_map;
+
+namespace filters {
+
+template<typename T>
+SurfaceNormalsFilter<T>::SurfaceNormalsFilter()
+    : inputLayer_("elevation"),
+      outputLayersPrefix_("surface_normal_"),
+      radius_(0.05),
+      normalVectorPositiveAxis_(Eigen::Vector3d::UnitZ())
+{
+
+}
+
+template<typename T>
+SurfaceNormalsFilter<T>::~SurfaceNormalsFilter()
+{
+
+}
+
+template<typename T>
+bool SurfaceNormalsFilter<T>::configure()
+{
+  if (!FilterBase<T>::getParam(std::string("input_layer"), inputLayer_)) {
+    ROS_ERROR("SurfaceNormalsFilter did not find param input_layer");
+    return false;
+  }
+
+  if (!FilterBase<T>::getParam(std::string("output_layers_prefix"), outputLayersPrefix_)) {
+    ROS_ERROR("SurfaceNormalsFilter did not find param output_layers_prefix");
+    return false;
+  }
+
+  if (!FilterBase<T>::getParam(std::string("radius"), radius_)) {
+    ROS_ERROR("SurfaceNormalsFilter did not find param radius");
+    return false;
+  }
+
+  if (radius_ < 0.0) {
+    ROS_ERROR("Surface normals radius must be greater than zero");
+    return false;
+  }
+
+  ROS_DEBUG("Surface normals radius = %f", radius_);
+
+  std::string normalVectorPositiveAxis;
+  if (!FilterBase<T>::getParam(std::string("normal_vector_positive_axis"), normalVectorPositiveAxis)) {
+    ROS_ERROR("SurfaceNormalsFilter did not find param normal_vector_positive_axis");
+    return false;
+  }
+
+  if (normalVectorPositiveAxis == "x") {
+    normalVectorPositiveAxis_ = Eigen::Vector3d::UnitX();
+  } else if (normalVectorPositiveAxis == "y") {
+    normalVectorPositiveAxis_ = Eigen::Vector3d::UnitY();
+  } else if (normalVectorPositiveAxis == "z") {
+    normalVectorPositiveAxis_ = Eigen::Vector3d::UnitZ();
+  } else {
+    ROS_ERROR("The surface normals positive axis '%s' is not valid", normalVectorPositiveAxis.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+template<typename T>
+bool SurfaceNormalsFilter<T>::update(const T& mapIn, T& mapOut)
+{
+  mapOut = mapIn;
+  return compute(mapOut);
+}
+
+template<typename T>
+bool SurfaceNormalsFilter<T>::compute(T& mapOut)
+{
+  // Add new layers to the elevation map.
+  const std::vector<std::string> normalLayers{outputLayersPrefix_ + "x", outputLayersPrefix_ + "y", outputLayersPrefix_ + "z"};
+  for (const auto& layer : normalLayers) mapOut.add(layer);
+
+  // Offsets of the cells within the radius, as visited by the circle iterator.
+  const double resolution = mapOut.getResolution();
+  const double radiusInCells = radius_ / resolution;
+  const int padding = static_cast<int>(std::floor(radiusInCells));
+  std::vector<std::pair<int, int>> offsets;
+  for (int columnOffset = -padding; columnOffset <= padding; ++columnOffset) {
+    for (int rowOffset = -padding; rowOffset <= padding; ++rowOffset) {
+      if (rowOffset * rowOffset + columnOffset * columnOffset <= radiusInCells * radiusInCells) {
+        offsets.emplace_back(rowOffset, columnOffset);
+      }
+    }
+  }
+
+  // The cells are visited in map index order on the padded layer, cells outside of the map are NAN.
+  const Size size = mapOut.getSize();
+  Matrix input;
+  getPaddedLayer(mapOut, inputLayer_, padding, input);
+  std::vector<Matrix> normals(3, Matrix::Constant(size(0), size(1), NAN));
+  ThreadPool::getInstance().parallelFor(0, size(1), 16, [&](const int columnBegin, const int columnEnd) {
+    for (int j = columnBegin; j < columnEnd; ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        if (!std::isfinite(input(i + padding, j + padding))) continue;
+
+        // Moments of the points relative to the center cell (the position decreases with the index).
+        Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+        Eigen::Matrix3d sumOfProducts = Eigen::Matrix3d::Zero();
+        int nPoints = 0;
+        for (const auto& offset : offsets) {
+          const float value = input(i + padding + offset.first, j + padding + offset.second);
+          if (!std::isfinite(value)) continue;
+          const Eigen::Vector3d point(-offset.first * resolution, -offset.second * resolution, value);
+          sum += point;
+          sumOfProducts += point * point.transpose();
+          nPoints++;
+        }
+        if (nPoints < 3) continue;
+
+        // The normal is the direction of least variance.
+        const Eigen::Vector3d mean = sum / nPoints;
+        const Eigen::Matrix3d covariance = sumOfProducts / nPoints - mean * mean.transpose();
+        Eigen::Vector3d normal = Eigen::Vector3d::UnitZ();
+        const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        if (solver.eigenvalues()(1) > 1e-8) normal = solver.eigenvectors().col(0);
+        if (normal.dot(normalVectorPositiveAxis_) < 0.0) normal = -normal;
+        for (int k = 0; k < 3; ++k) normals[k](i, j) = static_cast<float>(normal(k));
+      }
+    }
+  });
+  for (int k = 0; k < 3; ++k) setLayerInMapIndexOrder(normals[k], normalLayers[k], mapOut);
+
+  return true;
+}
+
+template class SurfaceNormalsFilter<grid_map::GridMap>;
+
+} /* namespace */
+
+PLUGINLIB_EXPORT_CLASS(filters::SurfaceNormalsFilter<grid_map::GridMap>, filters::FilterBase<grid_map::GridMap>)
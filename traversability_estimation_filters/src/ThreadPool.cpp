@@ -0,0 +1,257 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/ThreadPool.hpp"
+#include <ros/console.h>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace filters {
+
+namespace {
+
+//! Index of the worker running on this thread, -1 if the thread is not a worker.
+thread_local int currentWorkerIndex = -1;
+
+//! Number of checks for the end of a parallel loop before the caller blocks.
+constexpr int nSpinsBeforeBlocking = 2000;
+
+//! Hints the CPU that the thread spins.
+inline void relaxCpu()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+} /* namespace */
+
+bool configureCurrentThread(const std::vector<int>& cpus, const int priority, const int nice)
+{
+  bool success = true;
+#ifdef __linux__
+  if (!cpus.empty()) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const int cpu : cpus) CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+      ROS_WARN("Could not set the CPU affinity of thread %ld.", syscall(SYS_gettid));
+      success = false;
+    }
+  }
+  if (priority > 0) {
+    sched_param parameters;
+    parameters.sched_priority = std::min(std::max(priority, sched_get_priority_min(SCHED_FIFO)), sched_get_priority_max(SCHED_FIFO));
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) != 0) {
+      ROS_WARN("Could not set SCHED_FIFO priority %d for thread %ld (missing CAP_SYS_NICE or rtprio limit?).", parameters.sched_priority,
+               syscall(SYS_gettid));
+      success = false;
+    }
+  } else if (nice != 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) != 0) {
+    ROS_WARN("Could not set the nice value of thread %ld to %d.", syscall(SYS_gettid), nice);
+    success = false;
+  }
+#else
+  if (!cpus.empty() || priority > 0 || nice != 0) {
+    ROS_WARN("Thread scheduling can only be configured on Linux.");
+    success = false;
+  }
+#endif
+  return success;
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+  static ThreadPool threadPool;
+  return threadPool;
+}
+
+ThreadPool::ThreadPool()
+    : isStopping_(false),
+      nPendingTasks_(0),
+      nSteals_(0),
+      nTasks_(0)
+{
+  const unsigned int nCores = std::thread::hardware_concurrency();
+  start(nCores > 1 ? nCores - 1 : 0, std::vector<int>(), 0, 0);
+}
+
+ThreadPool::~ThreadPool()
+{
+  stop();
+}
+
+void ThreadPool::configure(const unsigned int nThreads, const std::vector<int>& cpus, const int priority, const int nice)
+{
+  std::lock_guard<std::mutex> lock(configurationMutex_);
+  stop();
+  start(nThreads, cpus, priority, nice);
+  ROS_INFO("Thread pool: Started %u worker threads.", nThreads);
+}
+
+void ThreadPool::start(const unsigned int nThreads, const std::vector<int>& cpus, const int priority, const int nice)
+{
+  isStopping_ = false;
+  workers_.clear();
+  for (unsigned int i = 0; i < nThreads; ++i) workers_.emplace_back(new Worker());
+  for (unsigned int i = 0; i < nThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i, cpus, priority, nice]() {
+      configureCurrentThread(cpus, priority, nice);
+      run(static_cast<int>(i));
+    });
+  }
+}
+
+void ThreadPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(conditionMutex_);
+    isStopping_ = true;
+  }
+  condition_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) worker->thread.join();
+  }
+  // Tasks submitted by the last workers are run here.
+  while (runPendingTask(-1)) {
+  }
+  workers_.clear();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+  const int workerIndex = currentWorkerIndex;
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  if (workerIndex >= 0 && workerIndex < static_cast<int>(workers_.size())) {
+    std::lock_guard<std::mutex> lock(workers_[workerIndex]->mutex);
+    workers_[workerIndex]->tasks.push_back(std::move(task));
+  } else {
+    std::lock_guard<std::mutex> lock(sharedTasksMutex_);
+    sharedTasks_.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(conditionMutex_);
+    ++nPendingTasks_;
+  }
+  condition_.notify_one();
+}
+
+void ThreadPool::parallelFor(const int begin, const int end, const int grainSize, const std::function<void(int, int)>& function)
+{
+  if (end <= begin) return;
+  const int chunkSize = std::max(grainSize, 1);
+  const int nChunks = (end - begin + chunkSize - 1) / chunkSize;
+  if (nChunks == 1 || workers_.empty()) {
+    function(begin, end);
+    return;
+  }
+
+  // Chunks are claimed by the caller and by helper tasks, helpers which start late find no chunk left.
+  struct Loop
+  {
+    std::atomic<int> nextChunk;
+    std::atomic<int> nDoneChunks;
+    std::mutex mutex;
+    std::condition_variable condition;
+  };
+  auto loop = std::make_shared<Loop>();
+  loop->nextChunk = 0;
+  loop->nDoneChunks = 0;
+  const std::function<void(int, int)>* loopFunction = &function;
+  auto runChunks = [loop, loopFunction, begin, end, chunkSize, nChunks]() {
+    for (int chunk = loop->nextChunk++; chunk < nChunks; chunk = loop->nextChunk++) {
+      const int chunkBegin = begin + chunk * chunkSize;
+      (*loopFunction)(chunkBegin, std::min(chunkBegin + chunkSize, end));
+      if (++loop->nDoneChunks == nChunks) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        loop->condition.notify_all();
+      }
+    }
+  };
+  const int nHelpers = std::min(nChunks - 1, static_cast<int>(workers_.size()));
+  for (int i = 0; i < nHelpers; ++i) submit(runChunks);
+  runChunks();
+
+  // The remaining chunks are running on other threads, which the caller must not preempt by spinning (e.g. with
+  // a higher SCHED_FIFO priority on the same CPU) nor delay by running unrelated tasks. It spins briefly for
+  // chunks which are about to finish and blocks then.
+  for (int i = 0; i < nSpinsBeforeBlocking && loop->nDoneChunks < nChunks; ++i) relaxCpu();
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->condition.wait(lock, [&loop, nChunks]() { return loop->nDoneChunks == nChunks; });
+}
+
+ThreadPool::Metrics ThreadPool::getMetrics() const
+{
+  Metrics metrics;
+  metrics.nThreads = workers_.size();
+  metrics.queueDepth = nPendingTasks_;
+  metrics.nSteals = nSteals_;
+  metrics.nTasks = nTasks_;
+  return metrics;
+}
+
+bool ThreadPool::runPendingTask(const int workerIndex)
+{
+  std::function<void()> task;
+  if (workerIndex >= 0 && workerIndex < static_cast<int>(workers_.size())) {
+    Worker& worker = *workers_[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    }
+  }
+  if (!task) {
+    std::lock_guard<std::mutex> lock(sharedTasksMutex_);
+    if (!sharedTasks_.empty()) {
+      task = std::move(sharedTasks_.front());
+      sharedTasks_.pop_front();
+    }
+  }
+  for (size_t i = 1; !task && i <= workers_.size(); ++i) {
+    Worker& victim = *workers_[(std::max(workerIndex, 0) + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      ++nSteals_;
+    }
+  }
+  if (!task) return false;
+  --nPendingTasks_;
+  task();
+  ++nTasks_;
+  return true;
+}
+
+void ThreadPool::run(const int workerIndex)
+{
+  currentWorkerIndex = workerIndex;
+  while (true) {
+    if (runPendingTask(workerIndex)) continue;
+    std::unique_lock<std::mutex> lock(conditionMutex_);
+    condition_.wait(lock, [this]() { return isStopping_ || nPendingTasks_ > 0; });
+    if (isStopping_ && nPendingTasks_ == 0) break;
+  }
+  currentWorkerIndex = -1;
+}
+
+} /* namespace */
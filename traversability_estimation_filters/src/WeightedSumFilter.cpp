@@ -0,0 +1,117 @@
+/*
+ * WeightedSumFilter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/WeightedSumFilter.hpp"
+#include "filters/SimdKernels.hpp"
+#include <pluginlib/class_list_macros.h>
+
+// Grid Map
+#include <grid_map_ros/grid_map_ros.hpp>
+
+using namespace grid_map;
+
+namespace filters {
+
+template<typename T>
+WeightedSumFilter<T>::WeightedSumFilter()
+    : computeBoundVariants_(false),
+      outputLayer_("traversability")
+{
+
+}
+
+template<typename T>
+WeightedSumFilter<T>::~WeightedSumFilter()
+{
+
+}
+
+template<typename T>
+bool WeightedSumFilter<T>::configure()
+{
+  if (!FilterBase<T>::getParam(std::string("layers"), layers_)) {
+    ROS_ERROR("WeightedSumFilter did not find param layers");
+    return false;
+  }
+
+  if (layers_.empty()) {
+    ROS_ERROR("WeightedSumFilter needs at least one input layer");
+    return false;
+  }
+
+  // Optional, the layers are averaged by default.
+  if (!FilterBase<T>::getParam(std::string("weights"), weights_)) {
+    weights_.assign(layers_.size(), 1.0 / layers_.size());
+  }
+
+  if (weights_.size() != layers_.size()) {
+    ROS_ERROR("WeightedSumFilter needs one weight per input layer");
+    return false;
+  }
+
+  if (!FilterBase<T>::getParam(std::string("output_layer"), outputLayer_)) {
+    ROS_ERROR("WeightedSumFilter did not find param output_layer");
+    return false;
+  }
+
+  ROS_DEBUG("Weighted sum output layer = %s", outputLayer_.c_str());
+
+  // Optional, sums the pessimistic and optimistic variants of the input layers.
+  FilterBase<T>::getParam(std::string("compute_bound_variants"), computeBoundVariants_);
+
+  return true;
+}
+
+template<typename T>
+bool WeightedSumFilter<T>::update(const T& mapIn, T& mapOut)
+{
+  mapOut = mapIn;
+  return compute(mapOut);
+}
+
+template<typename T>
+bool WeightedSumFilter<T>::compute(T& mapOut)
+{
+  for (const auto& layer : layers_) {
+    if (!mapOut.exists(layer)) {
+      ROS_ERROR("Weighted sum filter: The map has no layer '%s'.", layer.c_str());
+      return false;
+    }
+  }
+
+  // The layers share the buffer layout, such that the sum is element-wise on the buffers.
+  const SimdKernels& kernels = getSimdKernels();
+  const auto computeSum = [&](const std::string& suffix, Matrix& sum) {
+    sum = Matrix::Zero(mapOut.getSize()(0), mapOut.getSize()(1));
+    bool hasVariant = suffix.empty();
+    for (size_t i = 0; i < layers_.size(); ++i) {
+      const bool isVariant = !suffix.empty() && mapOut.exists(layers_[i] + suffix);
+      hasVariant = hasVariant || isVariant;
+      const Matrix& layer = mapOut[isVariant ? layers_[i] + suffix : layers_[i]];
+      kernels.addWeighted(layer.data(), static_cast<float>(weights_[i]), sum.data(), static_cast<size_t>(sum.size()));
+    }
+    return hasVariant;
+  };
+
+  Matrix sum;
+  computeSum("", sum);
+  mapOut.add(outputLayer_, sum);
+  if (computeBoundVariants_) {
+    for (const std::string suffix : {"_pessimistic", "_optimistic"}) {
+      if (computeSum(suffix, sum)) mapOut.add(outputLayer_ + suffix, sum);
+    }
+  }
+
+  return true;
+}
+
+template class WeightedSumFilter<grid_map::GridMap>;
+
+} /* namespace */
+
+PLUGINLIB_EXPORT_CLASS(filters::WeightedSumFilter<grid_map::GridMap>, filters::FilterBase<grid_map::GridMap>)
@@ -0,0 +1,128 @@
+/*
+ * CircleKernelTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/CircleKernel.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace filters;
+
+namespace {
+
+typedef std::set<std::pair<int, int>> Cells;
+
+//! Map of 21x17 cells, off the origin such that the cell positions are not exact.
+grid_map::GridMap createMap(const double resolution)
+{
+  grid_map::GridMap map({"index"});
+  map.setGeometry(grid_map::Length(21 * resolution, 17 * resolution), resolution, grid_map::Position(1.3, -0.7));
+  const grid_map::Size size = map.getSize();
+  for (int j = 0; j < size(1); ++j) {
+    for (int i = 0; i < size(0); ++i) map["index"](i, j) = static_cast<float>(i + size(0) * j);
+  }
+  return map;
+}
+
+Cells getIteratorCells(const grid_map::GridMap& map, const grid_map::Index& center, const double radius)
+{
+  grid_map::Position position;
+  map.getPosition(center, position);
+  Cells cells;
+  for (grid_map::CircleIterator iterator(map, position, radius); !iterator.isPastEnd(); ++iterator) {
+    cells.emplace((*iterator)(0), (*iterator)(1));
+  }
+  return cells;
+}
+
+/*!
+ * Expects the same cells as the circle iterator, except cells on the circle. Whether the iterator visits those
+ * depends on the rounding of the cell positions, which differs between the cells of a map.
+ */
+void expectSameCells(const Cells& expectedCells, const Cells& cells, const grid_map::Index& center, const double radiusInCells)
+{
+  std::vector<std::pair<int, int>> differentCells;
+  std::set_symmetric_difference(expectedCells.begin(), expectedCells.end(), cells.begin(), cells.end(),
+                                std::back_inserter(differentCells));
+  for (const auto& cell : differentCells) {
+    const double distance = std::hypot(cell.first - center(0), cell.second - center(1));
+    EXPECT_NEAR(radiusInCells, distance, 1e-6) << "radius " << radiusInCells << " cells, center " << center.transpose() << ", cell "
+                                                << cell.first << ", " << cell.second;
+  }
+}
+
+//! Compares the cells of the kernel with those of the circle iterator, around all cells of the map.
+void expectSameCells(const double resolution, const double radius)
+{
+  const grid_map::GridMap map = createMap(resolution);
+  const grid_map::Size size = map.getSize();
+  const bool isSpecialized = visitCircleKernel(radius / resolution, [&](const auto& kernel) {
+    const int padding = std::decay_t<decltype(kernel)>::radius;
+    grid_map::Matrix padded;
+    getPaddedLayer(map, "index", padding, padded);
+    for (int j = 0; j < size(1); ++j) {
+      for (int i = 0; i < size(0); ++i) {
+        const Cells expectedCells = getIteratorCells(map, grid_map::Index(i, j), radius);
+
+        Cells offsetCells;
+        kernel.forEachOffset([&](const int rowOffset, const int columnOffset) {
+          const int row = i + rowOffset;
+          const int column = j + columnOffset;
+          if (row >= 0 && row < size(0) && column >= 0 && column < size(1)) offsetCells.emplace(row, column);
+        });
+        expectSameCells(expectedCells, offsetCells, grid_map::Index(i, j), radius / resolution);
+
+        Cells windowCells;
+        kernel.apply(padded, i + padding, j + padding, [&](const bool isInside, const float value) {
+          if (!isInside || !std::isfinite(value)) return;
+          const int index = static_cast<int>(value);
+          windowCells.emplace(index % size(0), index / size(0));
+        });
+        expectSameCells(expectedCells, windowCells, grid_map::Index(i, j), radius / resolution);
+      }
+    }
+  });
+  EXPECT_TRUE(isSpecialized);
+}
+
+}  // namespace
+
+TEST(CircleKernel, MatchesCircleIterator)
+{
+  for (const double resolution : {0.02, 0.04, 0.05, 0.1}) {
+    for (int radius = 0; radius <= maxCircleKernelRadius; ++radius) {
+      expectSameCells(resolution, radius * resolution);
+      expectSameCells(resolution, (radius + 0.5) * resolution);
+    }
+  }
+}
+
+TEST(CircleKernel, MatchesCircleIteratorForConfiguredRadii)
+{
+  // Window radii of the filter configurations, not exact multiples of the resolution in floating point.
+  expectSameCells(0.02, 0.04);
+  expectSameCells(0.02, 0.06);
+  expectSameCells(0.04, 0.08);
+  expectSameCells(0.04, 0.12);
+  expectSameCells(0.05, 0.15);
+  expectSameCells(0.1, 0.3);
+}
+
+TEST(CircleKernel, LargeRadiusIsNotSpecialized)
+{
+  EXPECT_FALSE(visitCircleKernel(maxCircleKernelRadius + 1.0, [](const auto&) {}));
+  EXPECT_FALSE(visitCircleKernel(NAN, [](const auto&) {}));
+}
@@ -0,0 +1,174 @@
+/*
+ * SimdKernelsTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/SimdKernels.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace filters;
+
+namespace {
+
+//! Number of values, not a multiple of the vector widths such that the remainders are covered.
+constexpr size_t nValues = 1003;
+
+std::vector<float> createValues(const float min, const float max)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(min, max);
+  std::vector<float> values(nValues);
+  for (size_t i = 0; i < nValues; ++i) values[i] = i % 17 == 0 ? NAN : distribution(generator);
+  // Boundaries of the arc cosine.
+  values[1] = 1.0f;
+  values[2] = -1.0f;
+  values[3] = 0.0f;
+  return values;
+}
+
+//! Variants of the kernels supported by the CPU.
+std::vector<std::string> getVectorVariants()
+{
+  std::vector<std::string> variants;
+  for (const std::string variant : {"avx2", "avx512"}) {
+    if (setSimdVariant(variant)) variants.push_back(variant);
+  }
+  setSimdVariant("auto");
+  return variants;
+}
+
+}  // namespace
+
+TEST(SimdKernels, SlopeTraversability)
+{
+  const std::vector<float> normalZ = createValues(-1.0f, 1.0f);
+  const float criticalValue = 0.6f;
+  ASSERT_TRUE(setSimdVariant("scalar"));
+  std::vector<float> expected(nValues);
+  getSimdKernels().slopeTraversability(normalZ.data(), expected.data(), nValues, criticalValue);
+  for (size_t i = 0; i < nValues; ++i) {
+    if (std::isnan(normalZ[i])) {
+      EXPECT_TRUE(std::isnan(expected[i]));
+    } else {
+      const float slope = std::acos(normalZ[i]);
+      EXPECT_NEAR(slope < criticalValue ? 1.0f - slope / criticalValue : 0.0f, expected[i], 1e-5);
+    }
+  }
+
+  for (const auto& variant : getVectorVariants()) {
+    SCOPED_TRACE(variant);
+    ASSERT_TRUE(setSimdVariant(variant));
+    std::vector<float> traversability(nValues);
+    getSimdKernels().slopeTraversability(normalZ.data(), traversability.data(), nValues, criticalValue);
+    for (size_t i = 0; i < nValues; ++i) {
+      if (std::isnan(expected[i])) {
+        EXPECT_TRUE(std::isnan(traversability[i]));
+      } else {
+        EXPECT_NEAR(expected[i], traversability[i], 1e-6);
+      }
+    }
+  }
+  setSimdVariant("auto");
+}
+
+TEST(SimdKernels, UpdateMinMax)
+{
+  const std::vector<float> first = createValues(-2.0f, 2.0f);
+  std::vector<float> shiftedValues = createValues(-1.0f, 3.0f);
+  std::rotate(shiftedValues.begin(), shiftedValues.begin() + 5, shiftedValues.end());
+  const std::vector<float>& second = shiftedValues;
+  ASSERT_TRUE(setSimdVariant("scalar"));
+  std::vector<float> expectedMin(nValues, std::numeric_limits<float>::infinity());
+  std::vector<float> expectedMax(nValues, -std::numeric_limits<float>::infinity());
+  for (const std::vector<float>* values : {&first, &second}) {
+    getSimdKernels().updateMinMax(values->data(), expectedMin.data(), expectedMax.data(), nValues);
+  }
+  for (size_t i = 0; i < nValues; ++i) {
+    const bool isFirstValid = !std::isnan(first[i]);
+    const bool isSecondValid = !std::isnan(second[i]);
+    if (!isFirstValid && !isSecondValid) {
+      EXPECT_EQ(std::numeric_limits<float>::infinity(), expectedMin[i]);
+    } else if (isFirstValid && isSecondValid) {
+      EXPECT_EQ(std::min(first[i], second[i]), expectedMin[i]);
+      EXPECT_EQ(std::max(first[i], second[i]), expectedMax[i]);
+    }
+  }
+
+  for (const auto& variant : getVectorVariants()) {
+    SCOPED_TRACE(variant);
+    ASSERT_TRUE(setSimdVariant(variant));
+    std::vector<float> minimum(nValues, std::numeric_limits<float>::infinity());
+    std::vector<float> maximum(nValues, -std::numeric_limits<float>::infinity());
+    for (const std::vector<float>* values : {&first, &second}) getSimdKernels().updateMinMax(values->data(), minimum.data(), maximum.data(), nValues);
+    EXPECT_EQ(expectedMin, minimum);
+    EXPECT_EQ(expectedMax, maximum);
+  }
+  setSimdVariant("auto");
+}
+
+TEST(SimdKernels, UpdateMaxAndCount)
+{
+  const std::vector<float> values = createValues(0.0f, 1.0f);
+  const float threshold = 0.5f;
+  ASSERT_TRUE(setSimdVariant("scalar"));
+  std::vector<float> expectedMax(nValues, -std::numeric_limits<float>::infinity());
+  std::vector<int> expectedCount(nValues, 0);
+  getSimdKernels().updateMaxAndCount(values.data(), threshold, expectedMax.data(), expectedCount.data(), nValues);
+  getSimdKernels().updateMaxAndCount(values.data(), threshold, expectedMax.data(), expectedCount.data(), nValues);
+  for (size_t i = 0; i < nValues; ++i) EXPECT_EQ(values[i] > threshold ? 2 : 0, expectedCount[i]);
+
+  for (const auto& variant : getVectorVariants()) {
+    SCOPED_TRACE(variant);
+    ASSERT_TRUE(setSimdVariant(variant));
+    std::vector<float> maximum(nValues, -std::numeric_limits<float>::infinity());
+    std::vector<int> count(nValues, 0);
+    getSimdKernels().updateMaxAndCount(values.data(), threshold, maximum.data(), count.data(), nValues);
+    getSimdKernels().updateMaxAndCount(values.data(), threshold, maximum.data(), count.data(), nValues);
+    EXPECT_EQ(expectedMax, maximum);
+    EXPECT_EQ(expectedCount, count);
+  }
+  setSimdVariant("auto");
+}
+
+TEST(SimdKernels, AddWeighted)
+{
+  const std::vector<float> values = createValues(0.0f, 1.0f);
+  const float weight = 1.0f / 3.0f;
+  ASSERT_TRUE(setSimdVariant("scalar"));
+  std::vector<float> expected(nValues, 0.5f);
+  getSimdKernels().addWeighted(values.data(), weight, expected.data(), nValues);
+  for (size_t i = 0; i < nValues; ++i) {
+    if (std::isnan(values[i])) {
+      EXPECT_TRUE(std::isnan(expected[i]));
+    } else {
+      EXPECT_FLOAT_EQ(0.5f + weight * values[i], expected[i]);
+    }
+  }
+
+  for (const auto& variant : getVectorVariants()) {
+    SCOPED_TRACE(variant);
+    ASSERT_TRUE(setSimdVariant(variant));
+    std::vector<float> sum(nValues, 0.5f);
+    getSimdKernels().addWeighted(values.data(), weight, sum.data(), nValues);
+    for (size_t i = 0; i < nValues; ++i) {
+      if (std::isnan(expected[i])) {
+        EXPECT_TRUE(std::isnan(sum[i]));
+      } else {
+        EXPECT_NEAR(expected[i], sum[i], 1e-6);
+      }
+    }
+  }
+  setSimdVariant("auto");
+}
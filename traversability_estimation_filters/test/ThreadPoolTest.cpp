@@ -0,0 +1,60 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Institute: ETH Zurich, Autonomous Systems Lab
+ */
+
+#include "filters/ThreadPool.hpp"
+
+// gtest
+#include <gtest/gtest.h>
+
+// STD
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace filters;
+
+TEST(ThreadPool, ParallelForVisitsAllIterations)
+{
+  ThreadPool& threadPool = ThreadPool::getInstance();
+  threadPool.configure(3, std::vector<int>(), 0, 0);
+  std::vector<int> nVisits(1001, 0);
+  threadPool.parallelFor(0, static_cast<int>(nVisits.size()), 7, [&](const int begin, const int end) {
+    for (int i = begin; i < end; ++i) ++nVisits[i];
+  });
+  for (const int n : nVisits) EXPECT_EQ(1, n);
+}
+
+TEST(ThreadPool, NestedParallelFor)
+{
+  ThreadPool& threadPool = ThreadPool::getInstance();
+  threadPool.configure(3, std::vector<int>(), 0, 0);
+  std::atomic<int> sum(0);
+  threadPool.parallelFor(0, 16, 1, [&](const int begin, const int end) {
+    for (int i = begin; i < end; ++i) {
+      threadPool.parallelFor(0, 100, 10, [&](const int innerBegin, const int innerEnd) { sum += innerEnd - innerBegin; });
+    }
+  });
+  EXPECT_EQ(1600, sum);
+}
+
+TEST(ThreadPool, ConcurrentCallers)
+{
+  ThreadPool& threadPool = ThreadPool::getInstance();
+  threadPool.configure(2, std::vector<int>(), 0, 0);
+  std::atomic<int> sum(0);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&]() {
+      for (int j = 0; j < 100; ++j) {
+        threadPool.parallelFor(0, 64, 4, [&](const int begin, const int end) { sum += end - begin; });
+      }
+    });
+  }
+  for (auto& caller : callers) caller.join();
+  EXPECT_EQ(4 * 100 * 64, sum);
+}